@@ -1,101 +1,546 @@
-﻿using System.Collections;
-using System.Collections.Generic;
-using UnityEngine;
-using System.Runtime.InteropServices;
-using System.Net.NetworkInformation;
-using System.Collections.Specialized;
-using System.Threading;
-using System.Security.Cryptography;
-using System;
-
-public class CubeScript : MonoBehaviour
-{
-    // Impportierung der benötigten Funktionen aus der DLL-Datei. Der Name der DLL-Datei ist "OpenCV_Library".
-    // Als Entrypoint werden die jeweiligen Funktionsnamen in der DLL verwendet. Kann mit dem Programm "Dependency Walker"
-    // nachgeschaut werden.
-
-    // Importierung der initialize()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "initialize")]
-    public static extern void initialize(int cameraInput);
-
-    // Importierung der loadCameraCalibration()-Funktion. Erwartet eigentlich ein const char*, die Korrespondenz in C#
-    // dazu ist ein string!
-    [DllImport("OpenCV_Library", EntryPoint = "loadCameraCalibration")]
-    public static extern bool loadCameraCalibration(string cameraCalibrationFileName);
-
-    // Importierung der estimatePoseMarkerAndDetection()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "estimatePoseMarkerAndDetection")]
-    public static extern int estimatePoseMarkerAndDetection();
-
-    // Importierung der getXCoordinate()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "getXCoordinate")]
-    public static extern double getXCoordinate();
-
-    // Importierung der getYCoordinate()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "getYCoordinate")]
-    public static extern double getYCoordinate();
-
-    // Importierung der getZCoordinate()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "getZCoordinate")]
-    public static extern double getZCoordinate();
-
-    // Importierung der close()-Funktion
-    [DllImport("OpenCV_Library", EntryPoint = "close")]
-    public static extern void close();
-
-    // Erstellung eines Rigidbody, um die Kontrolle der Position des Würfels zu bekommen/ beeinflussen
-    public Rigidbody rb;
-  
-
-
-    // Start wird vor dem ersten Frameupdate aufgerufen
-    void Start()
-    {
-        rb = GetComponent<Rigidbody>();
-
-        // Wenn isKinematic aktiv ist, Kräfte, Kollisionen oder Joints haben keinen Einfluss auf den Rigidbody
-        rb.isKinematic = true;
-
-        /*initialize() - Funktion: Initialisierung wichtiger Objekte, zur Durchführung der Prozesse
-                -@param 0: Kamerainput als Integer-Wert (0 als Standardanschluss für eine angeschlossene Kamera) */
-        initialize(0);
-
-        /* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei
-		        - @param "CameraCalibration": Name der zu ladenen Datei
-		        - @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
-        loadCameraCalibration("CameraCalibration");
-        Debug.Log("Camera Calibration loaded: " + loadCameraCalibration("CameraCalibration"));
-       
-    }
-
-
-
-    // Wenn die Anwendung beendet wird, werden alle Fenster geschlossen und nicht mehr benötigte Objekte "freigegeben"
-    void OnApplicationQuit()
-    {
-        close();
-    }
-
-
-
-    // Update wird einmal pro Frame aufgerufen
-    void Update()
-    {
-        /* estimatePoseMarkerAndDetection()-Funktion: Durchführung der Posenschätzung der Marker und deren Erkennung
-		        - @param return: -1 für einen Fehlschlag, 1 für eine Durchführung*/
-        estimatePoseMarkerAndDetection();
-
-        // Übertragung der Translations-Koordinaten. Dabei werden die double-Koordinaten in float umgewandelt
-        // Die Y-Koordinate wird mit (-1) multipliziert, weil OpenCv ein rechtshändiges Koordinatensystem hat
-        // und Unity ein linkshändiges Koordinatensystem verwendet
-        transform.position = new Vector3(Convert.ToSingle(getXCoordinate()), Convert.ToSingle(getYCoordinate()) * (-1.0f),
-            Convert.ToSingle(getZCoordinate()));
-        rb.MovePosition(transform.position * Time.deltaTime);
-
-        //Debug.Log("X-Translation: " + Convert.ToSingle(getXCoordinate()));
-        //Debug.Log("Y-Translation: " + Convert.ToSingle(getYCoordinate()));
-        //Debug.Log("Z-Translation: " + Convert.ToSingle(getZCoordinate()));
-
-    }
-
-}
+using System.Collections;
+using System.Collections.Generic;
+using UnityEngine;
+using System.Runtime.InteropServices;
+using System.Net.NetworkInformation;
+using System.Collections.Specialized;
+using System.Threading;
+using System.Security.Cryptography;
+using System;
+
+// Ergebnis für einen erkannten Marker. Muss Feld für Feld der Struktur MarkerPose in MarkerPose.h entsprechen.
+// Es werden bewusst nur Werttypen (keine Arrays) verwendet, damit die Struktur "blittable" ist und ein Array davon
+// ohne Umkopieren an die DLL übergeben werden kann
+[StructLayout(LayoutKind.Sequential)]
+public struct MarkerPose
+{
+    public int id;
+
+    // Kombination der MARKER_POSE_*-Bits (siehe CubeScript.MARKER_POSE_PREDICTED)
+    public int flags;
+
+    // Rotationsvektor (Rodrigues), über die Bilder hinweg geglättet
+    public double rotationX, rotationY, rotationZ;
+
+    // Translationsvektor in Metern
+    public double translationX, translationY, translationZ;
+
+    // Die 4 Markerecken im Bild in Pixeln
+    public float corner0X, corner0Y, corner1X, corner1Y, corner2X, corner2Y, corner3X, corner3Y;
+
+    // Mittlerer Rückprojektionsfehler der Ecken in Pixeln (-1 für vorhergesagte Marker)
+    public double reprojectionError;
+
+    // Aufnahmezeitpunkt des Bildes in Mikrosekunden (monotone Uhr)
+    public long captureTimestamp;
+}
+
+// Einstellungen der Markererkennung. Muss Feld für Feld der Struktur DetectorSettings in MarkerDetector.h entsprechen
+[StructLayout(LayoutKind.Sequential)]
+public struct DetectorSettings
+{
+    // 1 = Verfolgung der bekannten Marker in Bildausschnitten, 0 = immer das ganze Bild durchsuchen
+    public int trackingEnabled;
+
+    // Spätestens nach so vielen Bildern wird wieder das ganze Bild durchsucht
+    public int fullScanInterval;
+
+    // Vergrößerung des Ausschnitts um einen Marker, relativ zu seiner Größe
+    public float roiMargin;
+
+    // Mindestgröße eines Ausschnitts in Pixeln
+    public int minRoiSize;
+
+    // Skalierung der Kandidatensuche: 1 = volle Auflösung, 0 < x < 1 = Suche im verkleinerten Bild (Ecken werden in
+    // voller Auflösung verfeinert), 0 = automatisch aus Kalibrierung und maxMarkerDistance
+    public float pyramidScale;
+
+    // Größter erwarteter Abstand eines Markers zur Kamera in Metern (nur für pyramidScale = 0)
+    public float maxMarkerDistance;
+
+    // Ändert sich kein 16x16-Block des Bildes um mehr als so viele Graustufen, wird die Erkennung übersprungen und das
+    // letzte Ergebnis wiederholt (0 = immer erkennen)
+    public float motionThreshold;
+
+    // Spätestens nach so vielen übersprungenen Bildern wird wieder erkannt
+    public int staticRefreshInterval;
+
+    // 0 = immer aruco::detectMarkers(), 1 = eigene vektorisierte Kandidatensuche (Standard, nur für Lexika mit 4x4 Bits,
+    // andere Lexika nehmen automatisch aruco::detectMarkers())
+    public int candidateSearch;
+
+    // Größte erwartete Seite eines Markers im Bild in Pixeln, unabhängig von seiner Drehung. Größer 0 = große Bilder
+    // werden in sich um die Diagonale dieser Größe überlappende Kacheln aufgeteilt und parallel durchsucht, 0 = aus
+    public int tileMarkerSize;
+}
+
+// Perzentile der Laufzeit einer Stufe in Mikrosekunden. Muss StageLatency in PipelineStats.h entsprechen
+[StructLayout(LayoutKind.Sequential)]
+public struct StageLatency
+{
+    public double p50;
+    public double p95;
+    public double p99;
+    public double max;
+}
+
+// Statistik der Pipeline. Muss Feld für Feld der Struktur DetectorStats in PipelineStats.h entsprechen
+[StructLayout(LayoutKind.Sequential)]
+public struct DetectorStats
+{
+    public long framesCaptured;
+    public long captureFailures;
+    public long framesProcessed;
+    public long framesWithMarkers;
+
+    // Ergebnisse, die der Detektions-Thread überschrieben hat, bevor Update() sie abgeholt hat
+    public long droppedResults;
+
+    // Bilder, in denen wegen unveränderter Szene nicht erkannt wurde
+    public long framesSkipped;
+
+    // Bytes, die vom Puffer der Kamera bis zum Graubild der Erkennung gelesen und geschrieben wurden (über alle Bilder)
+    public long ingestedBytes;
+
+    // Anteil der Bilder mit mindestens einem erkannten Marker (0..1)
+    public double detectionHitRate;
+
+    public StageLatency captureWait;
+    public StageLatency decode;
+    public StageLatency detectMarkers;
+    public StageLatency estimatePose;
+    public StageLatency render;
+
+    // Alter eines Ergebnisses bei der Veröffentlichung (Aufnahme bis Veröffentlichung)
+    public StageLatency captureToPublish;
+}
+
+// Beschreibung eines exportierten Kamerabildes. Muss Feld für Feld der Struktur ExportedFrame in FrameExport.h entsprechen
+[StructLayout(LayoutKind.Sequential)]
+public struct ExportedFrame
+{
+    // Erster Pixel der obersten Bildzeile im Speicher der DLL, gültig bis releaseExportedFrame()
+    public IntPtr pixels;
+
+    public int width;
+    public int height;
+
+    // Bytes pro Zeile und Bytes des ganzen Bildes
+    public int stride;
+    public int size;
+
+    // CubeScript.FRAME_EXPORT_RGBA oder CubeScript.FRAME_EXPORT_GRAY
+    public int format;
+
+    // Puffer der DLL, aus dem das Bild stammt (0 oder 1)
+    public int bufferIndex;
+
+    // Nummer des zugehörigen Ergebnisses (wie getResultSequence()) und Aufnahmezeitpunkt in Mikrosekunden
+    public ulong sequence;
+    public long captureTimestamp;
+}
+
+public class CubeScript : MonoBehaviour
+{
+    // Impportierung der benötigten Funktionen aus der DLL-Datei. Der Name der DLL-Datei ist "OpenCV_Library".
+    // Als Entrypoint werden die jeweiligen Funktionsnamen in der DLL verwendet. Kann mit dem Programm "Dependency Walker"
+    // nachgeschaut werden.
+
+    // Importierung der initialize()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "initialize")]
+    public static extern void initialize(int cameraInput);
+
+    // Importierung der initializeEx()-Funktion. Mit INIT_BACKGROUND_WORKER laufen Aufnahme und Erkennung in einem
+    // eigenen Thread der DLL, so dass Update() nicht mehr auf die Kamera warten muss
+    [DllImport("OpenCV_Library", EntryPoint = "initializeEx")]
+    public static extern void initializeEx(int cameraInput, int flags);
+
+    public const int INIT_BACKGROUND_WORKER = 1;
+
+    // Flag für initializeEx(): Kein Zeichnen und kein OpenCV-Fenster in der DLL (Produktivbetrieb)
+    public const int INIT_HEADLESS = 2;
+
+    // Flag für initializeEx(): Die Kamera liefert nur die Helligkeit (Y-Ebene) an die Erkennung. Ein Farbbild wird nur
+    // für die Debug-Anzeige und den RGBA-Export umgewandelt
+    public const int INIT_LUMINANCE_CAPTURE = 4;
+
+    // Bit in MarkerPose.flags: Der Marker wurde im letzten Bild nicht erkannt, die Pose ist aus seiner Bewegung vorhergesagt
+    public const int MARKER_POSE_PREDICTED = 1;
+
+    // Bit in MarkerPose.flags: Die Pose wurde von getExtrapolatedMarkerPoses() auf den gewünschten Zeitpunkt fortgeschrieben
+    public const int MARKER_POSE_EXTRAPOLATED = 2;
+
+    // Formate für setFrameExport(): Kamerabild als RGBA (4 Bytes pro Pixel) bzw. nur die Helligkeit (1 Byte pro Pixel)
+    public const int FRAME_EXPORT_NONE = 0;
+    public const int FRAME_EXPORT_RGBA = 1;
+    public const int FRAME_EXPORT_GRAY = 2;
+
+    // Importierung der initializeSource()-Funktion. Wie initializeEx(), aber mit beliebiger Bildquelle, z.B. "0" (Webcam),
+    // "file:video.mp4?loop=1", "dir:Bilder" oder "synthetic:1920x1080?markers=4&fps=30"
+    [DllImport("OpenCV_Library", EntryPoint = "initializeSource")]
+    public static extern void initializeSource(string sourceUri, int flags);
+
+    // Importierung der startDetectionThread()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "startDetectionThread")]
+    public static extern bool startDetectionThread();
+
+    // Importierung der stopDetectionThread()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "stopDetectionThread")]
+    public static extern void stopDetectionThread();
+
+    // Importierung der getResultSequence()-Funktion. Nummer des zuletzt veröffentlichten Ergebnisses
+    [DllImport("OpenCV_Library", EntryPoint = "getResultSequence")]
+    public static extern ulong getResultSequence();
+
+    // Importierung der loadCameraCalibration()-Funktion. Erwartet eigentlich ein const char*, die Korrespondenz in C#
+    // dazu ist ein string! Liest nur das binäre Format, bei einem Fehler bleibt die alte Kalibrierung
+    [DllImport("OpenCV_Library", EntryPoint = "loadCameraCalibration")]
+    public static extern bool loadCameraCalibration(string cameraCalibrationFileName);
+
+    // Importierung der estimatePoseMarkerAndDetection()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "estimatePoseMarkerAndDetection")]
+    public static extern int estimatePoseMarkerAndDetection();
+
+    // Importierung der getXCoordinate()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "getXCoordinate")]
+    public static extern double getXCoordinate();
+
+    // Importierung der getYCoordinate()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "getYCoordinate")]
+    public static extern double getYCoordinate();
+
+    // Importierung der getZCoordinate()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "getZCoordinate")]
+    public static extern double getZCoordinate();
+
+    // Importierung der getMarkerPoses()-Funktion. Füllt den übergebenen Array mit allen erkannten Markern in einem Aufruf
+    // und gibt die Anzahl der erkannten Marker zurück
+    [DllImport("OpenCV_Library", EntryPoint = "getMarkerPoses")]
+    public static extern int getMarkerPoses([In, Out] MarkerPose[] poses, int capacity);
+
+    // Importierung der getExtrapolatedMarkerPoses()-Funktion. Wie getMarkerPoses(), aber die Posen werden auf den
+    // übergebenen Zeitpunkt (Uhr von getMonotonicTimestamp(), Mikrosekunden) fortgeschrieben
+    [DllImport("OpenCV_Library", EntryPoint = "getExtrapolatedMarkerPoses")]
+    public static extern int getExtrapolatedMarkerPoses(long targetTimestamp, [In, Out] MarkerPose[] poses, int capacity);
+
+    // Importierung der getResultCaptureTimestamp()-Funktion. Aufnahmezeitpunkt des aktuellen Ergebnisses
+    [DllImport("OpenCV_Library", EntryPoint = "getResultCaptureTimestamp")]
+    public static extern long getResultCaptureTimestamp();
+
+    // Importierung der getMonotonicTimestamp()-Funktion. Aktuelle Zeit der Uhr der Aufnahmezeitpunkte in Mikrosekunden
+    [DllImport("OpenCV_Library", EntryPoint = "getMonotonicTimestamp")]
+    public static extern long getMonotonicTimestamp();
+
+    // Importierung der getMaxMarkerCount()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "getMaxMarkerCount")]
+    public static extern int getMaxMarkerCount();
+
+    // Importierung der setDetectorSettings()- und getDetectorSettings()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "setDetectorSettings")]
+    public static extern void setDetectorSettings(ref DetectorSettings settings);
+
+    [DllImport("OpenCV_Library", EntryPoint = "getDetectorSettings")]
+    public static extern void getDetectorSettings(out DetectorSettings settings);
+
+    // Importierung der getLastDetectionPath()-Funktion. 0 = Suche im ganzen Bild, 1 = Suche in den Ausschnitten
+    [DllImport("OpenCV_Library", EntryPoint = "getLastDetectionPath")]
+    public static extern int getLastDetectionPath();
+
+    // Importierung der getStats()-Funktion. Laufzeiten der einzelnen Stufen und Zähler der Pipeline
+    [DllImport("OpenCV_Library", EntryPoint = "getStats")]
+    public static extern void getStats(out DetectorStats stats);
+
+    // Importierung der setStatsDumpFile()-Funktion. Schreibt die Statistik regelmäßig als CSV-Zeile in eine Datei
+    [DllImport("OpenCV_Library", EntryPoint = "setStatsDumpFile")]
+    public static extern bool setStatsDumpFile(string path, int intervalMilliseconds);
+
+    // Importierung der setRectifiedView()-Funktion. 1 = Debug-Anzeige zeigt das entzerrte Bild, 0 = aufgenommenes Bild
+    [DllImport("OpenCV_Library", EntryPoint = "setRectifiedView")]
+    public static extern void setRectifiedView(int enabled);
+
+    // Importierung der setPoseFiltering()-Funktion. 1 = Posen werden über die Bilder geglättet und kurz fehlende Marker
+    // vorhergesagt (Standard), 0 = unabhängige Einzelposen
+    [DllImport("OpenCV_Library", EntryPoint = "setPoseFiltering")]
+    public static extern void setPoseFiltering(int enabled);
+
+    // Importierung der Funktionen für den Export des Kamerabildes. Die DLL wandelt jedes Bild einmal in einen ihrer zwei
+    // Puffer um, acquireExportedFrame() hält den neuesten davon, bis releaseExportedFrame() aufgerufen wird
+    [DllImport("OpenCV_Library", EntryPoint = "setFrameExport")]
+    public static extern void setFrameExport(int format);
+
+    [DllImport("OpenCV_Library", EntryPoint = "getExportedFrameSequence")]
+    public static extern ulong getExportedFrameSequence();
+
+    [DllImport("OpenCV_Library", EntryPoint = "acquireExportedFrame")]
+    public static extern int acquireExportedFrame(out ExportedFrame frame);
+
+    [DllImport("OpenCV_Library", EntryPoint = "releaseExportedFrame")]
+    public static extern void releaseExportedFrame();
+
+    // Importierung der Funktionen für den Posen-Bus. Andere lokale Programme lesen die Posen dieser Erkennung dann mit
+    // der C-Bibliothek in OpenCV_Library/PoseBusReader aus dem gemeinsamen Speicher. startPoseBus() liefert false, wenn
+    // schon ein anderes Programm auf den Bus mit diesem Namen schreibt
+    [DllImport("OpenCV_Library", EntryPoint = "startPoseBus")]
+    public static extern bool startPoseBus(string name);
+
+    [DllImport("OpenCV_Library", EntryPoint = "stopPoseBus")]
+    public static extern void stopPoseBus();
+
+    // Importierung der close()-Funktion
+    [DllImport("OpenCV_Library", EntryPoint = "close")]
+    public static extern void close();
+
+    // Importierung der Kontext-Funktionen für mehrere Kameras. initializeContext() gibt ein Handle zurück, das an alle
+    // ctx*-Funktionen übergeben und am Ende mit closeContext() freigegeben wird. Jeder Kontext läuft unabhängig
+    [DllImport("OpenCV_Library", EntryPoint = "initializeContext")]
+    public static extern IntPtr initializeContext(int cameraInput, int flags);
+
+    [DllImport("OpenCV_Library", EntryPoint = "initializeContextFromSource")]
+    public static extern IntPtr initializeContextFromSource(string sourceUri, int flags);
+
+    [DllImport("OpenCV_Library", EntryPoint = "closeContext")]
+    public static extern void closeContext(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxLoadCameraCalibration")]
+    public static extern bool ctxLoadCameraCalibration(IntPtr context, string cameraCalibrationFileName);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxEstimatePoseMarkerAndDetection")]
+    public static extern int ctxEstimatePoseMarkerAndDetection(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxStartDetectionThread")]
+    public static extern bool ctxStartDetectionThread(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxStopDetectionThread")]
+    public static extern void ctxStopDetectionThread(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetResultSequence")]
+    public static extern ulong ctxGetResultSequence(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetMarkerPoses")]
+    public static extern int ctxGetMarkerPoses(IntPtr context, [In, Out] MarkerPose[] poses, int capacity);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetExtrapolatedMarkerPoses")]
+    public static extern int ctxGetExtrapolatedMarkerPoses(IntPtr context, long targetTimestamp, [In, Out] MarkerPose[] poses,
+        int capacity);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetResultCaptureTimestamp")]
+    public static extern long ctxGetResultCaptureTimestamp(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxSetDetectorSettings")]
+    public static extern void ctxSetDetectorSettings(IntPtr context, ref DetectorSettings settings);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetDetectorSettings")]
+    public static extern void ctxGetDetectorSettings(IntPtr context, out DetectorSettings settings);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetLastDetectionPath")]
+    public static extern int ctxGetLastDetectionPath(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetStats")]
+    public static extern void ctxGetStats(IntPtr context, out DetectorStats stats);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxSetStatsDumpFile")]
+    public static extern bool ctxSetStatsDumpFile(IntPtr context, string path, int intervalMilliseconds);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxSetRectifiedView")]
+    public static extern void ctxSetRectifiedView(IntPtr context, int enabled);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxSetPoseFiltering")]
+    public static extern void ctxSetPoseFiltering(IntPtr context, int enabled);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxSetFrameExport")]
+    public static extern void ctxSetFrameExport(IntPtr context, int format);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxGetExportedFrameSequence")]
+    public static extern ulong ctxGetExportedFrameSequence(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxAcquireExportedFrame")]
+    public static extern int ctxAcquireExportedFrame(IntPtr context, out ExportedFrame frame);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxReleaseExportedFrame")]
+    public static extern void ctxReleaseExportedFrame(IntPtr context);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxStartPoseBus")]
+    public static extern bool ctxStartPoseBus(IntPtr context, string name);
+
+    [DllImport("OpenCV_Library", EntryPoint = "ctxStopPoseBus")]
+    public static extern void ctxStopPoseBus(IntPtr context);
+
+    // Erstellung eines Rigidbody, um die Kontrolle der Position des Würfels zu bekommen/ beeinflussen
+    public Rigidbody rb;
+
+    // Zeigt das Kamerabild mit den erkannten Markern im OpenCV-Fenster "Webcam" an. Für den Produktivbetrieb abschalten,
+    // das Kamerabild kann dann über cameraBackground in der Szene angezeigt werden
+    public bool showDebugView = true;
+
+    // Schreibt die Pose auf den Zeitpunkt fort, zu dem das Bild voraussichtlich angezeigt wird (jetzt + eine Framezeit),
+    // damit die Zeit zwischen Kameraaufnahme und Anzeige nicht als Nachziehen sichtbar wird
+    public bool extrapolateToDisplayTime = true;
+
+    // Liest von der Kamera nur die Helligkeit (INIT_LUMINANCE_CAPTURE). Spart die Farbumwandlung, solange weder die
+    // Debug-Anzeige noch cameraBackground ein Farbbild brauchen
+    public bool luminanceCapture = false;
+
+    // Fläche hinter dem Würfel, auf der das Kamerabild angezeigt wird (z.B. ein Quad). Ohne Fläche wird kein Bild exportiert
+    public Renderer cameraBackground;
+
+    // Array für die Ergebnisse der DLL. Wird einmalig angelegt und in jedem Frame wiederverwendet
+    private MarkerPose[] markerPoses;
+
+    // Textur des Kamerabildes, wird nur bei neuer Bildgröße angelegt, und die Nummer des zuletzt geladenen Bildes
+    private Texture2D cameraTexture;
+    private ulong cameraFrameSequence;
+
+    // True, wenn die geladene DLL nur die ursprüngliche Schnittstelle hat (initialize(), estimatePoseMarkerAndDetection(),
+    // get*Coordinate()). Der Würfel folgt dann wie früher dem Marker, ohne Detektions-Thread, Posenliste und Kamerabild
+    private bool legacyLibrary;
+  
+
+
+    // Start wird vor dem ersten Frameupdate aufgerufen
+    void Start()
+    {
+        rb = GetComponent<Rigidbody>();
+
+        // Wenn isKinematic aktiv ist, Kräfte, Kollisionen oder Joints haben keinen Einfluss auf den Rigidbody
+        rb.isKinematic = true;
+
+        /*initializeEx() - Funktion: Initialisierung wichtiger Objekte, zur Durchführung der Prozesse
+                -@param 0: Kamerainput als Integer-Wert (0 als Standardanschluss für eine angeschlossene Kamera)
+                -@param INIT_BACKGROUND_WORKER: Aufnahme und Erkennung laufen im Detektions-Thread der DLL
+                -@param INIT_HEADLESS: Ohne Debug-Anzeige, falls showDebugView abgeschaltet ist
+                -@param INIT_LUMINANCE_CAPTURE: Nur die Helligkeit der Kamera lesen, falls luminanceCapture aktiv ist */
+        try
+        {
+            initializeEx(0, INIT_BACKGROUND_WORKER | (showDebugView ? 0 : INIT_HEADLESS) |
+                (luminanceCapture ? INIT_LUMINANCE_CAPTURE : 0));
+        }
+        catch (EntryPointNotFoundException)
+        {
+            // Die DLL in Assets/Plugins ist älter als dieses Skript und kennt nur die ursprünglichen Funktionen
+            Debug.LogWarning("OpenCV_Library ohne initializeEx(), es wird die ursprüngliche Schnittstelle verwendet");
+            legacyLibrary = true;
+
+            initialize(0);
+            Debug.Log("Camera Calibration loaded: " + loadCameraCalibration("CameraCalibration"));
+            return;
+        }
+
+        markerPoses = new MarkerPose[getMaxMarkerCount()];
+
+        // Das Kamerabild wird in der DLL einmal pro Bild nach RGBA umgewandelt und direkt aus ihrem Speicher geladen
+        if (cameraBackground != null)
+        {
+            setFrameExport(FRAME_EXPORT_RGBA);
+        }
+
+        /* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei
+		        - @param "CameraCalibration.bin": Name der zu ladenen Datei (binäres Format des Kalibrierungsprogramms,
+		          eine alte Textdatei "CameraCalibration" übernimmt das Kalibrierungsprogramm beim ersten Start)
+		        - @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
+        bool calibrationLoaded = loadCameraCalibration("CameraCalibration.bin");
+        Debug.Log("Camera Calibration loaded: " + calibrationLoaded);
+       
+    }
+
+
+
+    // Wenn die Anwendung beendet wird, werden alle Fenster geschlossen und nicht mehr benötigte Objekte "freigegeben"
+    void OnApplicationQuit()
+    {
+        close();
+    }
+
+
+
+    // Update wird einmal pro Frame aufgerufen
+    void Update()
+    {
+        if (legacyLibrary)
+        {
+            updateLegacy();
+            return;
+        }
+
+        /* estimatePoseMarkerAndDetection()-Funktion: Übernimmt das neueste Ergebnis des Detektions-Threads (blockiert nicht)
+		        - @param return: -1 für einen Fehlschlag, 1 für ein neues Ergebnis, 0 wenn noch kein neues Ergebnis vorliegt*/
+        estimatePoseMarkerAndDetection();
+
+        // Alle erkannten Marker mit einem einzigen Aufruf holen. Der Würfel folgt dem ersten Marker, ohne Marker
+        // steht er wie bisher im Ursprung
+        int markerCount;
+
+        if (extrapolateToDisplayTime)
+        {
+            long displayTimestamp = getMonotonicTimestamp() + (long)(Time.smoothDeltaTime * 1000000.0f);
+            markerCount = getExtrapolatedMarkerPoses(displayTimestamp, markerPoses, markerPoses.Length);
+        }
+        else
+        {
+            markerCount = getMarkerPoses(markerPoses, markerPoses.Length);
+        }
+
+        MarkerPose pose = markerCount > 0 ? markerPoses[0] : new MarkerPose();
+
+        updateCameraBackground();
+
+        // Übertragung der Translations-Koordinaten. Dabei werden die double-Koordinaten in float umgewandelt
+        // Die Y-Koordinate wird mit (-1) multipliziert, weil OpenCv ein rechtshändiges Koordinatensystem hat
+        // und Unity ein linkshändiges Koordinatensystem verwendet
+        transform.position = new Vector3(Convert.ToSingle(pose.translationX), Convert.ToSingle(pose.translationY) * (-1.0f),
+            Convert.ToSingle(pose.translationZ));
+        rb.MovePosition(transform.position * Time.deltaTime);
+
+        //Debug.Log("X-Translation: " + Convert.ToSingle(getXCoordinate()));
+        //Debug.Log("Y-Translation: " + Convert.ToSingle(getYCoordinate()));
+        //Debug.Log("Z-Translation: " + Convert.ToSingle(getZCoordinate()));
+
+    }
+
+
+
+    // Update() mit der ursprünglichen Schnittstelle der DLL: Erkennung im Aufruf und die Translation des ersten Markers
+    void updateLegacy()
+    {
+        estimatePoseMarkerAndDetection();
+
+        transform.position = new Vector3(Convert.ToSingle(getXCoordinate()), Convert.ToSingle(getYCoordinate()) * (-1.0f),
+            Convert.ToSingle(getZCoordinate()));
+        rb.MovePosition(transform.position * Time.deltaTime);
+    }
+
+
+
+    // Lädt ein neues Kamerabild aus dem Puffer der DLL in die Textur des Hintergrunds. Die DLL schreibt nicht in den
+    // Puffer, solange er gehalten wird, deshalb wird er direkt nach dem Laden wieder freigegeben
+    void updateCameraBackground()
+    {
+        if (cameraBackground == null || getExportedFrameSequence() == cameraFrameSequence)
+        {
+            return;
+        }
+
+        ExportedFrame frame;
+
+        if (acquireExportedFrame(out frame) == 0)
+        {
+            return;
+        }
+
+        if (cameraTexture == null || cameraTexture.width != frame.width || cameraTexture.height != frame.height)
+        {
+            cameraTexture = new Texture2D(frame.width, frame.height, TextureFormat.RGBA32, false);
+            cameraBackground.material.mainTexture = cameraTexture;
+
+            // Die DLL liefert die oberste Bildzeile zuerst, Unity erwartet die unterste zuerst
+            cameraBackground.material.mainTextureScale = new Vector2(1.0f, -1.0f);
+            cameraBackground.material.mainTextureOffset = new Vector2(0.0f, 1.0f);
+        }
+
+        cameraTexture.LoadRawTextureData(frame.pixels, frame.size);
+        releaseExportedFrame();
+
+        cameraTexture.Apply(false);
+        cameraFrameSequence = frame.sequence;
+    }
+
+}
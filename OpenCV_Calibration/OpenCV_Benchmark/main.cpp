@@ -0,0 +1,1339 @@
+#include <opencv2/core.hpp>
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <algorithm>
+#include <new>
+#include <cstdlib>
+#include <cstdio>
+#include <cmath>
+#include <cstring>
+#include <climits>
+#include <cerrno>
+
+#include "../../OpenCV_Library/OpenCV_Library/DetectorContext.h"
+#include "../../OpenCV_Library/OpenCV_Library/FrameSource.h"
+#include "../../OpenCV_Library/OpenCV_Library/CalibrationFile.h"
+#include "../../OpenCV_Library/PoseBusReader/PoseBusReader.h"
+
+using namespace std;
+using namespace cv;
+
+// Benchmark der Erkennungs- und Posen-Pipeline. Jeder Fall läuft über DetectorContext::estimatePoseMarkerAndDetection(),
+// also genau den Weg, den auch die DLL verwendet. Ergebnis ist eine JSON-Datei, die zwischen zwei Versionen verglichen
+// werden kann.
+//
+// Aufruf: OpenCV_Benchmark [--frames N] [--warmup N] [--max-threads N] [--source <uri>] [--output benchmark.json]
+//							[--corner-tolerance <Pixel>] [--validate <uri>] [--pose-bus-test <Sekunden>]
+//							[--allocation-test <Bilder>]
+//		- Ohne --source werden synthetische Bilder verwendet (Auflösung, Markeranzahl, Markergröße und Threads variiert)
+//		- Mit --source wird eine aufgenommene Bildquelle abgespielt (z.B. "file:aufnahme.mp4" oder "dir:Bilder"),
+//		  nur die Anzahl der Threads, die Kandidatensuche und das Aufnahmeformat werden variiert
+//		- Die Fälle "capture" vergleichen das Aufnahmeformat BGR mit INIT_LUMINANCE_CAPTURE (Bytes pro Bild, die Aufnahme
+//		  und Grauwandlung lesen und schreiben, in ingested_bytes_per_frame)
+//		- Die Fälle "tiles" vergleichen auf 3840x2160 die Erkennung über das ganze Bild mit der Erkennung in Kacheln
+//		  (tileMarkerSize = Seite der Marker) bei 1 bis --max-threads Threads für OpenCV (cv::setNumThreads(), in
+//		  opencv_threads). Beide müssen dieselben Marker finden, sonst schlägt der Vergleich "tiles" fehl
+//		- Vor den Fällen wird die eigene Kandidatensuche (CANDIDATE_SEARCH_FAST) Bild für Bild mit aruco::detectMarkers()
+//		  verglichen (gleiche IDs, Abweichung der Ecken), pro Auflösung bzw. auf der aufgenommenen Quelle, ebenso die
+//		  Erkennung in Kacheln mit der Erkennung über das ganze Bild. Ein Vergleich gilt als bestanden, wenn in jedem Bild
+//		  dieselben IDs gefunden werden und keine Ecke weiter als --corner-tolerance (Standard 1 Pixel) abweicht. Schlägt
+//		  ein Vergleich fehl, wird benchmark.json trotzdem geschrieben, der Rückgabewert ist aber 1
+//		- Mit --validate läuft statt des Benchmarks nur der Vergleich der Kandidatensuchen auf einer aufgenommenen Quelle
+//		  (Rückgabewert 1 bei Abweichungen). Maßgeblich für die Freigabe der eigenen Kandidatensuche ist ein aufgenommener
+//		  Bildsatz der eigenen Kameras und Marker, z.B. --validate dir:Aufnahmen (alle Bilder, --frames begrenzt die Anzahl)
+//		- Mit --pose-bus-test läuft statt des Benchmarks nur der Test des Posen-Busses (Durchsatz von Schreiber und Lesern,
+//		  keine gemischt gelesenen Einträge, Rückgabewert 1 bei Fehlern)
+//		- Mit --allocation-test läuft statt des Benchmarks nur die Prüfung, dass die Pipeline mit den Standardeinstellungen
+//		  nach dem Aufwärmen (--warmup) in keinem Bild mehr allokiert (mehrere Auflösungen, Rückgabewert 1 bei
+//		  Allokationen). Maßgeblich ist der Durchlauf mit einem Thread für OpenCV, mit mehreren Threads legt der
+//		  Thread-Pool von OpenCV pro parallel_for_() einen Auftrag an, diese Zahlen werden nur gemeldet
+//		- allocations_per_frame zählt Heap-Allokationen pro Bild, was genau gezählt wird steht in allocation_counter:
+//		  "process_malloc" (glibc, jede Allokation im Prozess über alle Threads) oder "executable_operator_new" (Windows,
+//		  nur operator new des Programms, nicht der Heap der OpenCV-DLLs)
+
+// Zähler der Heap-Allokationen, allocationCounter beschreibt für benchmark.json, was gezählt wird.
+// Mit glibc ersetzt das Programm malloc() und Co., die Aufrufe werden an die Implementierung von glibc weitergereicht.
+// Da Symbole des Programms vor denen der Bibliotheken gebunden werden, zählt das jede Allokation im Prozess: in allen
+// Threads, in OpenCV (cv::fastMalloc), in der C++-Standardbibliothek und in der eigenen Pipeline.
+// Unter Windows haben die OpenCV-DLLs ihren eigenen Heap der Laufzeitbibliothek, dort zählt nur operator new dieses
+// Programms (eigene Pipeline, Vektoren, Puffer, ...)
+atomic<long long> allocationCount(0);
+
+#if defined(__GLIBC__)
+const char* allocationCounter = "process_malloc";
+
+extern "C" {
+
+	void* __libc_malloc(size_t size);
+	void* __libc_calloc(size_t count, size_t size);
+	void* __libc_realloc(void* memory, size_t size);
+	void* __libc_memalign(size_t alignment, size_t size);
+	void* __libc_valloc(size_t size);
+	void* __libc_pvalloc(size_t size);
+	void __libc_free(void* memory);
+
+	void* malloc(size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_malloc(size);
+	}
+
+	void* calloc(size_t count, size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_calloc(count, size);
+	}
+
+	// Nur das Wachsen oder Anlegen eines Blocks zählt, realloc(p, 0) gibt frei
+	void* realloc(void* memory, size_t size) {
+
+		if (memory == nullptr || size > 0) {
+
+			allocationCount.fetch_add(1, memory_order_relaxed);
+		}
+
+		return __libc_realloc(memory, size);
+	}
+
+	void* memalign(size_t alignment, size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_memalign(alignment, size);
+	}
+
+	void* aligned_alloc(size_t alignment, size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_memalign(alignment, size);
+	}
+
+	int posix_memalign(void** memory, size_t alignment, size_t size) {
+
+		if (alignment < sizeof(void*) || (alignment & (alignment - 1)) != 0) {
+
+			return EINVAL;
+		}
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		*memory = __libc_memalign(alignment, size);
+
+		return *memory != nullptr || size == 0 ? 0 : ENOMEM;
+	}
+
+	void* valloc(size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_valloc(size);
+	}
+
+	void* pvalloc(size_t size) {
+
+		allocationCount.fetch_add(1, memory_order_relaxed);
+		return __libc_pvalloc(size);
+	}
+
+	void free(void* memory) {
+
+		__libc_free(memory);
+	}
+}
+#else
+const char* allocationCounter = "executable_operator_new";
+
+void* operator new(size_t size) {
+
+	allocationCount.fetch_add(1, memory_order_relaxed);
+
+	if (void* memory = malloc(size > 0 ? size : 1)) {
+
+		return memory;
+	}
+
+	throw bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+
+	free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept {
+
+	free(memory);
+}
+#endif
+
+
+// Ein Fall des Benchmarks
+struct BenchmarkCase {
+
+	string group;
+	string sourceUri;
+	Size resolution;
+	int markerCount;
+	int markerSize;
+	int threads;
+
+	// CANDIDATE_SEARCH_FAST oder CANDIDATE_SEARCH_ARUCO
+	int candidateSearch;
+
+	// CAPTURE_FORMAT_BGR oder CAPTURE_FORMAT_LUMINANCE (INIT_LUMINANCE_CAPTURE)
+	int captureFormat;
+
+	// DetectorSettings::tileMarkerSize (0 = Erkennung über das ganze Bild)
+	int tileMarkerSize;
+
+	// Threads, die OpenCV innerhalb einer Erkennung verwendet (cv::setNumThreads()), 0 = Standard von OpenCV
+	int openCvThreads;
+};
+
+// Ergebnis eines Falls
+struct BenchmarkResult {
+
+	long long frames;
+	double seconds;
+	double framesPerSecond;
+	double allocationsPerFrame;
+	double detectionHitRate;
+
+	// Anteil der Bilder, in denen wegen unveränderter Szene nicht erkannt wurde
+	double skippedFrameRate;
+
+	// Bytes, die Aufnahme und Grauwandlung pro Bild gelesen und geschrieben haben
+	double ingestedBytesPerFrame;
+	StageLatency stages[STAGE_COUNT];
+};
+
+// Vergleich zweier Erkennungswege auf einer Bildquelle (z.B. eigene Kandidatensuche gegen aruco::detectMarkers())
+struct ValidationResult {
+
+	// Was verglichen wurde ("candidate_search" oder "tiles")
+	string comparison;
+	string sourceUri;
+	long long frames;
+
+	// Bilder, in denen beide Wege genau dieselben IDs gefunden haben
+	long long framesWithSameIds;
+
+	// Marker, die nur der Referenzweg (missing) bzw. nur der geprüfte Weg (extra) gefunden hat
+	long long missingMarkers, extraMarkers;
+
+	// Abweichung gleicher Ecken in Pixeln
+	double meanCornerError;
+	double maxCornerError;
+
+	// Größte erlaubte Abweichung einer Ecke in Pixeln und ob der Vergleich bestanden ist (mindestens ein Bild, in jedem
+	// Bild dieselben IDs, keine Ecke über der Toleranz)
+	double cornerTolerance;
+	bool passed;
+};
+
+
+/* writeCalibrationFile()-Funktion: Schreibt eine plausible Kalibrierung (Brennweite = Bildbreite, Hauptpunkt in der
+   Bildmitte, keine Verzeichnung) im binären Format (siehe CalibrationFile.h)
+		- @param name: Name der Datei
+		- @param resolution: Bildgröße, aus der die Kalibrierung abgeleitet wird
+		- @param return: True, wenn die Datei geschrieben werden konnte*/
+bool writeCalibrationFile(const string& name, const Size& resolution) {
+
+	Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
+	cameraMatrix.at<double>(0, 0) = resolution.width;
+	cameraMatrix.at<double>(1, 1) = resolution.width;
+	cameraMatrix.at<double>(0, 2) = resolution.width / 2.0;
+	cameraMatrix.at<double>(1, 2) = resolution.height / 2.0;
+
+	return saveCalibrationFile(name, cameraMatrix, Mat::zeros(5, 1, CV_64F), resolution, 0.0);
+}
+
+
+/* syntheticUri()-Funktion: URI der synthetischen Bildquelle für einen Fall
+		- @param return: z.B. "synthetic:1280x720?markers=1&size=96"*/
+string syntheticUri(const Size& resolution, int markerCount, int markerSize) {
+
+	ostringstream uri;
+	uri << "synthetic:" << resolution.width << "x" << resolution.height << "?markers=" << markerCount << "&size="
+		<< markerSize;
+
+	return uri.str();
+}
+
+
+/* runCase()-Funktion: Führt einen Fall aus. Jeder Thread hat seinen eigenen Kontext (wie eine Kamera pro Kontext)
+   und ruft estimatePoseMarkerAndDetection() synchron auf
+		- @param benchmarkCase: Der auszuführende Fall
+		- @param frames: Gemessene Bilder pro Thread
+		- @param warmupFrames: Bilder pro Thread, die vor der Messung verworfen werden
+		- @param return: Ergebnis des Falls*/
+BenchmarkResult runCase(const BenchmarkCase& benchmarkCase, int frames, int warmupFrames) {
+
+	// Bei aufgenommenen Quellen ist die Bildgröße vorher nicht bekannt, dann bleibt die Einheitsmatrix
+	const string calibrationFileName = "BenchmarkCalibration.bin";
+	bool calibrated = benchmarkCase.resolution.area() > 0 &&
+		writeCalibrationFile(calibrationFileName, benchmarkCase.resolution);
+
+	vector<unique_ptr<DetectorContext>> contexts;
+
+	for (int t = 0; t < benchmarkCase.threads; ++t) {
+
+		contexts.emplace_back(new DetectorContext(benchmarkCase.sourceUri, INIT_HEADLESS |
+			(benchmarkCase.captureFormat == CAPTURE_FORMAT_LUMINANCE ? INIT_LUMINANCE_CAPTURE : 0)));
+
+		DetectorSettings settings = contexts.back()->detector().getSettings();
+		settings.candidateSearch = benchmarkCase.candidateSearch;
+		settings.tileMarkerSize = benchmarkCase.tileMarkerSize;
+		contexts.back()->detector().setSettings(settings);
+
+		if (calibrated) {
+
+			contexts.back()->loadCameraCalibration(calibrationFileName.c_str());
+		}
+	}
+
+	if (calibrated) {
+
+		remove(calibrationFileName.c_str());
+	}
+
+	vector<long long> processed(benchmarkCase.threads, 0);
+
+	auto runAll = [&](int count) {
+
+		vector<thread> threads;
+
+		for (int t = 0; t < benchmarkCase.threads; ++t) {
+
+			threads.emplace_back([&, t] {
+
+				for (int i = 0; i < count; ++i) {
+
+					// Eine aufgenommene Quelle ohne Schleife kann vorher zu Ende sein
+					if (contexts[t]->estimatePoseMarkerAndDetection() < 0) {
+
+						break;
+					}
+
+					++processed[t];
+				}
+			});
+		}
+
+		for (thread& worker : threads) {
+
+			worker.join();
+		}
+	};
+
+	if (benchmarkCase.openCvThreads > 0) {
+
+		setNumThreads(benchmarkCase.openCvThreads);
+	}
+
+	runAll(warmupFrames);
+
+	for (unique_ptr<DetectorContext>& context : contexts) {
+
+		context->resetStats();
+	}
+
+	fill(processed.begin(), processed.end(), 0);
+
+	long long allocationsBefore = allocationCount.load();
+	chrono::steady_clock::time_point start = chrono::steady_clock::now();
+
+	runAll(frames);
+
+	double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+	long long allocations = allocationCount.load() - allocationsBefore;
+
+	// Zurück auf den Standard von OpenCV für die folgenden Fälle
+	setNumThreads(-1);
+
+	BenchmarkResult result = BenchmarkResult();
+
+	for (long long count : processed) {
+
+		result.frames += count;
+	}
+
+	result.seconds = seconds;
+	result.framesPerSecond = seconds > 0.0 ? result.frames / seconds : 0.0;
+	result.allocationsPerFrame = result.frames > 0 ? (double)allocations / result.frames : 0.0;
+
+	// Über mehrere Kontexte wird jeweils der schlechteste Wert berichtet
+	long long framesWithMarkers = 0;
+	long long framesProcessed = 0;
+	long long framesSkipped = 0;
+	long long framesCaptured = 0;
+	long long ingestedBytes = 0;
+
+	for (unique_ptr<DetectorContext>& context : contexts) {
+
+		DetectorStats stats;
+		context->getStats(stats);
+
+		framesWithMarkers += stats.framesWithMarkers;
+		framesProcessed += stats.framesProcessed;
+		framesSkipped += stats.framesSkipped;
+		framesCaptured += stats.framesCaptured;
+		ingestedBytes += stats.ingestedBytes;
+
+		const StageLatency* stages[STAGE_COUNT] = { &stats.captureWait, &stats.decode, &stats.detectMarkers,
+			&stats.estimatePose, &stats.render, &stats.captureToPublish };
+
+		for (int s = 0; s < STAGE_COUNT; ++s) {
+
+			result.stages[s].p50 = max(result.stages[s].p50, stages[s]->p50);
+			result.stages[s].p95 = max(result.stages[s].p95, stages[s]->p95);
+			result.stages[s].p99 = max(result.stages[s].p99, stages[s]->p99);
+			result.stages[s].max = max(result.stages[s].max, stages[s]->max);
+		}
+	}
+
+	result.detectionHitRate = framesProcessed > 0 ? (double)framesWithMarkers / framesProcessed : 0.0;
+	result.skippedFrameRate = framesProcessed > 0 ? (double)framesSkipped / framesProcessed : 0.0;
+	result.ingestedBytesPerFrame = framesCaptured > 0 ? (double)ingestedBytes / framesCaptured : 0.0;
+
+	return result;
+}
+
+
+/* sortedMarkers()-Funktion: Sortiert die erkannten Marker nach ID und erster Ecke, damit zwei Erkennungen Marker für
+   Marker verglichen werden können
+		- @param corners: Erkannte Ecken
+		- @param ids: Erkannte IDs
+		- @param return: Indizes der Marker in sortierter Reihenfolge*/
+vector<int> sortedMarkers(const vector<vector<Point2f>>& corners, const vector<int>& ids) {
+
+	vector<int> order(ids.size());
+
+	for (size_t i = 0; i < order.size(); ++i) {
+
+		order[i] = (int)i;
+	}
+
+	sort(order.begin(), order.end(), [&](int a, int b) {
+
+		if (ids[a] != ids[b]) {
+
+			return ids[a] < ids[b];
+		}
+
+		return corners[a][0].x < corners[b][0].x;
+	});
+
+	return order;
+}
+
+
+/* validateDetectors()-Funktion: Erkennt jedes Bild einer Quelle mit zwei Einstellungen und vergleicht IDs und Ecken
+		- @param comparison: Name des Vergleichs
+		- @param sourceUri: Bildquelle
+		- @param testSettings: Einstellungen des geprüften Weges
+		- @param referenceSettings: Einstellungen des Referenzweges
+		- @param frames: Höchstzahl der verglichenen Bilder
+		- @param cornerTolerance: Größte erlaubte Abweichung einer Ecke in Pixeln
+		- @param return: Ergebnis des Vergleichs*/
+ValidationResult validateDetectors(const string& comparison, const string& sourceUri,
+	const DetectorSettings& testSettings, const DetectorSettings& referenceSettings, int frames, double cornerTolerance) {
+
+	ValidationResult result = ValidationResult();
+	result.comparison = comparison;
+	result.sourceUri = sourceUri;
+	result.cornerTolerance = cornerTolerance;
+
+	unique_ptr<FrameSource> source = createFrameSource(sourceUri);
+
+	if (!source || !source->isOpened()) {
+
+		return result;
+	}
+
+	Ptr<aruco::Dictionary> dictionary = aruco::getPredefinedDictionary(aruco::DICT_4X4_50);
+	MarkerDetector detectors[2];
+	const DetectorSettings* settings[2] = { &testSettings, &referenceSettings };
+
+	for (int d = 0; d < 2; ++d) {
+
+		detectors[d].setDictionary(dictionary);
+		detectors[d].setSettings(*settings[d]);
+	}
+
+	Mat frame;
+	vector<vector<Point2f>> corners[2];
+	vector<int> ids[2];
+	double cornerErrorSum = 0.0;
+	long long cornerCount = 0;
+
+	for (int i = 0; i < frames && source->grab() && source->retrieve(frame); ++i) {
+
+		for (int d = 0; d < 2; ++d) {
+
+			detectors[d].detect(frame, corners[d], ids[d]);
+		}
+
+		++result.frames;
+
+		vector<int> testOrder = sortedMarkers(corners[0], ids[0]);
+		vector<int> referenceOrder = sortedMarkers(corners[1], ids[1]);
+		bool sameIds = testOrder.size() == referenceOrder.size();
+		size_t t = 0, r = 0;
+
+		// Beide Listen sind nach ID sortiert, gleiche IDs werden paarweise verglichen
+		while (t < testOrder.size() && r < referenceOrder.size()) {
+
+			int testId = ids[0][testOrder[t]];
+			int referenceId = ids[1][referenceOrder[r]];
+
+			if (testId < referenceId) {
+
+				++result.extraMarkers;
+				sameIds = false;
+				++t;
+			}
+			else if (referenceId < testId) {
+
+				++result.missingMarkers;
+				sameIds = false;
+				++r;
+			}
+			else {
+
+				for (int c = 0; c < 4; ++c) {
+
+					Point2f difference = corners[0][testOrder[t]][c] - corners[1][referenceOrder[r]][c];
+					double error = sqrt(difference.dot(difference));
+
+					cornerErrorSum += error;
+					++cornerCount;
+					result.maxCornerError = max(result.maxCornerError, error);
+				}
+
+				++t;
+				++r;
+			}
+		}
+
+		result.extraMarkers += (long long)(testOrder.size() - t);
+		result.missingMarkers += (long long)(referenceOrder.size() - r);
+
+		if (sameIds && t == testOrder.size() && r == referenceOrder.size()) {
+
+			++result.framesWithSameIds;
+		}
+	}
+
+	result.meanCornerError = cornerCount > 0 ? cornerErrorSum / cornerCount : 0.0;
+	result.passed = result.frames > 0 && result.framesWithSameIds == result.frames &&
+		result.maxCornerError <= cornerTolerance;
+
+	return result;
+}
+
+
+/* validationSettings()-Funktion: Einstellungen für die Vergleiche, jedes Bild wird vollständig erkannt (ohne
+   Verfolgung, Verkleinerung und Bewegungsprüfung)
+		- @param return: Einstellungen*/
+DetectorSettings validationSettings() {
+
+	DetectorSettings settings = defaultDetectorSettings();
+	settings.trackingEnabled = 0;
+	settings.pyramidScale = 1.0f;
+	settings.motionThreshold = 0.0f;
+
+	return settings;
+}
+
+
+/* validateCandidateSearch()-Funktion: Vergleicht die eigene Kandidatensuche mit aruco::detectMarkers()
+		- @param sourceUri: Bildquelle
+		- @param frames: Höchstzahl der verglichenen Bilder
+		- @param cornerTolerance: Größte erlaubte Abweichung einer Ecke in Pixeln
+		- @param return: Ergebnis des Vergleichs*/
+ValidationResult validateCandidateSearch(const string& sourceUri, int frames, double cornerTolerance) {
+
+	DetectorSettings fastSettings = validationSettings();
+	fastSettings.candidateSearch = CANDIDATE_SEARCH_FAST;
+
+	DetectorSettings arucoSettings = validationSettings();
+	arucoSettings.candidateSearch = CANDIDATE_SEARCH_ARUCO;
+
+	return validateDetectors("candidate_search", sourceUri, fastSettings, arucoSettings, frames, cornerTolerance);
+}
+
+
+/* validateTiles()-Funktion: Vergleicht die Erkennung in Kacheln mit der Erkennung über das ganze Bild
+		- @param sourceUri: Bildquelle
+		- @param tileMarkerSize: Größte erwartete Markerseite in Pixeln (DetectorSettings::tileMarkerSize)
+		- @param candidateSearch: Kandidatensuche beider Wege (CANDIDATE_SEARCH_FAST oder CANDIDATE_SEARCH_ARUCO)
+		- @param frames: Höchstzahl der verglichenen Bilder
+		- @param cornerTolerance: Größte erlaubte Abweichung einer Ecke in Pixeln
+		- @param return: Ergebnis des Vergleichs*/
+ValidationResult validateTiles(const string& sourceUri, int tileMarkerSize, int candidateSearch, int frames,
+	double cornerTolerance) {
+
+	DetectorSettings fullSettings = validationSettings();
+	fullSettings.candidateSearch = candidateSearch;
+
+	DetectorSettings tiledSettings = fullSettings;
+	tiledSettings.tileMarkerSize = tileMarkerSize;
+
+	return validateDetectors("tiles", sourceUri, tiledSettings, fullSettings, frames, cornerTolerance);
+}
+
+
+/* makeCase()-Funktion: Fall mit allen Feldern, Aufnahmeformat BGR, ohne Kacheln und mit dem Standard von OpenCV für
+   dessen Threads. Abweichungen davon setzt der Aufrufer
+		- @param return: Der Fall*/
+BenchmarkCase makeCase(const string& group, const string& sourceUri, const Size& resolution, int markerCount,
+	int markerSize, int threads, int candidateSearch) {
+
+	BenchmarkCase benchmarkCase;
+
+	benchmarkCase.group = group;
+	benchmarkCase.sourceUri = sourceUri;
+	benchmarkCase.resolution = resolution;
+	benchmarkCase.markerCount = markerCount;
+	benchmarkCase.markerSize = markerSize;
+	benchmarkCase.threads = threads;
+	benchmarkCase.candidateSearch = candidateSearch;
+	benchmarkCase.captureFormat = CAPTURE_FORMAT_BGR;
+	benchmarkCase.tileMarkerSize = 0;
+	benchmarkCase.openCvThreads = 0;
+
+	return benchmarkCase;
+}
+
+
+/* buildCases()-Funktion: Stellt die Fälle zusammen. Ausgehend von einem Grundfall (1280x720, 1 Marker mit 96 Pixeln,
+   1 Thread) wird jeweils nur eine Größe verändert, damit die Auswirkung jeder Größe einzeln sichtbar ist
+		- @param sourceUri: Aufgenommene Bildquelle oder "" für synthetische Bilder
+		- @param maxThreads: Größte Anzahl an Threads
+		- @param return: Liste der Fälle*/
+vector<BenchmarkCase> buildCases(const string& sourceUri, int maxThreads) {
+
+	vector<BenchmarkCase> cases;
+
+	vector<int> threadCounts;
+
+	for (int threads = 1; threads <= maxThreads; threads *= 2) {
+
+		threadCounts.push_back(threads);
+	}
+
+	if (!sourceUri.empty()) {
+
+		for (int threads : threadCounts) {
+
+			cases.push_back(makeCase("threads", sourceUri, Size(0, 0), 0, 0, threads, CANDIDATE_SEARCH_FAST));
+		}
+
+		cases.push_back(makeCase("candidate_search", sourceUri, Size(0, 0), 0, 0, 1, CANDIDATE_SEARCH_ARUCO));
+		cases.push_back(makeCase("capture", sourceUri, Size(0, 0), 0, 0, 1, CANDIDATE_SEARCH_FAST));
+		cases.back().captureFormat = CAPTURE_FORMAT_LUMINANCE;
+
+		return cases;
+	}
+
+	const Size resolutions[] = { Size(640, 480), Size(1280, 720), Size(1920, 1080), Size(3840, 2160) };
+	const int markerCounts[] = { 1, 10, 25, 50 };
+	const int markerSizes[] = { 32, 64, 128, 256 };
+
+	// Jede Auflösung mit beiden Kandidatensuchen
+	for (const Size& resolution : resolutions) {
+
+		cases.push_back(makeCase("resolution", "", resolution, 1, 96, 1, CANDIDATE_SEARCH_FAST));
+		cases.push_back(makeCase("resolution", "", resolution, 1, 96, 1, CANDIDATE_SEARCH_ARUCO));
+	}
+
+	for (int markerCount : markerCounts) {
+
+		cases.push_back(makeCase("markers", "", Size(1920, 1080), markerCount, 64, 1, CANDIDATE_SEARCH_FAST));
+	}
+
+	for (int markerSize : markerSizes) {
+
+		cases.push_back(makeCase("marker_size", "", Size(1280, 720), 1, markerSize, 1, CANDIDATE_SEARCH_FAST));
+	}
+
+	for (int threads : threadCounts) {
+
+		cases.push_back(makeCase("threads", "", Size(1280, 720), 1, 96, threads, CANDIDATE_SEARCH_FAST));
+	}
+
+	// Jede Auflösung einmal als Farbbild und einmal nur mit der Helligkeit (wie eine Kamera, die NV12 liefert)
+	for (const Size& resolution : resolutions) {
+
+		cases.push_back(makeCase("capture", "", resolution, 1, 96, 1, CANDIDATE_SEARCH_FAST));
+		cases.push_back(makeCase("capture", "", resolution, 1, 96, 1, CANDIDATE_SEARCH_FAST));
+		cases.back().captureFormat = CAPTURE_FORMAT_LUMINANCE;
+	}
+
+	// 4K mit vielen Markern über das ganze Bild und in Kacheln, jeweils mit 1 bis maxThreads Threads für OpenCV. Die
+	// Kacheln sind genau für die Seite der Marker ausgelegt (tileMarkerSize wird unten auf die tatsächliche Größe
+	// gesetzt), die Drehung rechnet der Detektor selbst ein
+	for (int threads : threadCounts) {
+
+		cases.push_back(makeCase("tiles", "", Size(3840, 2160), 25, 128, 1, CANDIDATE_SEARCH_FAST));
+		cases.back().openCvThreads = threads;
+
+		cases.push_back(makeCase("tiles", "", Size(3840, 2160), 25, 128, 1, CANDIDATE_SEARCH_FAST));
+		cases.back().openCvThreads = threads;
+		cases.back().tileMarkerSize = 128;
+	}
+
+	for (BenchmarkCase& benchmarkCase : cases) {
+
+		// Die synthetische Quelle verkleinert zu große Marker, berichtet wird die tatsächliche Größe
+		benchmarkCase.markerSize = SyntheticFrameSource(benchmarkCase.resolution, benchmarkCase.markerCount, 0.0,
+			benchmarkCase.markerSize).getMarkerSize();
+
+		if (benchmarkCase.tileMarkerSize > 0) {
+
+			benchmarkCase.tileMarkerSize = benchmarkCase.markerSize;
+		}
+		benchmarkCase.sourceUri = syntheticUri(benchmarkCase.resolution, benchmarkCase.markerCount,
+			benchmarkCase.markerSize);
+	}
+
+	return cases;
+}
+
+
+/* fillPoseBusMarkers()-Funktion: Erzeugt die Marker eines Testeintrags. Alle Werte hängen nur vom Index ab, so dass
+   ein Leser jeden Eintrag vollständig nachprüfen kann
+		- @param index: Index des Eintrags auf dem Bus
+		- @param markers: Ausgabe von POSE_BUS_MAX_MARKERS Markern
+		- @param return: Anzahl der belegten Marker*/
+int fillPoseBusMarkers(uint32_t index, MarkerPose* markers) {
+
+	const int count = (int)(index % (POSE_BUS_MAX_MARKERS + 1));
+
+	for (int m = 0; m < count; ++m) {
+
+		MarkerPose& marker = markers[m];
+		marker.id = (int)index + m;
+		marker.flags = m & MARKER_POSE_PREDICTED;
+
+		for (int k = 0; k < 3; ++k) {
+
+			marker.rotationVector[k] = index + 0.25 * (m + k);
+			marker.translationVector[k] = -(index + 0.5 * (m + k));
+		}
+
+		for (int c = 0; c < 8; ++c) {
+
+			marker.corners[c] = (float)((index + m + c) % 4096);
+		}
+
+		marker.reprojectionError = m * 0.125;
+		marker.captureTimestamp = (long long)index * 1000 + m;
+	}
+
+	return count;
+}
+
+
+/* isIntactPoseBusRecord()-Funktion: Prüft einen gelesenen Eintrag gegen die Werte, die der Test-Schreiber für seinen
+   Index erzeugt hat. Jede Abweichung bedeutet, dass Teile zweier Einträge gemischt gelesen wurden
+		- @param record: Gelesener Eintrag
+		- @param expected: Puffer für POSE_BUS_MAX_MARKERS erwartete Marker
+		- @param return: True, wenn der Eintrag vollständig stimmt*/
+bool isIntactPoseBusRecord(const PoseBusRecord& record, MarkerPose* expected) {
+
+	const int count = fillPoseBusMarkers(record.index, expected);
+
+	return record.markerCount == count && record.sequence == record.index * 7ULL &&
+		record.captureTimestamp == (long long)record.index * 1000 && record.detectionPath == (int)(record.index % 3) &&
+		memcmp(record.markers, expected, count * sizeof(MarkerPose)) == 0;
+}
+
+
+/* runPoseBusTest()-Funktion: Lokaler Test des Posen-Busses. Ein Thread schreibt so schnell wie möglich Einträge über
+   PoseBusPublisher, mehrere Leser-Threads lesen sie gleichzeitig über die C-Bibliothek (neuester Eintrag mit Kopie,
+   ältere Einträge aus dem Ring und den neuesten Eintrag ohne Kopie) und prüfen jeden gelesenen Eintrag
+		- @param seconds: Laufzeit des Tests
+		- @param return: 0 ohne Fehler, 1 bei gemischt gelesenen Einträgen, wenn der Bus nicht geöffnet werden konnte oder
+						 ein zweiter Schreiber ihn ebenfalls öffnen konnte*/
+int runPoseBusTest(double seconds) {
+
+	const string name = "OpenCV_Benchmark_PoseBusTest";
+	const int readerCount = max(1, min(4, (int)thread::hardware_concurrency() - 1));
+
+	PoseBusPublisher publisher;
+
+	if (!publisher.open(name)) {
+
+		cerr << "Posen-Bus konnte nicht angelegt werden: " << name << endl;
+		return 1;
+	}
+
+	// Solange der erste Schreiber den Bus besitzt, muss jeder weitere abgewiesen werden
+	PoseBusPublisher secondPublisher;
+
+	if (secondPublisher.open(name)) {
+
+		cerr << "Posen-Bus hat einen zweiten Schreiber angenommen: " << name << endl;
+		return 1;
+	}
+
+	const uint32_t firstIndex = publisher.publishedCount() + 1;
+	atomic<bool> running(true);
+	atomic<long long> reads(0), historyReads(0), overwrittenReads(0), busyReads(0), zeroCopyReads(0), tornReads(0);
+	vector<thread> readers;
+
+	for (int r = 0; r < readerCount; ++r) {
+
+		readers.emplace_back([&]() {
+
+			PoseBusReader* reader = poseBusOpen(name.c_str());
+
+			if (!reader) {
+
+				tornReads.fetch_add(1);
+				return;
+			}
+
+			unique_ptr<PoseBusRecord> record(new PoseBusRecord());
+			vector<MarkerPose> expected(POSE_BUS_MAX_MARKERS);
+			long long localReads = 0, localHistory = 0, localOverwritten = 0, localBusy = 0, localZeroCopy = 0,
+				localTorn = 0;
+
+			while (running.load(memory_order_relaxed)) {
+
+				const int latestResult = poseBusReadLatest(reader, record.get());
+
+				if (latestResult == POSE_BUS_BUSY) {
+
+					++localBusy;
+				}
+
+				if (latestResult != 1 || record->index < firstIndex) {
+
+					continue;
+				}
+
+				++localReads;
+				localTorn += isIntactPoseBusRecord(*record, expected.data()) ? 0 : 1;
+
+				// Ein älterer Eintrag aus dem Ring, der während des Lesens überschrieben werden kann
+				const uint32_t latest = record->index;
+				const uint32_t older = latest - (uint32_t)(localReads % POSE_BUS_CAPACITY);
+				const int result = older >= firstIndex ? poseBusReadRecord(reader, older, record.get()) : 0;
+
+				if (result == 1) {
+
+					++localHistory;
+					localTorn += isIntactPoseBusRecord(*record, expected.data()) && record->index == older ? 0 : 1;
+				}
+				else if (result == POSE_BUS_BUSY) {
+
+					++localBusy;
+				}
+				else if (result < 0) {
+
+					++localOverwritten;
+				}
+
+				// Ohne Kopie: Die Werte zählen nur, wenn poseBusEndRead() sie bestätigt
+				uint32_t ticket;
+				const uint32_t newest = poseBusPublishedCount(reader);
+				const PoseBusRecord* inPlace = poseBusBeginRead(reader, newest, &ticket);
+
+				if (inPlace && newest >= firstIndex) {
+
+					const bool intact = isIntactPoseBusRecord(*inPlace, expected.data());
+
+					if (poseBusEndRead(reader, inPlace, ticket)) {
+
+						++localZeroCopy;
+						localTorn += intact ? 0 : 1;
+					}
+				}
+			}
+
+			poseBusClose(reader);
+
+			reads.fetch_add(localReads);
+			historyReads.fetch_add(localHistory);
+			overwrittenReads.fetch_add(localOverwritten);
+			busyReads.fetch_add(localBusy);
+			zeroCopyReads.fetch_add(localZeroCopy);
+			tornReads.fetch_add(localTorn);
+		});
+	}
+
+	vector<MarkerPose> markers(POSE_BUS_MAX_MARKERS);
+	long long published = 0;
+	const auto start = chrono::steady_clock::now();
+	const auto end = start + chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(seconds));
+
+	while (chrono::steady_clock::now() < end) {
+
+		const uint32_t index = publisher.publishedCount() + 1;
+		const int count = fillPoseBusMarkers(index, markers.data());
+
+		publisher.publish(index * 7ULL, (int)(index % 3), (long long)index * 1000, markers.data(), count);
+		++published;
+	}
+
+	running.store(false);
+
+	for (thread& reader : readers) {
+
+		reader.join();
+	}
+
+	const double elapsed = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+	cerr << "pose bus: " << readerCount << " Leser, " << published / elapsed << " Einträge/s geschrieben, "
+		<< reads.load() / elapsed << " neueste + " << historyReads.load() / elapsed << " ältere + "
+		<< zeroCopyReads.load() / elapsed << " ohne Kopie gelesen/s, " << overwrittenReads.load()
+		<< " ältere schon überschrieben, " << busyReads.load() << " ohne Erfolg abgebrochen, " << tornReads.load()
+		<< " fehlerhaft" << endl;
+
+	return tornReads.load() == 0 ? 0 : 1;
+}
+
+
+// Ein Fall der Allokationsprüfung
+struct AllocationCase {
+
+	string name;
+	Size resolution;
+	int markerCount;
+	DetectorSettings settings;
+
+	// False, wenn Allokationen in diesem Fall nur gemeldet werden und die Prüfung nicht scheitern lassen
+	bool strict;
+};
+
+
+// Ergebnis eines Durchlaufs der Allokationsprüfung
+struct AllocationCount {
+
+	long long total = 0;
+	long long framesWithAllocations = 0;
+	long long maxPerFrame = 0;
+};
+
+
+/* countAllocations()-Funktion: Lässt einen Fall der Allokationsprüfung mit eigenem Kontext im Headless-Modus laufen und
+   zählt die Allokationen Bild für Bild, mit der aktuellen Anzahl an Threads für OpenCV
+		- @param allocationCase: Der Fall
+		- @param frames: Geprüfte Bilder
+		- @param warmupFrames: Bilder vor der Prüfung, in denen die Puffer noch wachsen dürfen
+		- @param count: Ausgabe der gezählten Allokationen
+		- @param return: False, wenn die Kalibrierung nicht geschrieben oder die Bildquelle nicht gelesen werden konnte*/
+bool countAllocations(const AllocationCase& allocationCase, int frames, int warmupFrames, AllocationCount& count) {
+
+	const string calibrationFileName = "BenchmarkCalibration.bin";
+
+	if (!writeCalibrationFile(calibrationFileName, allocationCase.resolution)) {
+
+		cerr << "Kalibrierung konnte nicht geschrieben werden: " << calibrationFileName << endl;
+		return false;
+	}
+
+	DetectorContext context(syntheticUri(allocationCase.resolution, allocationCase.markerCount, 0), INIT_HEADLESS);
+	context.loadCameraCalibration(calibrationFileName.c_str());
+	context.detector().setSettings(allocationCase.settings);
+	remove(calibrationFileName.c_str());
+
+	for (int i = 0; i < warmupFrames; ++i) {
+
+		context.estimatePoseMarkerAndDetection();
+	}
+
+	count = AllocationCount();
+
+	for (int i = 0; i < frames; ++i) {
+
+		long long before = allocationCount.load();
+
+		if (context.estimatePoseMarkerAndDetection() < 0) {
+
+			cerr << "Bildquelle konnte nicht gelesen werden" << endl;
+			return false;
+		}
+
+		long long allocations = allocationCount.load() - before;
+
+		count.total += allocations;
+		count.framesWithAllocations += allocations > 0 ? 1 : 0;
+		count.maxPerFrame = max(count.maxPerFrame, allocations);
+	}
+
+	return true;
+}
+
+
+/* runAllocationTest()-Funktion: Prüft, dass ein Durchlauf der Pipeline mit den Standardeinstellungen nach dem
+   Aufwärmen nichts mehr auf dem Heap allokiert (Zähler wie bei allocations_per_frame). Gezählt wird Bild für Bild, so
+   dass auch seltene Wege (volle Suche nach fullScanInterval Bildern, neu gefundene Marker) erfasst werden.
+   Maßgeblich ist der Durchlauf mit einem Thread für OpenCV: parallel_for_() legt bei mehreren Threads für jeden
+   Aufruf einen Auftrag im Thread-Pool von OpenCV an. Der Durchlauf mit der Standardanzahl an Threads wird deshalb nur
+   gemeldet, ebenso der Fall mit pyramidScale < 1 (resize() und cornerSubPix() allokieren pro Aufruf)
+		- @param frames: Geprüfte Bilder pro Fall
+		- @param warmupFrames: Bilder pro Fall, in denen die Puffer noch wachsen dürfen
+		- @param return: 0 wenn kein maßgeblicher Durchlauf allokiert, sonst 1*/
+int runAllocationTest(int frames, int warmupFrames) {
+
+	vector<AllocationCase> cases;
+
+	DetectorSettings standard = defaultDetectorSettings();
+
+	// Mit motionThreshold = 0 läuft die Erkennung auch auf Bildern, die das MotionGate sonst überspringen würde
+	DetectorSettings tracking = standard;
+	tracking.motionThreshold = 0.0f;
+
+	DetectorSettings fullScan = standard;
+	fullScan.trackingEnabled = 0;
+
+	DetectorSettings scaled = standard;
+	scaled.pyramidScale = 0.5f;
+
+	DetectorSettings tiled = fullScan;
+	tiled.tileMarkerSize = 256;
+
+	cases.push_back({ "640x480 Standard", Size(640, 480), 4, standard, true });
+	cases.push_back({ "640x480 volle Suche", Size(640, 480), 4, fullScan, true });
+	cases.push_back({ "1280x720 Verfolgung", Size(1280, 720), 16, tracking, true });
+	cases.push_back({ "1280x720 verkleinert", Size(1280, 720), 16, scaled, false });
+	cases.push_back({ "1920x1080 Standard", Size(1920, 1080), 9, standard, true });
+	cases.push_back({ "3840x2160 Kacheln", Size(3840, 2160), 16, tiled, true });
+
+	vector<int> threadCounts = { 1 };
+
+	if (getNumThreads() > 1) {
+
+		threadCounts.push_back(getNumThreads());
+	}
+
+	bool failed = false;
+
+	for (const AllocationCase& allocationCase : cases) {
+
+		for (int threads : threadCounts) {
+
+			AllocationCount count;
+
+			setNumThreads(threads);
+			bool counted = countAllocations(allocationCase, frames, warmupFrames, count);
+			setNumThreads(-1);
+
+			if (!counted) {
+
+				return 1;
+			}
+
+			bool strict = allocationCase.strict && threads == 1;
+
+			cerr << "allocation " << allocationCase.name << ", " << threads << " Threads: " << count.total
+				<< " Allokationen in " << count.framesWithAllocations << "/" << frames << " Bildern, max "
+				<< count.maxPerFrame << " pro Bild" << (count.total == 0 ? "" : strict ? " FEHLER" : " (nur Hinweis)")
+				<< endl;
+
+			failed = failed || (strict && count.total > 0);
+		}
+	}
+
+	return failed ? 1 : 0;
+}
+
+
+/* jsonString()-Funktion: Text als JSON-String mit Anführungszeichen. Pfade wie "dir:C:\\Bilder" enthalten z.B.
+   Backslashes, die sonst ungültiges JSON ergeben
+		- @param text: Beliebiger Text
+		- @param return: Text in Anführungszeichen, mit \\, \" und Steuerzeichen als Escape-Sequenz*/
+string jsonString(const string& text) {
+
+	string escaped = "\"";
+
+	for (char character : text) {
+
+		switch (character) {
+
+		case '"':
+			escaped += "\\\"";
+			break;
+
+		case '\\':
+			escaped += "\\\\";
+			break;
+
+		case '\n':
+			escaped += "\\n";
+			break;
+
+		case '\r':
+			escaped += "\\r";
+			break;
+
+		case '\t':
+			escaped += "\\t";
+			break;
+
+		default:
+			if ((unsigned char)character < 0x20) {
+
+				char code[8];
+				snprintf(code, sizeof(code), "\\u%04x", (unsigned char)character);
+				escaped += code;
+			}
+			else {
+
+				escaped += character;
+			}
+		}
+	}
+
+	return escaped + "\"";
+}
+
+
+/* writeLatency()-Funktion: Schreibt die Perzentile einer Stufe als JSON-Objekt*/
+void writeLatency(ostream& out, const char* name, const StageLatency& latency) {
+
+	out << "\"" << name << "\": { \"p50_us\": " << latency.p50 << ", \"p95_us\": " << latency.p95 << ", \"p99_us\": "
+		<< latency.p99 << ", \"max_us\": " << latency.max << " }";
+}
+
+
+/* writeJson()-Funktion: Schreibt alle Ergebnisse als JSON
+		- @param out: Ausgabestrom
+		- @param cases: Die ausgeführten Fälle
+		- @param results: Die Ergebnisse in derselben Reihenfolge
+		- @param validations: Vergleiche der Kandidatensuchen
+		- @param frames: Gemessene Bilder pro Thread
+		- @param warmupFrames: Verworfene Bilder pro Thread*/
+void writeJson(ostream& out, const vector<BenchmarkCase>& cases, const vector<BenchmarkResult>& results,
+	const vector<ValidationResult>& validations, int frames, int warmupFrames) {
+
+	const char* stageNames[STAGE_COUNT] = { "capture_wait", "decode", "detect_markers", "estimate_pose", "render",
+		"capture_to_publish" };
+
+	out << "{\n";
+	out << "  \"opencv_version\": \"" << CV_VERSION << "\",\n";
+	out << "  \"frames_per_thread\": " << frames << ",\n";
+	out << "  \"warmup_frames_per_thread\": " << warmupFrames << ",\n";
+	out << "  \"allocation_counter\": \"" << allocationCounter << "\",\n";
+	out << "  \"validation\": [\n";
+
+	for (size_t i = 0; i < validations.size(); ++i) {
+
+		const ValidationResult& validation = validations[i];
+
+		out << "    { \"comparison\": " << jsonString(validation.comparison) << ", \"source\": "
+			<< jsonString(validation.sourceUri) << ", \"frames\": " << validation.frames
+			<< ", \"frames_with_same_ids\": " << validation.framesWithSameIds << ", \"missing_markers\": "
+			<< validation.missingMarkers << ", \"extra_markers\": " << validation.extraMarkers
+			<< ", \"mean_corner_error_px\": " << validation.meanCornerError << ", \"max_corner_error_px\": "
+			<< validation.maxCornerError << ", \"corner_tolerance_px\": " << validation.cornerTolerance
+			<< ", \"passed\": " << (validation.passed ? "true" : "false") << " }"
+			<< (i + 1 < validations.size() ? "," : "") << "\n";
+	}
+
+	out << "  ],\n";
+	out << "  \"cases\": [\n";
+
+	for (size_t i = 0; i < cases.size(); ++i) {
+
+		const BenchmarkCase& benchmarkCase = cases[i];
+		const BenchmarkResult& result = results[i];
+
+		out << "    {\n";
+		out << "      \"group\": " << jsonString(benchmarkCase.group) << ",\n";
+		out << "      \"source\": " << jsonString(benchmarkCase.sourceUri) << ",\n";
+		out << "      \"width\": " << benchmarkCase.resolution.width << ",\n";
+		out << "      \"height\": " << benchmarkCase.resolution.height << ",\n";
+		out << "      \"markers\": " << benchmarkCase.markerCount << ",\n";
+		out << "      \"marker_size_px\": " << benchmarkCase.markerSize << ",\n";
+		out << "      \"threads\": " << benchmarkCase.threads << ",\n";
+		out << "      \"candidate_search\": \"" <<
+			(benchmarkCase.candidateSearch == CANDIDATE_SEARCH_ARUCO ? "aruco" : "fast") << "\",\n";
+		out << "      \"frames\": " << result.frames << ",\n";
+		out << "      \"seconds\": " << result.seconds << ",\n";
+		out << "      \"frames_per_second\": " << result.framesPerSecond << ",\n";
+		out << "      \"allocations_per_frame\": " << result.allocationsPerFrame << ",\n";
+		out << "      \"detection_hit_rate\": " << result.detectionHitRate << ",\n";
+		out << "      \"skipped_frame_rate\": " << result.skippedFrameRate << ",\n";
+		out << "      \"capture_format\": \"" <<
+			(benchmarkCase.captureFormat == CAPTURE_FORMAT_LUMINANCE ? "luminance" : "bgr") << "\",\n";
+		out << "      \"ingested_bytes_per_frame\": " << result.ingestedBytesPerFrame << ",\n";
+		out << "      \"tile_marker_size_px\": " << benchmarkCase.tileMarkerSize << ",\n";
+		out << "      \"opencv_threads\": " << benchmarkCase.openCvThreads << ",\n";
+		out << "      \"stages\": {\n";
+
+		for (int s = 0; s < STAGE_COUNT; ++s) {
+
+			out << "        ";
+			writeLatency(out, stageNames[s], result.stages[s]);
+			out << (s + 1 < STAGE_COUNT ? ",\n" : "\n");
+		}
+
+		out << "      }\n";
+		out << "    }" << (i + 1 < cases.size() ? "," : "") << "\n";
+	}
+
+	out << "  ]\n";
+	out << "}\n";
+}
+
+
+/* printValidation()-Funktion: Gibt das Ergebnis eines Vergleichs auf der Konsole aus
+		- @param validation: Ergebnis des Vergleichs*/
+void printValidation(const ValidationResult& validation) {
+
+	cerr << "validation " << validation.comparison << " " << validation.sourceUri << ": "
+		<< validation.framesWithSameIds << "/" << validation.frames << " Bilder mit gleichen IDs, "
+		<< validation.missingMarkers << " fehlende und " << validation.extraMarkers << " zusätzliche Marker, "
+		<< "Eckenabweichung max " << validation.maxCornerError << " px (Toleranz " << validation.cornerTolerance
+		<< " px): " << (validation.passed ? "bestanden" : "FEHLGESCHLAGEN") << endl;
+}
+
+
+int main(int argv, char** argc) {
+
+	int frames = 300;
+	bool framesGiven = false;
+	int warmupFrames = 30;
+	int maxThreads = min(8, max(1, (int)thread::hardware_concurrency()));
+	string sourceUri;
+	string outputFileName = "benchmark.json";
+	double poseBusTestSeconds = 0.0;
+	int allocationTestFrames = 0;
+	double cornerTolerance = 1.0;
+	string validateUri;
+
+	for (int i = 1; i + 1 < argv; i += 2) {
+
+		string argument = argc[i];
+		string value = argc[i + 1];
+
+		if (argument == "--frames") {
+
+			frames = max(1, atoi(value.c_str()));
+			framesGiven = true;
+		}
+		else if (argument == "--warmup") {
+
+			warmupFrames = max(0, atoi(value.c_str()));
+		}
+		else if (argument == "--max-threads") {
+
+			maxThreads = max(1, atoi(value.c_str()));
+		}
+		else if (argument == "--source") {
+
+			sourceUri = value;
+		}
+		else if (argument == "--output") {
+
+			outputFileName = value;
+		}
+		else if (argument == "--corner-tolerance") {
+
+			cornerTolerance = max(0.0, atof(value.c_str()));
+		}
+		else if (argument == "--validate") {
+
+			validateUri = value;
+		}
+		else if (argument == "--pose-bus-test") {
+
+			poseBusTestSeconds = max(0.1, atof(value.c_str()));
+		}
+		else if (argument == "--allocation-test") {
+
+			allocationTestFrames = max(1, atoi(value.c_str()));
+		}
+		else {
+
+			cerr << "Unbekannte Option: " << argument << endl;
+			return 1;
+		}
+	}
+
+	if (poseBusTestSeconds > 0.0) {
+
+		return runPoseBusTest(poseBusTestSeconds);
+	}
+
+	if (allocationTestFrames > 0) {
+
+		return runAllocationTest(allocationTestFrames, warmupFrames);
+	}
+
+	if (!validateUri.empty()) {
+
+		// Ohne --frames werden alle Bilder der Aufnahme verglichen
+		const int validateFrames = framesGiven ? frames : INT_MAX;
+		ValidationResult validation = validateCandidateSearch(validateUri, validateFrames, cornerTolerance);
+		printValidation(validation);
+
+		return validation.passed ? 0 : 1;
+	}
+
+	vector<BenchmarkCase> cases = buildCases(sourceUri, maxThreads);
+	vector<BenchmarkResult> results;
+	vector<ValidationResult> validations;
+
+	// Die Kandidatensuche wird auf jeder Quelle der Auflösungsfälle bzw. auf der aufgenommenen Quelle verglichen
+	for (const BenchmarkCase& benchmarkCase : cases) {
+
+		if ((benchmarkCase.group == "resolution" || !sourceUri.empty()) &&
+			benchmarkCase.candidateSearch == CANDIDATE_SEARCH_FAST && benchmarkCase.threads == 1) {
+
+			validations.push_back(validateCandidateSearch(benchmarkCase.sourceUri, frames, cornerTolerance));
+		}
+
+		// Die Kacheln einmal pro Quelle gegen das ganze Bild, eine Abweichung lässt den Benchmark fehlschlagen
+		if (benchmarkCase.group == "tiles" && benchmarkCase.tileMarkerSize > 0 && benchmarkCase.openCvThreads == 1) {
+
+			validations.push_back(validateTiles(benchmarkCase.sourceUri, benchmarkCase.tileMarkerSize,
+				benchmarkCase.candidateSearch, frames, cornerTolerance));
+		}
+	}
+
+	bool validationFailed = false;
+
+	for (const ValidationResult& validation : validations) {
+
+		printValidation(validation);
+		validationFailed = validationFailed || !validation.passed;
+	}
+
+	for (const BenchmarkCase& benchmarkCase : cases) {
+
+		BenchmarkResult result = runCase(benchmarkCase, frames, warmupFrames);
+		results.push_back(result);
+
+		cerr << benchmarkCase.group << " " << benchmarkCase.sourceUri << " threads=" << benchmarkCase.threads
+			<< (benchmarkCase.candidateSearch == CANDIDATE_SEARCH_ARUCO ? " aruco" : " fast")
+			<< (benchmarkCase.captureFormat == CAPTURE_FORMAT_LUMINANCE ? " luminance" : " bgr")
+			<< (benchmarkCase.tileMarkerSize > 0 ? " tiles" : "") << " opencv_threads=" << benchmarkCase.openCvThreads
+			<< ": "
+			<< result.framesPerSecond << " fps, " << result.allocationsPerFrame << " Allokationen/Bild, "
+			<< result.ingestedBytesPerFrame / 1024.0 << " KiB/Bild Aufnahme" << endl;
+	}
+
+	ofstream outStream(outputFileName);
+
+	if (!outStream) {
+
+		cerr << "Datei konnte nicht geschrieben werden: " << outputFileName << endl;
+		return 1;
+	}
+
+	writeJson(outStream, cases, results, validations, frames, warmupFrames);
+
+	return validationFailed ? 1 : 0;
+}
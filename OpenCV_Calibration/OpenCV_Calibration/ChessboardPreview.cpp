@@ -0,0 +1,144 @@
+#include "ChessboardPreview.h"
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+ChessboardPreview::ChessboardPreview(const Size& boardSize, int maxPreviewWidth)
+	: boardSize(boardSize), maxPreviewWidth(maxPreviewWidth), hasPending(false), busy(false), pendingScale(1.0),
+	  resultFound(false), running(false) {
+}
+
+
+ChessboardPreview::~ChessboardPreview() {
+
+	stop();
+}
+
+
+/* start()-Funktion: Startet den Such-Thread*/
+void ChessboardPreview::start() {
+
+	if (running.load()) {
+
+		return;
+	}
+
+	running.store(true);
+	searchThread = thread(&ChessboardPreview::searchLoop, this);
+}
+
+
+/* stop()-Funktion: Beendet den Such-Thread und wartet auf die laufende Suche*/
+void ChessboardPreview::stop() {
+
+	{
+		lock_guard<mutex> lock(pendingMutex);
+		running.store(false);
+	}
+
+	pendingCondition.notify_one();
+
+	if (searchThread.joinable()) {
+
+		searchThread.join();
+	}
+}
+
+
+void ChessboardPreview::submit(const Mat& frame) {
+
+	{
+		lock_guard<mutex> lock(pendingMutex);
+
+		// Der Thread sucht noch im letzten Bild oder hat es noch nicht abgeholt
+		if (busy || hasPending || !running.load(memory_order_relaxed)) {
+
+			return;
+		}
+
+		pendingScale = frame.cols > maxPreviewWidth ? (double)maxPreviewWidth / frame.cols : 1.0;
+
+		Mat previewFrame;
+
+		if (pendingScale < 1.0) {
+
+			resize(frame, previewFrame, Size(), pendingScale, pendingScale, INTER_AREA);
+		}
+		else {
+
+			previewFrame = frame;
+		}
+
+		if (previewFrame.channels() == 1) {
+
+			previewFrame.copyTo(pendingFrame);
+		}
+		else {
+
+			cvtColor(previewFrame, pendingFrame, COLOR_BGR2GRAY);
+		}
+
+		hasPending = true;
+	}
+
+	pendingCondition.notify_one();
+}
+
+
+bool ChessboardPreview::latestResult(vector<Point2f>& corners) {
+
+	lock_guard<mutex> lock(resultMutex);
+
+	corners = resultCorners;
+	return resultFound;
+}
+
+
+/* searchLoop()-Funktion: Schleife des Such-Threads. Sucht das Chessboard im zuletzt übergebenen Bild und rechnet die
+   Ecken in Koordinaten des aufgenommenen Bildes um*/
+void ChessboardPreview::searchLoop() {
+
+	Mat searchFrame;
+	double searchScale = 1.0;
+	vector<Point2f> corners;
+
+	while (true) {
+
+		{
+			unique_lock<mutex> lock(pendingMutex);
+			busy = false;
+			pendingCondition.wait(lock, [this] { return hasPending || !running.load(); });
+
+			if (!running.load()) {
+
+				break;
+			}
+
+			swap(searchFrame, pendingFrame);
+			searchScale = pendingScale;
+			hasPending = false;
+			busy = true;
+		}
+
+		/*findChessboardCorners()-Funktion: Findet die Positionen der inneren Ecken des Chessboards
+			- @param CALIB_CB_FAST_CHECK: Schnelle Vorprüfung, ob überhaupt ein Chessboard im Bild ist. Ohne Chessboard
+										  dauert die volle Suche sonst oft mehrere hundert Millisekunden*/
+		bool found = findChessboardCorners(searchFrame, boardSize, corners,
+			CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE | CALIB_CB_FAST_CHECK);
+
+		// Pixelmitten des verkleinerten Bildes auf das aufgenommene Bild abbilden
+		for (size_t i = 0; i < corners.size(); ++i) {
+
+			corners[i].x = (float)((corners[i].x + 0.5) / searchScale - 0.5);
+			corners[i].y = (float)((corners[i].y + 0.5) / searchScale - 0.5);
+		}
+
+		lock_guard<mutex> lock(resultMutex);
+		resultFound = found;
+		swap(resultCorners, corners);
+	}
+}
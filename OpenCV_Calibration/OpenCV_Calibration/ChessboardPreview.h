@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <opencv2/core.hpp>
+
+/* ChessboardPreview-Klasse: Sucht das Chessboard für die Live-Vorschau in einem eigenen Thread, damit Aufnahme und
+   Anzeige nie auf findChessboardCorners() warten müssen. Gesucht wird in einem verkleinerten Graubild und mit
+   CALIB_CB_FAST_CHECK, so dass Bilder ohne Chessboard schnell verworfen werden. Ist der Thread noch beschäftigt, wird
+   ein neues Bild ohne Kosten übersprungen. Das Ergebnis ist nur für die Anzeige gedacht, für eine Aufnahme wird in
+   voller Auflösung erneut gesucht*/
+class ChessboardPreview {
+
+public:
+
+	/* ChessboardPreview()-Konstruktor
+			- @param boardSize: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+			- @param maxPreviewWidth: Breite, auf die größere Bilder vor der Suche verkleinert werden*/
+	ChessboardPreview(const cv::Size& boardSize, int maxPreviewWidth = 640);
+	~ChessboardPreview();
+
+	void start();
+	void stop();
+
+	/* submit()-Funktion: Übergibt ein Bild, falls der Thread gerade nichts zu tun hat. Nur dann wird es verkleinert
+			- @param frame: Aufgenommenes Bild (wird nicht verändert)*/
+	void submit(const cv::Mat& frame);
+
+	/* latestResult()-Funktion: Das zuletzt fertige Ergebnis
+			- @param corners: Gefundene Ecken in Koordinaten des aufgenommenen Bildes
+			- @param return: True, wenn im zuletzt untersuchten Bild das Chessboard gefunden wurde*/
+	bool latestResult(std::vector<cv::Point2f>& corners);
+
+private:
+
+	void searchLoop();
+
+	cv::Size boardSize;
+	int maxPreviewWidth;
+
+	// Verkleinertes Bild für den Thread und sein Skalierungsfaktor, geschützt durch pendingMutex
+	std::mutex pendingMutex;
+	std::condition_variable pendingCondition;
+	bool hasPending;
+	bool busy;
+	cv::Mat pendingFrame;
+	double pendingScale;
+
+	// Letztes Ergebnis, geschützt durch resultMutex
+	std::mutex resultMutex;
+	bool resultFound;
+	std::vector<cv::Point2f> resultCorners;
+
+	std::thread searchThread;
+	std::atomic<bool> running;
+};
@@ -0,0 +1,305 @@
+#include "IncrementalCalibrator.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/calib3d.hpp>
+
+using namespace std;
+using namespace cv;
+
+// Konvergenz: So viele Aufnahmen in Folge dürfen fx, fy, cx, cy höchstens um maxStableChange (relativ zu fx) verändern
+const int requiredStableUpdates = 3;
+const double maxStableChange = 0.002;
+
+// Konvergenz: Größte erlaubte Standardabweichung von Brennweite und Hauptpunkt relativ zur Brennweite
+const double maxRelativeDeviation = 0.005;
+
+// Konvergenz: Mindestens so viel des Bildes muss mit Ecken abgedeckt sein, sonst ist die Verzeichnung am Rand unsicher
+const double minCoverage = 0.5;
+
+// Begrenzung einer Schätzung: Iterationen der ersten Schätzung und jeder weiteren (ausgehend von der letzten) sowie
+// die relative Änderung, ab der abgebrochen wird. Die Konvergenz wird über mehrere Aufnahmen geprüft, nicht innerhalb
+// einer Schätzung
+const int maxInitialIterations = 30;
+const int maxRefineIterations = 8;
+const double solveEpsilon = 1e-6;
+
+
+IncrementalCalibrator::IncrementalCalibrator(const Size& boardSize, float squareEdgeLength, const Size& imageSize)
+	: boardSize(boardSize), imageSize(imageSize), coverageCounts(coverageColumns * coverageRows, 0), pendingCoverage(0.0),
+	  stableUpdates(0), running(false) {
+
+	for (int i = 0; i < boardSize.height; ++i) {
+
+		for (int j = 0; j < boardSize.width; ++j) {
+
+			boardPoints.push_back(Point3f(j * squareEdgeLength, i * squareEdgeLength, 0.0f));
+		}
+	}
+}
+
+
+IncrementalCalibrator::~IncrementalCalibrator() {
+
+	stop();
+}
+
+
+/* start()-Funktion: Startet den Thread, der die Schätzung aktualisiert*/
+void IncrementalCalibrator::start() {
+
+	if (running.load()) {
+
+		return;
+	}
+
+	running.store(true);
+	solveThread = thread(&IncrementalCalibrator::solveLoop, this);
+}
+
+
+/* stop()-Funktion: Beendet den Thread und wartet auf eine laufende Schätzung*/
+void IncrementalCalibrator::stop() {
+
+	{
+		lock_guard<mutex> lock(pendingMutex);
+		running.store(false);
+	}
+
+	pendingCondition.notify_one();
+
+	if (solveThread.joinable()) {
+
+		solveThread.join();
+	}
+}
+
+
+bool IncrementalCalibrator::addView(const vector<Point2f>& corners) {
+
+	if (corners.size() != boardPoints.size()) {
+
+		return false;
+	}
+
+	updateCoverage(corners);
+
+	double coverage = 0.0;
+
+	{
+		lock_guard<mutex> lock(resultMutex);
+		currentStatus.views++;
+		coverage = currentStatus.coverage;
+	}
+
+	{
+		lock_guard<mutex> lock(pendingMutex);
+		pendingViews.push_back(corners);
+		pendingCoverage = coverage;
+	}
+
+	pendingCondition.notify_one();
+
+	return true;
+}
+
+
+CalibrationStatus IncrementalCalibrator::status() const {
+
+	lock_guard<mutex> lock(resultMutex);
+
+	return currentStatus;
+}
+
+
+bool IncrementalCalibrator::getCalibration(Mat& cameraMatrix, Mat& distanceCoefficients, double* reprojectionError) const {
+
+	lock_guard<mutex> lock(resultMutex);
+
+	if (!currentStatus.hasEstimate) {
+
+		return false;
+	}
+
+	this->cameraMatrix.copyTo(cameraMatrix);
+	this->distanceCoefficients.copyTo(distanceCoefficients);
+
+	if (reprojectionError) {
+
+		*reprojectionError = currentStatus.reprojectionError;
+	}
+
+	return true;
+}
+
+
+/* solveLoop()-Funktion: Schleife des Threads. Übernimmt alle seit der letzten Schätzung hinzugekommenen Aufnahmen
+   und schätzt einmal neu, sobald genug Aufnahmen vorhanden sind*/
+void IncrementalCalibrator::solveLoop() {
+
+	vector<vector<Point2f>> newViews;
+	double coverage = 0.0;
+
+	while (true) {
+
+		{
+			unique_lock<mutex> lock(pendingMutex);
+			pendingCondition.wait(lock, [this] { return !pendingViews.empty() || !running.load(); });
+
+			if (!running.load()) {
+
+				break;
+			}
+
+			swap(newViews, pendingViews);
+			coverage = pendingCoverage;
+		}
+
+		for (vector<Point2f>& view : newViews) {
+
+			objectPoints.push_back(boardPoints);
+			imagePoints.push_back(move(view));
+		}
+
+		newViews.clear();
+
+		if ((int)imagePoints.size() >= minViews) {
+
+			estimate(coverage);
+		}
+	}
+}
+
+
+/* estimate()-Funktion: Aktualisiert die Schätzung mit allen bisherigen Aufnahmen und veröffentlicht sie. Ab der
+   zweiten Schätzung wird von der letzten aus weitergerechnet und nach maxRefineIterations abgebrochen. Erst wenn sich
+   die Parameter über mehrere Schätzungen kaum verändert haben und die Abdeckung reicht, wird einmal mit Kovarianz
+   gerechnet, um die Unsicherheit der Parameter zu prüfen
+		- @param coverage: Abdeckung des Bildes mit den übernommenen Aufnahmen*/
+void IncrementalCalibrator::estimate(double coverage) {
+
+	bool hasEstimate = !solveCameraMatrix.empty();
+	Mat previousCameraMatrix = solveCameraMatrix.clone();
+	vector<Mat> rVectors, tVectors;
+
+	int flags = hasEstimate ? CALIB_USE_INTRINSIC_GUESS : 0;
+	TermCriteria criteria(TermCriteria::COUNT + TermCriteria::EPS, hasEstimate ? maxRefineIterations : maxInitialIterations,
+		solveEpsilon);
+
+	double reprojectionError = calibrateCamera(objectPoints, imagePoints, imageSize, solveCameraMatrix,
+		solveDistanceCoefficients, rVectors, tVectors, flags, criteria);
+
+	double focalLength = solveCameraMatrix.at<double>(0, 0);
+	double lastChange = 1.0;
+
+	if (hasEstimate && focalLength > 0.0) {
+
+		const Point indices[4] = { Point(0, 0), Point(1, 1), Point(2, 0), Point(2, 1) };
+
+		lastChange = 0.0;
+
+		for (const Point& index : indices) {
+
+			double change = abs(solveCameraMatrix.at<double>(index.y, index.x) -
+				previousCameraMatrix.at<double>(index.y, index.x));
+			lastChange = max(lastChange, change / focalLength);
+		}
+	}
+
+	stableUpdates = lastChange < maxStableChange ? stableUpdates + 1 : 0;
+
+	bool hasDeviations = stableUpdates >= requiredStableUpdates && coverage >= minCoverage && focalLength > 0.0;
+	double standardDeviations[9] = {};
+	double worstViewError = 0.0;
+	bool precise = false;
+
+	if (hasDeviations) {
+
+		Mat standardDeviationsIntrinsics, standardDeviationsExtrinsics, perViewErrors;
+
+		// Die Schätzung ist bereits stabil, eine Iteration genügt für die Kovarianz am Optimum
+		reprojectionError = calibrateCamera(objectPoints, imagePoints, imageSize, solveCameraMatrix,
+			solveDistanceCoefficients, rVectors, tVectors, standardDeviationsIntrinsics, standardDeviationsExtrinsics,
+			perViewErrors, CALIB_USE_INTRINSIC_GUESS, TermCriteria(TermCriteria::COUNT + TermCriteria::EPS, 1, solveEpsilon));
+
+		for (int i = 0; i < (int)perViewErrors.total(); ++i) {
+
+			worstViewError = max(worstViewError, perViewErrors.at<double>(i));
+		}
+
+		precise = true;
+
+		for (int i = 0; i < 9; ++i) {
+
+			standardDeviations[i] = i < (int)standardDeviationsIntrinsics.total() ?
+				standardDeviationsIntrinsics.at<double>(i) : 0.0;
+			precise = precise && (i >= 4 || standardDeviations[i] / focalLength < maxRelativeDeviation);
+		}
+	}
+
+	lock_guard<mutex> lock(resultMutex);
+
+	solveCameraMatrix.copyTo(cameraMatrix);
+	solveDistanceCoefficients.copyTo(distanceCoefficients);
+
+	currentStatus.estimatedViews = (int)imagePoints.size();
+	currentStatus.hasEstimate = true;
+	currentStatus.estimates++;
+	currentStatus.reprojectionError = reprojectionError;
+	currentStatus.worstViewError = worstViewError;
+	currentStatus.hasDeviations = hasDeviations;
+	copy(standardDeviations, standardDeviations + 9, currentStatus.standardDeviations);
+	currentStatus.lastChange = lastChange;
+	currentStatus.converged = hasDeviations && precise;
+}
+
+
+/* updateCoverage()-Funktion: Zählt die Ecken der neuen Aufnahme in den Zellen des Bildes*/
+void IncrementalCalibrator::updateCoverage(const vector<Point2f>& corners) {
+
+	for (size_t i = 0; i < corners.size(); ++i) {
+
+		int column = min(max((int)(corners[i].x * coverageColumns / imageSize.width), 0), coverageColumns - 1);
+		int row = min(max((int)(corners[i].y * coverageRows / imageSize.height), 0), coverageRows - 1);
+
+		coverageCounts[row * coverageColumns + column]++;
+	}
+
+	int coveredCells = (int)count_if(coverageCounts.begin(), coverageCounts.end(), [](int count) { return count > 0; });
+
+	lock_guard<mutex> lock(resultMutex);
+	currentStatus.coverage = (double)coveredCells / coverageCounts.size();
+}
+
+
+void IncrementalCalibrator::drawCoverage(Mat& frame) const {
+
+	if (frame.size() != imageSize || frame.type() != CV_8UC3) {
+
+		return;
+	}
+
+	for (int row = 0; row < coverageRows; ++row) {
+
+		for (int column = 0; column < coverageColumns; ++column) {
+
+			int count = coverageCounts[row * coverageColumns + column];
+
+			if (count == 0) {
+
+				continue;
+			}
+
+			Rect cell(column * imageSize.width / coverageColumns, row * imageSize.height / coverageRows,
+				imageSize.width / coverageColumns, imageSize.height / coverageRows);
+
+			// Je mehr Ecken, desto grüner (ab etwa zwei vollen Chessboards in der Zelle gesättigt)
+			double intensity = min(1.0, count / (2.0 * boardPoints.size()));
+			Mat region = frame(cell);
+
+			add(region, Scalar(0, 40 + 60 * intensity, 0), region);
+			rectangle(frame, cell, Scalar(0, 255, 0), 1);
+		}
+	}
+}
@@ -0,0 +1,123 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <opencv2/core.hpp>
+
+/* CalibrationStatus-Struktur: Stand der Kalibrierung nach der letzten Aufnahme*/
+struct CalibrationStatus {
+
+	// Anzahl der Aufnahmen, davon in der letzten Schätzung enthalten, und ob schon eine Schätzung vorliegt
+	int views = 0;
+	int estimatedViews = 0;
+	bool hasEstimate = false;
+
+	// Anzahl der fertigen Schätzungen, ändert sich mit jedem neuen Ergebnis des Threads
+	int estimates = 0;
+
+	// RMS des Rückprojektionsfehlers über alle Aufnahmen und der größte Fehler einer einzelnen Aufnahme (Pixel, der
+	// größte Fehler nur zusammen mit standardDeviations)
+	double reprojectionError = 0.0;
+	double worstViewError = 0.0;
+
+	// Standardabweichung der Parameter (fx, fy, cx, cy in Pixeln, k1, k2, p1, p2, k3 ohne Einheit). Sie wird nur
+	// berechnet, wenn die Schätzung stabil ist und die Abdeckung reicht (hasDeviations), sonst 0
+	bool hasDeviations = false;
+	double standardDeviations[9] = {};
+
+	// Größte relative Änderung von fx, fy, cx, cy durch die letzte Aufnahme
+	double lastChange = 0.0;
+
+	// Anteil der Zellen des Bildes, in denen schon Ecken gefunden wurden (0 bis 1)
+	double coverage = 0.0;
+
+	// Parameter haben sich über mehrere Aufnahmen kaum noch verändert und sind genau genug bestimmt
+	bool converged = false;
+};
+
+/* IncrementalCalibrator-Klasse: Kalibriert mit jeder neuen Aufnahme neu und startet dabei von der letzten Schätzung
+   (CALIB_USE_INTRINSIC_GUESS). Gerechnet wird wie bei ChessboardPreview in einem eigenen Thread, Aufnahme und Anzeige
+   laufen mit der Bildrate der Kamera weiter. Aufnahmen, die während einer Schätzung hinzukommen, werden gesammelt und
+   gemeinsam in die nächste übernommen. Jede Schätzung ist auf wenige Iterationen begrenzt, die Unsicherheit der
+   Parameter wird erst berechnet, wenn sich die Schätzung kaum noch verändert. Sobald die Parameter konvergiert sind,
+   kann die Aufnahme beendet werden*/
+class IncrementalCalibrator {
+
+public:
+
+	// Mindestanzahl an Aufnahmen für die erste Schätzung
+	static const int minViews = 4;
+
+	// Aufteilung des Bildes für die Abdeckung (Spalten x Zeilen)
+	static const int coverageColumns = 8;
+	static const int coverageRows = 6;
+
+	/* IncrementalCalibrator()-Konstruktor
+			- @param boardSize: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+			- @param squareEdgeLength: Länge eines Quadrates auf dem Chessboard
+			- @param imageSize: Größe der Bilder, auf denen die Ecken gefunden werden*/
+	IncrementalCalibrator(const cv::Size& boardSize, float squareEdgeLength, const cv::Size& imageSize);
+	~IncrementalCalibrator();
+
+	void start();
+	void stop();
+
+	/* addView()-Funktion: Fügt eine Aufnahme hinzu. Abdeckung und Anzahl der Aufnahmen sind sofort aktuell, die
+	   Schätzung wird im Thread aktualisiert und erscheint in status(), sobald sie fertig ist
+			- @param corners: Gefundene und verfeinerte Innenecken
+			- @param return: False, wenn die Anzahl der Ecken nicht zum Chessboard passt*/
+	bool addView(const std::vector<cv::Point2f>& corners);
+
+	/* status()-Funktion: Kopie des aktuellen Stands (die Schätzung kann während des Aufrufs im Thread weiterlaufen)*/
+	CalibrationStatus status() const;
+
+	/* getCalibration()-Funktion: Aktuelle Schätzung
+			- @param cameraMatrix: 3x3-Kameramatrix
+			- @param distanceCoefficients: Abstandskoeffizienten
+			- @param reprojectionError: Optional, RMS derselben Schätzung
+			- @param return: False, wenn es noch keine Schätzung gibt*/
+	bool getCalibration(cv::Mat& cameraMatrix, cv::Mat& distanceCoefficients, double* reprojectionError = nullptr) const;
+
+	/* drawCoverage()-Funktion: Färbt die Zellen des Bildes grün ein, je mehr Ecken dort schon gefunden wurden. Zellen
+	   ohne Ecken bleiben unverändert und zeigen, wohin das Chessboard noch gehalten werden sollte
+			- @param frame: Bild, auf das gezeichnet wird (BGR, Größe wie imageSize)*/
+	void drawCoverage(cv::Mat& frame) const;
+
+private:
+
+	void solveLoop();
+	void estimate(double coverage);
+	void updateCoverage(const std::vector<cv::Point2f>& corners);
+
+	cv::Size boardSize;
+	cv::Size imageSize;
+
+	std::vector<cv::Point3f> boardPoints;
+
+	// Anzahl der Ecken pro Zelle (zeilenweise), nur im aufrufenden Thread verwendet
+	std::vector<int> coverageCounts;
+
+	// Neue Aufnahmen für den Thread und die Abdeckung mit ihnen, geschützt durch pendingMutex
+	std::mutex pendingMutex;
+	std::condition_variable pendingCondition;
+	std::vector<std::vector<cv::Point2f>> pendingViews;
+	double pendingCoverage;
+
+	// Nur im Thread: alle Aufnahmen, die laufende Schätzung und die Anzahl der Schätzungen in Folge, nach denen sich
+	// die Parameter kaum verändert haben
+	std::vector<std::vector<cv::Point3f>> objectPoints;
+	std::vector<std::vector<cv::Point2f>> imagePoints;
+	cv::Mat solveCameraMatrix, solveDistanceCoefficients;
+	int stableUpdates;
+
+	// Letzte fertige Schätzung und Stand, geschützt durch resultMutex
+	mutable std::mutex resultMutex;
+	cv::Mat cameraMatrix, distanceCoefficients;
+	CalibrationStatus currentStatus;
+
+	std::thread solveThread;
+	std::atomic<bool> running;
+};
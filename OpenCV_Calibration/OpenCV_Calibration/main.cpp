@@ -1,535 +1,731 @@
-#include <opencv2/core.hpp>
-#include <opencv2/aruco.hpp>
-#include <opencv2/opencv.hpp>
-#include <opencv2/imgcodecs.hpp>
-#include <opencv2/ximgproc.hpp>
-#include <opencv2/highgui.hpp>
-#include <opencv2/calib3d.hpp>
-
-#include <sstream>
-#include <iostream>
-#include <fstream>
-
-using namespace std;
-using namespace cv;
-
-// Lnge eines Quadrats des Chessboards in Metern
-const float calibrationSquareDimension = 0.0245f;
-
-// Lnge des ausgedruckten ArUco-Markers (hier: DICT_4X4_50) in Metern
-const float arucoSquareDimension = 0.132f;
-
-// Dimensionen des Chessboards (hier: 9, 6 -> Kreuzungen der schwarzen und weien Quadraten (Spalten, Reihen))
-const Size chessboardDimensions = Size(9, 6);
-
-
-
-/* createArucoMarker() - Funktion: Generierung von Aruco-Markers aus einer bestimmten Lexikon*/
-void createArucoMarkers() {
-
-	//Matrix (Array) fr das Bild des Markers
-	Mat outputMarker;
-
-	/*Erstellung des Lexikons [DICT_(bits)x(bits)_(Anzahl Marker)]:
-			- DICT_4X4_50
-			- DICT_4X4_100
-			- DICT_4X4_250
-			- DICT_4X4_1000
-			- DICT_5X5_50
-			- DICT_5X5_100
-			- DICT_5X5_250
-			- DICT_5X5_1000
-			- DICT_6X6_50
-			- DICT_6X6_100
-			- DICT_6X6_250
-			- DICT_6X6_1000
-			- DICT_7X7_50
-			- DICT_7X7_100
-			- DICT_7X7_250
-			- DICT_7X7_1000
-		 */
-	Ptr<aruco::Dictionary> markerDictionary = aruco::getPredefinedDictionary(aruco::PREDEFINED_DICTIONARY_NAME::DICT_4X4_50);
-
-
-	for (int i = 0; i < 50; ++i) {
-
-		/* darwMarker()-Funktion: Marker die in outputMarker gespeichert werden
-			 - @param markerDictionary: Zuvor angelegte Dictionary-Objekt, welches bergeben wird
-			 - @param i:  Marker-ID
-			 - @param 500: ist die Gre des Ausgabemarkierungsbildes, in diesem Fall wird das Ausgabebild eine Gre von 500x500 Pixel haben.
-			   Der Parameter sollte gro genug gewhlt werden, um die Anzahl der Bits fr das spezifische Lexikon zu speichern
-			 - @param outputMarker: n-dimensionales Array in dem die Marker gespeichert werden
-			 - @param 1: Optionaler Parameter zur Angabe der Breite des schwarzen Rands der Markierung.
-			   Die Gre wird proportional zur Anzahl der Bits angegeben. Zum Beispiel bedeutet ein Wert von 2, dass der Rand 
-			   eine Breite hat, die der Gre von zwei internen Bits entspricht. Der Standardwert ist 1*/
-		aruco::drawMarker(markerDictionary, i, 500, outputMarker, 1);
-		
-		//Ausgabe der Marker als .jpg Datei
-		ostringstream convert;
-		string imageName = "4x4Marker_";
-		convert << imageName << i << ".jpg";
-
-		/* imwrite()-Funktion: Speichert das Bild in eine spezifische Datei
-			 - @param convert.str(): Name der Datei
-			 - @param outputMarker:  Marker die gespeichert werden sollen*/
-		imwrite(convert.str(), outputMarker);
-	}
-}
-
-
-
-/* createKnownBoardPositions()-Funktion: Erstellung der Eckpositionen auf dem Chessboard
-	- @param boardSize: Gre des Chessboards (hier: 9, 6)
-	- @param squareEdgeLength: Lnge eines Quadrates auf dem Chessboard
-	- @param corners: Vektor in dem die bestimmten Eckpositionen gespeichert werden (hier: Z = 0, da flache Flche)*/
-void createKnownBoardPositions(Size boardSize, float squareEdgeLength, vector<Point3f>& corners) {
-
-	for (int i = 0; i < boardSize.height; ++i) {
-
-		for (int j = 0; j < boardSize.width; ++j) {
-
-			corners.push_back(Point3f(j * squareEdgeLength, i * squareEdgeLength, 0.0f));
-		}
-	}
-}
-
-
-
-// Methode ber individuell, gespeicherte Bilder
-/* getChessboardCorners()-Funktion: Finde und visualiesiere die gefundenen Eckpositionen (Kreuzungspositionen)
-	- @param images: Reihe von Bildern die bergeben werden sollen, um die Eckpositionen zu bestimmen
-	- @param allFoundCorners: Alle gefundenen Ecken, die ausgegeben werden sollen
-	- @param showResults: Zeige die Ergebnisse der gefundenen Ecken*/
-void getChessboardCorners(vector<Mat> images, vector<vector<Point2f>>& allFoundCorners, bool showResults = false) {
-
-	for (vector<Mat>::iterator iter = images.begin(); iter != images.end(); ++iter) {
-
-		// Buffer der alle Punkte enthlt, die im Bild (images) gefunden worden sind
-		vector<Point2f> pointBuf;
-
-		/*findChessboardCorners()-Funktion: Findet die Positionen der inneren Ecken des Chessboards
-			- @param *iter: Bild das untersucht werden soll
-			- @param Size(9, 6): Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
-			- @param pointBuf: Ausgabearray der erkannten Ecken
-			- @param CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE: Verschiedenen Operationsflags
-			- @output: true oder false, ob die Innenekcen gefunden werden konnten*/
-		bool found = findChessboardCorners(*iter, Size(9, 6), pointBuf, 
-			CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE);
-
-		if (found) {
-
-			allFoundCorners.push_back(pointBuf);
-		}
-
-		if (showResults) {
-
-			/* drawChessboardCorners()-Funktion: Rendert die erkannten Chessboard-Ecken
-				- @param *iter: Zielbild, auf dem die Ecken gerendert werden sollen
-				- @param Size(9, 6): Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
-				- @param pointBuf: Array der erkannten Ecken (Ausgabe von s. findChessboardCorners())
-				- @param found: Parameter, der angibt, ob das komplette Board gefunden wurde oder nicht*/
-			drawChessboardCorners(*iter, Size(9, 6), pointBuf, found);
-
-			/* imshow()-Funktion: Stellt ein Bild in einem spezifischen Fenster dar
-				- @param "Looking for Corners": Stellt den Fensternamen dar
-				- @param *iter: Darzustellende Bild
-				Auf dieser Funktion sollte immer die waitKey()-Funktion folgen, weil sonst das Fenster nicht dargestellt wird*/
-			imshow("Looking for Corners", *iter);
-			
-			/* waitKey()-Funktion: Wartet so lange bis eine Taste gedrckt wird oder eine bestimmte Zeit vergangen ist
-				 - @param 0: Gibt den Delay in Millisekunden an (0 meint fr immer)*/
-			waitKey(0);
-		}
-
-	}
-}
-
-
-
-
-/* cameraCalibration()-Funktion: Durchfhrung der Kamerakalibireung (Erstellung der 3x3-Kameramatrix und Abstandskoeffizienten)
-	- @param calibrationImages: Es werden Bilder fr eine Kalibrieung bergeben, die bereits als gltig erkannt worden sind
-	- @param boardSize: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
-	- @param squareEdgeLength: Lnge eines Quadrates auf dem Chessboard
-	- @param cameraMatrix: 3x3-Kameramatrix, die bergeben wird, um die Werte der Kalibireung zu speichern
-	- @param distanceCoefficients: Abstandskoeffizienten, die ebenfalls bergebn werden, um sie zu bestimmen*/
-void cameraCalibration(vector<Mat> calibrationImages, Size boardSize, float squareEdgeLength, 
-	Mat& cameraMatrix, Mat& distanceCoefficients) {
-
-	// Punkte der Ecken, die wir auf den Bildern erkennen
-	vector<vector<Point2f>> checkerboardImageSpacePoints;
-
-	/* getChessboardCorners()-Funktion: Finde und visualiesiere die gefundenen Eckpositionen (Kreuzungspositionen)
-	- @param calibrationImages: Reihe von Bildern die bergeben werden sollen, um die Eckpositionen zu bestimmen
-	- @param checkerboardImageSpacePoints: Alle gefundenen Ecken, die ausgegeben werden sollen
-	- @param false: Zeige die Ergebnisse der gefundenen Ecken*/
-	getChessboardCorners(calibrationImages, checkerboardImageSpacePoints, false);
-
-	//Bekannte Board-Positionen mit der Gre 1
-	vector<vector<Point3f>> worldSpaceCornerPoints(1);
-
-	/* createKnownBoardPositions()-Funktion: Erstellung der Eckpositionen auf dem Chessboard
-	- @param boardSize: Gre des Chessboards (hier: 9, 6)
-	- @param squareEdgeLength: Lnge eines Quadrates auf dem Chessboard
-	- @param worldSpaceCornerPoints[0] (erstes Element): Vektor in dem die bestimmten Eckpositionen gespeichert werden*/
-	createKnownBoardPositions(boardSize, squareEdgeLength, worldSpaceCornerPoints[0]);
-	
-	worldSpaceCornerPoints.resize(checkerboardImageSpacePoints.size(), worldSpaceCornerPoints[0]);
-
-
-	vector<Mat> rVectors, tVectors;
-	distanceCoefficients = Mat::zeros(8, 1, CV_64F);
-
-	/* calibrateCamera()-Funktion: Findet die kamerainternen und -externen Parameter aus mehreren Ansichten eines Kalibriemusters
-		- @param worldSpaceCornerPoints: 
-		- @param checkerboardImageSpacePoints:
-		- @param boardSize: Gre des Bildes, das zur Initialisierung der kamerinternen Matrix verwendet wird (hier: 9, 6)
-		- @param cameraMatrix: 3x3 Kamera-Matrix (intrinsische Matrix)
-		- @param distanceCoefficients: Vektor der Abstandskoeffizienten
-		- @param rVectors: Output der Rotationsvektoren
-		- @param tVectors: Output der Translationsvektoren*/
-	calibrateCamera(worldSpaceCornerPoints, checkerboardImageSpacePoints, boardSize, cameraMatrix, 
-		distanceCoefficients, rVectors, tVectors);
-}
-
-
-/* saveCameraCalibration()-Funktion: Speicherung der Kamerakalibrierungsdaten als Datei
-		- @param name: Name der zu speichernden Datei
-		- @param cameraMatrix: Matrix der intrinsischen Kameradaten
-		- @param distanceCoefficients: Daten der Abstandskoeffizienten
-		- @param return: True oder false, ob die Speicherung erfolgen konnte oder nicht*/
-bool saveCameraCalibration(string name, Mat cameraMatrix, Mat distanceCoefficients) {
-
-	//Erstellung eines ofstream, um mit Daten arbeiten zu knnen
-	ofstream outStream(name);
-
-	if (outStream) {
-
-		// 3x3 Kameramatrix
-		uint16_t rows = cameraMatrix.rows;
-		uint16_t columns = cameraMatrix.cols;
-
-		outStream << rows << endl;
-		outStream << columns << endl;
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double value = cameraMatrix.at<double>(r, c);
-				outStream << value << endl;
-
-			}
-		}
-
-		// 5x1 Abstandskoeffizienten-Matrix
-		rows = distanceCoefficients.rows;
-		columns = distanceCoefficients.cols;
-
-		outStream << rows << endl;
-		outStream << columns << endl;
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double value = distanceCoefficients.at<double>(r, c);
-				outStream << value << endl;
-
-			}
-		}
-
-		outStream.close();
-		return true;
-	}
-
-	return false;
-}
-
-
-
-/* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei
-		- @param name: Name der zu ladenen Datei
-		- @param cameraMatrix: Kameramatrix in dem die intrinsischen daten aus der Datei gespeichert werden
-		- @param distanceCoefficients: Abstandskoeffizienten-Matrix in dem die Daten aus der Datei geladen werden
-		- @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
-bool loadCameraCalibration(string name, Mat& cameraMatrix, Mat& distanceCoefficients) {
-
-	// Erstellung eines ifstream, um Daten aus einer Datei zu lesen
-	ifstream inStream(name);
-
-	if (inStream) {
-
-		uint16_t rows;
-		uint16_t columns;
-
-		inStream >> rows;
-		inStream >> columns;
-
-		// 3x3 Kameramatrix
-		cameraMatrix = Mat(Size(columns, rows), CV_64F);
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double read = 0.0f;
-				inStream >> read;
-				cameraMatrix.at<double>(r, c) = read;
-				cout << cameraMatrix.at<double>(r, c) << "\n";
-			}
-		}
-
-		inStream >> rows;
-		inStream >> columns;
-
-		// 5x1 Abstandskoeffizienten-Matrix
-		distanceCoefficients = Mat::zeros(rows, columns, CV_64F);
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double read = 0.0f;
-				inStream >> read;
-				distanceCoefficients.at<double>(r, c) = read;
-				cout << distanceCoefficients.at<double>(r, c) << "\n";
-			}
-		}
-
-		inStream.close();
-		return true;
-	}
-
-	return false;
-}
-
-
-
-/* startWebcamMonitoring()-Funktion: Posenschtzung der ArUco-Marker
-		- @param cameraMatrix: Intrinsische Kameramatrix, die vorher erstellt werden muss
-		- @param distanceCoefficients: Abstandskoeffizienten, die vorher bestimmt werden mssen
-		- @param arucoSquareDimensions: Lnge des ArUco-Markers*/
-int startWebcamMonitoring(const Mat& cameraMatrix, const Mat& distanceCoefficients, float arucoSquareDimensions) {
-
-	Mat frame;
-
-	vector<int> markerIds;
-	vector<vector<Point2f>> markerCorners, rejectedCandidates;
-	aruco::DetectorParameters parameters;
-
-	Ptr<aruco::Dictionary> markerDictionary = aruco::getPredefinedDictionary(aruco::PREDEFINED_DICTIONARY_NAME::DICT_4X4_50);
-
-	VideoCapture vid(0);
-
-	if (!vid.isOpened()) {
-
-		return -1;
-	}
-
-	namedWindow("Webcam", WINDOW_AUTOSIZE);
-
-	vector<Vec3d> rotationVectors, translationVectors;
-	Vec3d translationToPosition;
-
-	while (true) {
-
-		if (!vid.read(frame)) {
-
-			break;
-		}
-
-		/* detectMarkers()-Funktion: Grundlegende Markererkennung
-				- @param frame: Eingabebild (Webcam)
-				- @param markerDictionary: Gibt die Art der Marker an, die durchsucht werden sollen
-				- @param markerCorners: Vektor der erkannten Marker-Ecken. Fr N erkannte Marker sind die Dimensionen des Arrays Nx4
-				- @param markerIds: Vektor der Identifikationen der erkannten Markierungen. Fr N erkannte Marker ist die Dimension
-									des Arrays N*/
-		aruco::detectMarkers(frame, markerDictionary, markerCorners, markerIds);
-
-		/* estimatePoseSingleMarkers()-Funktion: Posenschtzung fr einzelne Marker
-				- @param markerCorners: Vektor der bereits erkannten Markerecken
-				- @param arucoSquareDimension: Lnge der ArUco-Markers. Die Translationvektoren werden normalerweise in derselben
-											   Einheit ausgegeben -> Metern
-				- @param cameraMatrix: Die zuvor bestimmte intrinsische Kameramatrix
-				- @param distanceCoefficients: Vektor der zuvor bestimmten Abstandskoeffizienten
-				- @param rotationVectors: Ausgabearray von Rotationsvektoren
-				- @param translationVectors: Ausgabearray von Translationsvektoren. Jedes Element in tvecs entspricht der
-											 spezifischen Markierung in imgPoints
-		   Fr jeden Marker wird ein Translations- und ein Rotationsvektor ausgegeben.*/
-		aruco::estimatePoseSingleMarkers(markerCorners, arucoSquareDimension, cameraMatrix, distanceCoefficients, 
-			rotationVectors, translationVectors);
-
-
-		for (int i = 0; i < markerIds.size(); ++i) {
-
-			/* drawAxis()-Funktion: Zeichnet die Achsen des Koordinatensystem aus der Posenschtzung
-					- @param frame: Eingabebild (Webcam)
-					- @param cameraMatrix: Zuvor bestimmte intrinsische Kameramatrix
-					- @param distanceCoefficients: Die vorher bestimmten Abstandskoeffizienten
-					- @param rotationVectors[i]: Rotationsvektoren der Koordinatensysteme, die gezeichnet werden
-					- @param translationVectors[i]: Translationsvektoren der Koordinatensysteme, die gezeichnet werden
-					- @param 0.1f: Lnge der gemalten Achsen, in der gleichen Einheit wit tVec (Normalerweise in Metern)*/
-			aruco::drawAxis(frame, cameraMatrix, distanceCoefficients, rotationVectors[i], translationVectors[i], 0.1f);
-		}
-
-		//Position des Markers im Kamerabild (Oben links Ausgangspunkt (0, 0, 0) Einheit in Meter [m])
-		if (!translationVectors.empty()) {
-
-			cout << "x-Koordinaten: " << translationVectors[0][0] << "m" << endl;
-			cout << "y-Koordinaten: " << translationVectors[0][1] << "m" << endl;
-			cout << "z-Koordinaten: " << translationVectors[0][2] << "m" << endl;
-			cout << endl;
-		}
-			
-		imshow("Webcam", frame);
-
-		if (waitKey(30) >= 0) {
-
-			break;
-		}
-
-	}
-
-	return 1;
-}
-
-
-// Live Calibration Images Methode
-/* cameraCalibrationProcess()-Funktion: Erstellung der 3x3 Kamerakalibrierungs-Matrix und der Abstandskoeffizienten
-	- @param cameraMatrix: 3x3 Kamera-Matrix, die bergebn wird, um die Werte zu bestimmen
-	- @param distnaceCoefficients: Array in welches die distance coefficients gespeichert werden*/
-void cameraCalibrationProcess(Mat& cameraMatrix, Mat& distanceCoefficients) {
-
-	// frame beinhaltet die Videoinformationen der Webcam
-	Mat frame;
-	Mat drawToFrame;
-
-	// Array in dem eine gute Kalibrierung gespeichert wird, ber die Webcam
-	vector<Mat> savedImages;
-
-	// Gefundene Innenecken und abgelehnte Kandidaten
-	vector<vector<Point2f>> markerCorners, rejectedCandidates;
-
-	// Erstellung der Videoquelle (hier: Quelle 0)
-	VideoCapture vid(0);
-
-	// Wenn die Quelle nicht offen ist, wird returnt
-	if (!vid.isOpened()) {
-
-		return;
-	}
-
-
-	int framePerSecond = 20;
-
-	/* namedWindow()-Funktion: Erstellt ein Fenster
-		- @param "Webcam": Fenstername
-		- @param WINDOW_AUTOSIZE: Flag fr das Fenster
-			WINDOW_AUTOSIZE passt die Fenstergre automatisch an das Bild an. Die Fenstergre kann nicht manuell gendert werden*/
-	namedWindow("Webcam", WINDOW_AUTOSIZE);
-
-	while (true) {
-
-		// Wenn das Bild der Webcam (frame) nicht gelesen werden kann, wird die Schleife beendet
-		if (!vid.read(frame)) {
-			break;
-		}
-
-		vector<Vec2f> foundPoints;
-		bool found = false;
-
-		/*findChessboardCorners()-Funktion: Findet die Positionen der inneren Ecken des Chessboards
-			- @param *frame: Bild das untersucht werden soll (Webcam)
-			- @param chessboardDimensions: Konstante, globale Variable fr die Anzahl der Innenecken 
-					 pro Schachbrettreihe und -spalte (Size(columns, rows))
-			- @param foundPoints: Ausgabearray der erkannten Ecken
-			- @param CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE: Verschiedenen Operationsflags
-			- @output: true oder false, ob die Innenekcen gefunden werden konnten*/
-		found = findChessboardCorners(frame, chessboardDimensions, foundPoints,
-			CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE);
-		
-		// Kopiere das Videobild (frame), weil wir darauf zeichnen wollen
-		frame.copyTo(drawToFrame);
-
-		/* drawChessboardCorners()-Funktion: Rendert die erkannten Chessboard-Ecken
-				- @param drawToFrame: Zielbild, auf dem die Ecken gerendert werden sollen (Webcam)
-				- @param chessboardDimensions: Konstante, globale Variable fr die Anzahl der Innenecken 
-					 pro Schachbrettreihe und -spalte (Size(columns, rows))
-				- @param foundPoints: Array der erkannten Ecken (Ausgabe von s. findChessboardCorners())
-				- @param found: Parameter, der angibt, ob das komplette Board gefunden wurde oder nicht*/
-		drawChessboardCorners(drawToFrame, chessboardDimensions, foundPoints, found);
-
-		// Wenn die Ecken gefunden worden sind, dann zeige sie in einem Fenster
-		if (found) {
-
-			imshow("Webcam", drawToFrame);
-		}
-		//Ansonsten zeige das Webcam-Videobild
-		else {
-
-			imshow("Webcam", frame);
-		}
-
-		char character = waitKey(1000 / framePerSecond);
-
-		// Was whrend des Prozesses gemacht werden kann, abhngig welche Taste bettigt wird
-		switch (character) {
-
-		//Leertaste: Wird die Leertatse gedrckt, wird das Bild (frame) gespeichert
-		case ' ':
-			
-			// Wenn die Ecken gefunden worden sind, dann wird es zu dem Array savedImages zwischengespeichert
-			if (found) {
-
-				Mat temp;
-
-				frame.copyTo(temp);
-				savedImages.push_back(temp);
-
-				cout <<  "Anzahl Bilder: " << savedImages.size() << endl;
-			}
-
-			break;
-
-		// Enter: Wird die Enter-Taste gedrckt, wird die Kalibrierung der Kamera gestartet. Dabei werden die Bilder verwendet,
-		//		  die in savedImages zwischengespeichert worden sind
-		case 13:
-			
-			//Es sollten mehr als 15 Bilder vorhanden sein, fr die Kalibrierung
-			if (savedImages.size() > 15) {
-
-				cameraCalibration(savedImages, chessboardDimensions, calibrationSquareDimension, cameraMatrix, distanceCoefficients);
-				saveCameraCalibration("CameraCalibration", cameraMatrix, distanceCoefficients);
-
-				cout << "Kamerakalibrierung gespeichert!" << endl;
-			}
-
-			break;
-
-		// Escape: Der ganze Prozess wird beendet
-		case 27:
-
-			cout << "Webcam wird geschlossen!" << endl;
-			return;
-			break;
-		}
-	}
-}
-
-int main(int argv, char** argc) {
-
-	Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
-
-	Mat distanceCoefficients;
-
-	// 1.) Bilder machen, um die Koeffizienten zu bekommen, die gespeichert werden
-	//     Leertaste: Bild machen; Enter: Kalibrieung starten (min. 15 Bilder); Escape: Exit
-	//cameraCalibrationProcess(cameraMatrix, distanceCoefficients);
-	
-	// 2.) Kamerakalibrieung laden und Markerpositionen bestimmen/ anzeigen
-	loadCameraCalibration("CameraCalibration", cameraMatrix, distanceCoefficients);
-	startWebcamMonitoring(cameraMatrix, distanceCoefficients, arucoSquareDimension);
-
-	return 0;
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+#include <opencv2/opencv.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/ximgproc.hpp>
+#include <opencv2/highgui.hpp>
+#include <opencv2/calib3d.hpp>
+
+#include <sstream>
+#include <cstdio>
+#include <iostream>
+#include <fstream>
+#include <memory>
+
+#include "../../OpenCV_Library/OpenCV_Library/Visualizer.h"
+#include "../../OpenCV_Library/OpenCV_Library/FrameSource.h"
+#include "../../OpenCV_Library/OpenCV_Library/CalibrationFile.h"
+#include "../../OpenCV_Library/OpenCV_Library/MarkerDetector.h"
+#include "../../OpenCV_Library/OpenCV_Library/UndistortionCache.h"
+#include "../../OpenCV_Library/OpenCV_Library/PoseTracker.h"
+#include "../../OpenCV_Library/OpenCV_Library/PipelineStats.h"
+#include "ChessboardPreview.h"
+#include "IncrementalCalibrator.h"
+
+using namespace std;
+using namespace cv;
+
+// Länge eines Quadrats des Chessboards in Metern
+const float calibrationSquareDimension = 0.0245f;
+
+// Länge des ausgedruckten ArUco-Markers (hier: DICT_4X4_50) in Metern
+const float arucoSquareDimension = 0.132f;
+
+// Dimensionen des Chessboards (hier: 9, 6 -> Kreuzungen der schwarzen und weißen Quadraten (Spalten, Reihen))
+const Size chessboardDimensions = Size(9, 6);
+
+// Binäre Kalibrierungsdatei (siehe CalibrationFile.h) und die alte Textdatei, aus der sie einmalig übernommen wird
+const string calibrationFileName = "CameraCalibration.bin";
+const string legacyCalibrationFileName = "CameraCalibration";
+
+
+
+/* createArucoMarker() - Funktion: Generierung von Aruco-Markers aus einer bestimmten Lexikon*/
+void createArucoMarkers() {
+
+	//Matrix (Array) für das Bild des Markers
+	Mat outputMarker;
+
+	/*Erstellung des Lexikons [DICT_(bits)x(bits)_(Anzahl Marker)]:
+			- DICT_4X4_50
+			- DICT_4X4_100
+			- DICT_4X4_250
+			- DICT_4X4_1000
+			- DICT_5X5_50
+			- DICT_5X5_100
+			- DICT_5X5_250
+			- DICT_5X5_1000
+			- DICT_6X6_50
+			- DICT_6X6_100
+			- DICT_6X6_250
+			- DICT_6X6_1000
+			- DICT_7X7_50
+			- DICT_7X7_100
+			- DICT_7X7_250
+			- DICT_7X7_1000
+		 */
+	Ptr<aruco::Dictionary> markerDictionary = aruco::getPredefinedDictionary(aruco::PREDEFINED_DICTIONARY_NAME::DICT_4X4_50);
+
+
+	for (int i = 0; i < 50; ++i) {
+
+		/* darwMarker()-Funktion: Marker die in outputMarker gespeichert werden
+			 - @param markerDictionary: Zuvor angelegte Dictionary-Objekt, welches übergeben wird
+			 - @param i:  Marker-ID
+			 - @param 500: ist die Größe des Ausgabemarkierungsbildes, in diesem Fall wird das Ausgabebild eine Größe von 500x500 Pixel haben.
+			   Der Parameter sollte groß genug gewählt werden, um die Anzahl der Bits für das spezifische Lexikon zu speichern
+			 - @param outputMarker: n-dimensionales Array in dem die Marker gespeichert werden
+			 - @param 1: Optionaler Parameter zur Angabe der Breite des schwarzen Rands der Markierung.
+			   Die Größe wird proportional zur Anzahl der Bits angegeben. Zum Beispiel bedeutet ein Wert von 2, dass der Rand 
+			   eine Breite hat, die der Größe von zwei internen Bits entspricht. Der Standardwert ist 1*/
+		aruco::drawMarker(markerDictionary, i, 500, outputMarker, 1);
+		
+		//Ausgabe der Marker als .jpg Datei
+		ostringstream convert;
+		string imageName = "4x4Marker_";
+		convert << imageName << i << ".jpg";
+
+		/* imwrite()-Funktion: Speichert das Bild in eine spezifische Datei
+			 - @param convert.str(): Name der Datei
+			 - @param outputMarker:  Marker die gespeichert werden sollen*/
+		imwrite(convert.str(), outputMarker);
+	}
+}
+
+
+
+/* createKnownBoardPositions()-Funktion: Erstellung der Eckpositionen auf dem Chessboard
+	- @param boardSize: Größe des Chessboards (hier: 9, 6)
+	- @param squareEdgeLength: Länge eines Quadrates auf dem Chessboard
+	- @param corners: Vektor in dem die bestimmten Eckpositionen gespeichert werden (hier: Z = 0, da flache Fläche)*/
+void createKnownBoardPositions(Size boardSize, float squareEdgeLength, vector<Point3f>& corners) {
+
+	for (int i = 0; i < boardSize.height; ++i) {
+
+		for (int j = 0; j < boardSize.width; ++j) {
+
+			corners.push_back(Point3f(j * squareEdgeLength, i * squareEdgeLength, 0.0f));
+		}
+	}
+}
+
+
+
+// Methode über individuell, gespeicherte Bilder
+/* getChessboardCorners()-Funktion: Finde und visualiesiere die gefundenen Eckpositionen (Kreuzungspositionen). Die Bilder
+   werden parallel auf allen Kernen durchsucht (parallel_for_), die Ecken danach im selben Schritt subpixelgenau
+   verfeinert. Die Reihenfolge der Ergebnisse entspricht der Reihenfolge der Bilder
+	- @param images: Reihe von Bildern die übergeben werden sollen, um die Eckpositionen zu bestimmen (wird nicht kopiert)
+	- @param allFoundCorners: Alle gefundenen Ecken, die ausgegeben werden sollen
+	- @param showResults: Zeige die Ergebnisse der gefundenen Ecken*/
+void getChessboardCorners(const vector<Mat>& images, vector<vector<Point2f>>& allFoundCorners, bool showResults = false) {
+
+	// Jedes Bild schreibt nur in seinen eigenen Eintrag, dadurch braucht die parallele Suche keine Sperre
+	vector<vector<Point2f>> cornersPerImage(images.size());
+	vector<char> foundPerImage(images.size(), 0);
+
+	parallel_for_(Range(0, (int)images.size()), [&](const Range& range) {
+
+		Mat grey;
+
+		for (int i = range.start; i < range.end; ++i) {
+
+			/*findChessboardCorners()-Funktion: Findet die Positionen der inneren Ecken des Chessboards
+				- @param images[i]: Bild das untersucht werden soll
+				- @param chessboardDimensions: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+				- @param cornersPerImage[i]: Ausgabearray der erkannten Ecken
+				- @param CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE: Verschiedenen Operationsflags
+				- @output: true oder false, ob die Innenekcen gefunden werden konnten*/
+			bool found = findChessboardCorners(images[i], chessboardDimensions, cornersPerImage[i],
+				CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE);
+
+			if (found) {
+
+				if (images[i].channels() == 1) {
+
+					grey = images[i];
+				}
+				else {
+
+					cvtColor(images[i], grey, COLOR_BGR2GRAY);
+				}
+
+				/* cornerSubPix()-Funktion: Verfeinert die gefundenen Ecken auf Subpixelgenauigkeit
+					- @param Size(11, 11): Halbe Seitenlänge des Suchfensters
+					- @param Size(-1, -1): Keine tote Zone in der Mitte des Suchfensters
+					- @param TermCriteria: Höchstens 30 Iterationen oder bis sich die Ecke um weniger als 0.01 Pixel bewegt*/
+				cornerSubPix(grey, cornersPerImage[i], Size(11, 11), Size(-1, -1),
+					TermCriteria(TermCriteria::EPS + TermCriteria::COUNT, 30, 0.01));
+			}
+
+			foundPerImage[i] = found;
+		}
+	});
+
+	for (size_t i = 0; i < images.size(); ++i) {
+
+		if (foundPerImage[i]) {
+
+			allFoundCorners.push_back(cornersPerImage[i]);
+		}
+
+		if (showResults) {
+
+			// Gezeichnet wird auf einer Kopie, die übergebenen Bilder bleiben unverändert
+			Mat drawToImage;
+			images[i].copyTo(drawToImage);
+
+			/* drawChessboardCorners()-Funktion: Rendert die erkannten Chessboard-Ecken
+				- @param drawToImage: Zielbild, auf dem die Ecken gerendert werden sollen
+				- @param chessboardDimensions: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+				- @param cornersPerImage[i]: Array der erkannten Ecken (Ausgabe von s. findChessboardCorners())
+				- @param foundPerImage[i]: Parameter, der angibt, ob das komplette Board gefunden wurde oder nicht*/
+			drawChessboardCorners(drawToImage, chessboardDimensions, cornersPerImage[i], foundPerImage[i] != 0);
+
+			/* imshow()-Funktion: Stellt ein Bild in einem spezifischen Fenster dar
+				- @param "Looking for Corners": Stellt den Fensternamen dar
+				- @param drawToImage: Darzustellende Bild
+				Auf dieser Funktion sollte immer die waitKey()-Funktion folgen, weil sonst das Fenster nicht dargestellt wird*/
+			imshow("Looking for Corners", drawToImage);
+			
+			/* waitKey()-Funktion: Wartet so lange bis eine Taste gedrückt wird oder eine bestimmte Zeit vergangen ist
+				 - @param 0: Gibt den Delay in Millisekunden an (0 meint für immer)*/
+			waitKey(0);
+		}
+	}
+}
+
+
+
+
+/* cameraCalibrationFromCorners()-Funktion: Durchführung der Kamerakalibireung direkt aus bereits gefundenen Ecken
+   (Erstellung der 3x3-Kameramatrix und Abstandskoeffizienten)
+	- @param checkerboardImageSpacePoints: Gefundene Innenecken pro Ansicht des Chessboards
+	- @param imageSize: Größe der Bilder, auf denen die Ecken gefunden wurden
+	- @param boardSize: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+	- @param squareEdgeLength: Länge eines Quadrates auf dem Chessboard
+	- @param cameraMatrix: 3x3-Kameramatrix, die übergeben wird, um die Werte der Kalibireung zu speichern
+	- @param distanceCoefficients: Abstandskoeffizienten, die ebenfalls übergebn werden, um sie zu bestimmen
+	- @param return: RMS des Rückprojektionsfehlers in Pixeln (-1, wenn keine Ansicht übergeben wurde)*/
+double cameraCalibrationFromCorners(const vector<vector<Point2f>>& checkerboardImageSpacePoints, Size imageSize,
+	Size boardSize, float squareEdgeLength, Mat& cameraMatrix, Mat& distanceCoefficients) {
+
+	// calibrateCamera() wirft ohne Ansichten eine Ausnahme
+	if (checkerboardImageSpacePoints.empty()) {
+
+		return -1.0;
+	}
+
+	//Bekannte Board-Positionen mit der Größe 1
+	vector<vector<Point3f>> worldSpaceCornerPoints(1);
+
+	/* createKnownBoardPositions()-Funktion: Erstellung der Eckpositionen auf dem Chessboard
+	- @param boardSize: Größe des Chessboards (hier: 9, 6)
+	- @param squareEdgeLength: Länge eines Quadrates auf dem Chessboard
+	- @param worldSpaceCornerPoints[0] (erstes Element): Vektor in dem die bestimmten Eckpositionen gespeichert werden*/
+	createKnownBoardPositions(boardSize, squareEdgeLength, worldSpaceCornerPoints[0]);
+	
+	worldSpaceCornerPoints.resize(checkerboardImageSpacePoints.size(), worldSpaceCornerPoints[0]);
+
+
+	vector<Mat> rVectors, tVectors;
+	distanceCoefficients = Mat::zeros(8, 1, CV_64F);
+
+	/* calibrateCamera()-Funktion: Findet die kamerainternen und -externen Parameter aus mehreren Ansichten eines Kalibriemusters
+		- @param worldSpaceCornerPoints: 
+		- @param checkerboardImageSpacePoints:
+		- @param imageSize: Größe des Bildes, das zur Initialisierung der kamerinternen Matrix verwendet wird
+		- @param cameraMatrix: 3x3 Kamera-Matrix (intrinsische Matrix)
+		- @param distanceCoefficients: Vektor der Abstandskoeffizienten
+		- @param rVectors: Output der Rotationsvektoren
+		- @param tVectors: Output der Translationsvektoren*/
+	return calibrateCamera(worldSpaceCornerPoints, checkerboardImageSpacePoints, imageSize, cameraMatrix,
+		distanceCoefficients, rVectors, tVectors);
+}
+
+
+/* cameraCalibration()-Funktion: Durchführung der Kamerakalibireung aus gespeicherten Bildern (Erstellung der 3x3-Kameramatrix
+   und Abstandskoeffizienten)
+	- @param calibrationImages: Es werden Bilder für eine Kalibrieung übergeben, die bereits als gültig erkannt worden sind
+	- @param boardSize: Anzahl der Innenecken pro Schachbrettreihe und -spalte (Size(columns, rows))
+	- @param squareEdgeLength: Länge eines Quadrates auf dem Chessboard
+	- @param cameraMatrix: 3x3-Kameramatrix, die übergeben wird, um die Werte der Kalibireung zu speichern
+	- @param distanceCoefficients: Abstandskoeffizienten, die ebenfalls übergebn werden, um sie zu bestimmen
+	- @param return: RMS des Rückprojektionsfehlers in Pixeln (-1, wenn auf keinem Bild ein Chessboard gefunden wurde)*/
+double cameraCalibration(const vector<Mat>& calibrationImages, Size boardSize, float squareEdgeLength,
+	Mat& cameraMatrix, Mat& distanceCoefficients) {
+
+	// Punkte der Ecken, die wir auf den Bildern erkennen
+	vector<vector<Point2f>> checkerboardImageSpacePoints;
+
+	/* getChessboardCorners()-Funktion: Finde und visualiesiere die gefundenen Eckpositionen (Kreuzungspositionen)
+	- @param calibrationImages: Reihe von Bildern die übergeben werden sollen, um die Eckpositionen zu bestimmen
+	- @param checkerboardImageSpacePoints: Alle gefundenen Ecken, die ausgegeben werden sollen
+	- @param false: Zeige die Ergebnisse der gefundenen Ecken*/
+	getChessboardCorners(calibrationImages, checkerboardImageSpacePoints, false);
+
+	Size imageSize = calibrationImages.empty() ? Size() : calibrationImages[0].size();
+
+	return cameraCalibrationFromCorners(checkerboardImageSpacePoints, imageSize, boardSize, squareEdgeLength,
+		cameraMatrix, distanceCoefficients);
+}
+
+
+/* calibrateFromSource()-Funktion: Kalibrierung ohne Kamera aus gespeicherten Bildern, z.B. "--calibrate dir:Aufnahmen".
+   Alle Bilder der Quelle werden gelesen, die Ecken parallel gesucht (getChessboardCorners()) und das Ergebnis wie bei
+   der Live-Kalibrierung in "CameraCalibration.bin" gespeichert
+	- @param sourceUri: Bildquelle ohne "?loop=1" (siehe createFrameSource() in FrameSource.h)
+	- @param cameraMatrix: 3x3-Kameramatrix, die übergeben wird, um die Werte der Kalibireung zu speichern
+	- @param distanceCoefficients: Abstandskoeffizienten, die ebenfalls übergebn werden, um sie zu bestimmen
+	- @param return: True, wenn genug Bilder ein Chessboard zeigten und die Kalibrierung gespeichert werden konnte*/
+bool calibrateFromSource(const string& sourceUri, Mat& cameraMatrix, Mat& distanceCoefficients) {
+
+	unique_ptr<FrameSource> source = createFrameSource(sourceUri);
+
+	if (!source->isOpened()) {
+
+		cout << "Bildquelle konnte nicht geöffnet werden: " << sourceUri << endl;
+		return false;
+	}
+
+	// Die Quelle darf ihren Puffer beim nächsten Bild wiederverwenden, daher wird jedes Bild kopiert
+	vector<Mat> calibrationImages;
+	Mat frame;
+
+	while (source->read(frame)) {
+
+		calibrationImages.push_back(frame.clone());
+	}
+
+	if (calibrationImages.empty()) {
+
+		cout << "Keine Bilder gefunden: " << sourceUri << endl;
+		return false;
+	}
+
+	double reprojectionError = cameraCalibration(calibrationImages, chessboardDimensions, calibrationSquareDimension,
+		cameraMatrix, distanceCoefficients);
+
+	if (reprojectionError < 0.0) {
+
+		cout << "Auf keinem der " << calibrationImages.size() << " Bilder wurde ein Chessboard gefunden!" << endl;
+		return false;
+	}
+
+	if (!saveCalibrationFile(calibrationFileName, cameraMatrix, distanceCoefficients, calibrationImages[0].size(),
+		reprojectionError)) {
+
+		cout << "Kamerakalibrierung konnte nicht gespeichert werden!" << endl;
+		return false;
+	}
+
+	cout << "Kamerakalibrierung aus " << calibrationImages.size() << " Bildern gespeichert! (RMS: " << reprojectionError
+		<< " px)" << endl;
+
+	return true;
+}
+
+
+/* startWebcamMonitoring()-Funktion: Posenschätzung der ArUco-Marker. Erkennung und Posenschätzung laufen wie in der
+   DLL (DetectorContext): Verfolgung der Marker in Ausschnitten, Entzerrung der Ecken über eine Tabelle und Warmstart
+   der Pose aus der Spur des Markers, mit Puffern, die über alle Bilder wiederverwendet werden
+		- @param cameraMatrix: Intrinsische Kameramatrix, die vorher erstellt werden muss
+		- @param distanceCoefficients: Abstandskoeffizienten, die vorher bestimmt werden müssen
+		- @param arucoSquareDimensions: Länge des ArUco-Markers
+		- @param headless: Ohne Zeichnen und ohne Fenster (kein GUI-Backend nötig), sonst mit Debug-Anzeige
+		- @param sourceUri: Bildquelle, z.B. "0" (Webcam), "file:video.mp4", "dir:Bilder" oder "synthetic" (siehe
+							createFrameSource() in FrameSource.h)*/
+int startWebcamMonitoring(const Mat& cameraMatrix, const Mat& distanceCoefficients, float arucoSquareDimensions,
+	bool headless = false, const string& sourceUri = "0") {
+
+	Mat frame;
+
+	Ptr<aruco::Dictionary> markerDictionary = aruco::getPredefinedDictionary(aruco::PREDEFINED_DICTIONARY_NAME::DICT_4X4_50);
+
+	unique_ptr<FrameSource> vid = createFrameSource(sourceUri);
+
+	if (!vid->isOpened()) {
+
+		return -1;
+	}
+
+	MarkerDetector markerDetector;
+	markerDetector.setDictionary(markerDictionary);
+	markerDetector.setMarkerGeometry(cameraMatrix.at<double>(0, 0), arucoSquareDimensions);
+
+	UndistortionCache undistortionCache;
+	PoseTracker poseTracker(arucoSquareDimensions);
+
+	// Die Puffer werden für alle Marker des Lexikons angelegt, damit sie im laufenden Betrieb nicht mehr wachsen müssen
+	const int markerCount = markerDictionary->bytesList.rows;
+
+	vector<int> markerIds;
+	vector<vector<Point2f>> markerCorners, undistortedCorners;
+	CornerPool undistortedCornerPool;
+	vector<Vec3d> rotationVectors, translationVectors;
+	vector<TrackedPose> trackedPoses;
+
+	markerIds.reserve(markerCount);
+	rotationVectors.reserve(markerCount);
+	translationVectors.reserve(markerCount);
+	trackedPoses.reserve(markerCount);
+	undistortedCornerPool.reserve(markerCount);
+
+	// Die Debug-Anzeige zeichnet in einem eigenen Thread auf einer Kopie des Bildes (höchstens 30 Bilder pro Sekunde)
+	unique_ptr<Visualizer> visualizer;
+
+	if (!headless) {
+
+		visualizer.reset(new Visualizer("Webcam", 30.0));
+		visualizer->start();
+	}
+
+	while (true) {
+
+		if (!vid->read(frame)) {
+
+			break;
+		}
+
+		long long captureTimestamp = monotonicMicroseconds();
+
+		// Die Tabelle zum Entzerren wird nur beim ersten Bild bzw. bei einer neuen Bildgröße gebaut
+		undistortionCache.update(cameraMatrix, distanceCoefficients, 0, frame.size());
+
+		/* detect()-Funktion: Markererkennung, im Verfolgungsmodus nur in Ausschnitten um die Marker des letzten Bildes
+				- @param frame: Eingabebild (Webcam)
+				- @param markerCorners: Vektor der erkannten Marker-Ecken. Für N erkannte Marker sind die Dimensionen des Arrays Nx4
+				- @param markerIds: Vektor der Identifikationen der erkannten Markierungen. Für N erkannte Marker ist die Dimension
+									des Arrays N
+				- @param return: Weg der Erkennung, DETECTION_PATH_SKIPPED bei unverändertem Bild*/
+		int detectionPath = markerDetector.detect(frame, markerCorners, markerIds);
+
+		/* track()-Funktion: Posenschätzung für einzelne Marker aus den entzerrten Ecken
+				- @param captureTimestamp: Aufnahmezeitpunkt, aus dem Abstand zum letzten Bild wird die Bewegung fortgeschrieben
+				- @param undistortedCorners: Vektor der bereits erkannten und über die Tabelle entzerrten Markerecken
+				- @param idealCameraMatrix(): Kameramatrix der entzerrten Ecken
+				- @param noDistortion(): Keine Abstandskoeffizienten, da die Ecken bereits entzerrt sind
+				- @param rotationVectors: Ausgabearray von Rotationsvektoren
+				- @param translationVectors: Ausgabearray von Translationsvektoren in Metern. Jedes Element entspricht
+											 der Markierung mit demselben Index in markerIds
+				- @param trackedPoses: Geglättete und vorhergesagte Posen*/
+		if (detectionPath == DETECTION_PATH_SKIPPED) {
+
+			poseTracker.hold(captureTimestamp);
+		}
+		else {
+
+			undistortionCache.undistortCorners(markerCorners, undistortedCorners, undistortedCornerPool);
+			poseTracker.track(captureTimestamp, markerIds, undistortedCorners, undistortionCache.idealCameraMatrix(),
+				undistortionCache.noDistortion(), rotationVectors, translationVectors, trackedPoses);
+		}
+
+		// Die Achsen werden von der Debug-Anzeige gezeichnet. Eine gedrückte Taste im Fenster beendet die Schleife
+		if (visualizer) {
+
+			if (visualizer->isDue()) {
+
+				visualizer->submit(frame, markerIds, markerCorners, rotationVectors, translationVectors, cameraMatrix,
+					distanceCoefficients);
+			}
+
+			if (visualizer->lastKey() >= 0) {
+
+				break;
+			}
+		}
+	}
+
+	return 1;
+}
+
+
+// Breite der Vorschaubilder, die pro Aufnahme statt des ganzen Bildes gespeichert werden
+const int thumbnailWidth = 64;
+
+/* CalibrationSample-Struktur: Eine Aufnahme der Live-Kalibrierung. Statt des ganzen Bildes (mehrere MB) werden nur die
+   bereits gefundenen und verfeinerten Innenecken (9 x 6 Punkte = 432 Bytes) und ein kleines Vorschaubild gespeichert*/
+struct CalibrationSample {
+
+	vector<Point2f> corners;
+	Mat thumbnail;
+};
+
+
+// Live Calibration Images Methode
+/* cameraCalibrationProcess()-Funktion: Erstellung der 3x3 Kamerakalibrierungs-Matrix und der Abstandskoeffizienten
+	- @param cameraMatrix: 3x3 Kamera-Matrix, die übergebn wird, um die Werte zu bestimmen
+	- @param distnaceCoefficients: Array in welches die distance coefficients gespeichert werden
+	- @param sourceUri: Bildquelle (siehe createFrameSource() in FrameSource.h)*/
+void cameraCalibrationProcess(Mat& cameraMatrix, Mat& distanceCoefficients, const string& sourceUri = "0") {
+
+	// frame beinhaltet die Videoinformationen der Webcam
+	Mat frame;
+	Mat drawToFrame;
+
+	// Aufnahmen mit gefundenen Ecken, aus denen kalibriert wird, und die Bildgröße der Webcam
+	vector<CalibrationSample> savedSamples;
+	Size imageSize;
+	Mat grey;
+
+	// Gefundene Innenecken und abgelehnte Kandidaten
+	vector<vector<Point2f>> markerCorners, rejectedCandidates;
+
+	// Erstellung der Videoquelle (Standard: Webcam 0)
+	unique_ptr<FrameSource> vid = createFrameSource(sourceUri);
+
+	// Wenn die Quelle nicht offen ist, wird returnt
+	if (!vid->isOpened()) {
+
+		return;
+	}
+
+
+	// Die Suche für die Vorschau läuft in einem eigenen Thread, Aufnahme und Anzeige laufen mit der Bildrate der Kamera
+	ChessboardPreview preview(chessboardDimensions);
+	preview.start();
+
+	vector<Point2f> previewPoints;
+
+	// Kalibriert nach jeder Aufnahme in einem eigenen Thread neu (wird mit der ersten Aufnahme angelegt, da erst dann
+	// die Bildgröße bekannt ist). Neue Schätzungen werden einmal auf der Konsole ausgegeben
+	unique_ptr<IncrementalCalibrator> calibrator;
+	int reportedEstimates = 0;
+	double reprojectionError = 0.0;
+
+	// Statuszeile der Anzeige. Sie wird nur bei einer neuen Aufnahme oder Schätzung neu formatiert und sonst Bild für
+	// Bild unverändert gezeichnet
+	char overlayBuffer[128];
+	string overlayText;
+	int overlayViews = -1, overlayEstimates = -1;
+
+	/* namedWindow()-Funktion: Erstellt ein Fenster
+		- @param "Webcam": Fenstername
+		- @param WINDOW_AUTOSIZE: Flag für das Fenster
+			WINDOW_AUTOSIZE passt die Fenstergröße automatisch an das Bild an. Die Fenstergröße kann nicht manuell geändert werden*/
+	namedWindow("Webcam", WINDOW_AUTOSIZE);
+
+	while (true) {
+
+		// Wenn das Bild der Webcam (frame) nicht gelesen werden kann, wird die Schleife beendet
+		if (!vid->read(frame)) {
+			break;
+		}
+
+		// Bild an die Suche übergeben (nur wenn sie frei ist) und das letzte fertige Ergebnis abholen. Die Ecken können
+		// dadurch ein paar Bilder alt sein, was für die Vorschau keine Rolle spielt
+		preview.submit(frame);
+		bool previewFound = preview.latestResult(previewPoints);
+
+		// Kopiere das Videobild (frame), weil wir darauf zeichnen wollen
+		frame.copyTo(drawToFrame);
+
+		/* drawChessboardCorners()-Funktion: Rendert die erkannten Chessboard-Ecken
+				- @param drawToFrame: Zielbild, auf dem die Ecken gerendert werden sollen (Webcam)
+				- @param chessboardDimensions: Konstante, globale Variable für die Anzahl der Innenecken 
+					 pro Schachbrettreihe und -spalte (Size(columns, rows))
+				- @param previewPoints: Array der erkannten Ecken (Ergebnis der Vorschau)
+				- @param previewFound: Parameter, der angibt, ob das komplette Board gefunden wurde oder nicht*/
+		drawChessboardCorners(drawToFrame, chessboardDimensions, previewPoints, previewFound);
+
+		// Vorschaubild der letzten Aufnahme oben links, damit man sieht, welche Ansichten schon gespeichert sind
+		if (!savedSamples.empty()) {
+
+			const Mat& thumbnail = savedSamples.back().thumbnail;
+			Rect target = Rect(0, 0, thumbnail.cols, thumbnail.rows) & Rect(0, 0, drawToFrame.cols, drawToFrame.rows);
+
+			if (target.area() == thumbnail.cols * thumbnail.rows) {
+
+				cvtColor(thumbnail, drawToFrame(target), COLOR_GRAY2BGR);
+			}
+		}
+
+		// Abdeckung des Bildes durch die bisherigen Aufnahmen und Stand der Kalibrierung
+		if (calibrator) {
+
+			const CalibrationStatus status = calibrator->status();
+
+			if (status.estimates != reportedEstimates) {
+
+				reportedEstimates = status.estimates;
+
+				cout << "Schätzung aus " << status.estimatedViews << " Aufnahmen, RMS: " << status.reprojectionError << " px";
+
+				if (status.hasDeviations) {
+
+					cout << ", Unsicherheit fx/fy/cx/cy: " << status.standardDeviations[0] << "/"
+						<< status.standardDeviations[1] << "/" << status.standardDeviations[2] << "/"
+						<< status.standardDeviations[3] << " px";
+				}
+
+				cout << ", Abdeckung: " << (int)(status.coverage * 100) << "%" << endl;
+
+				if (status.converged) {
+
+					cout << "Kalibrierung konvergiert, mit Enter speichern!" << endl;
+				}
+			}
+
+			calibrator->drawCoverage(drawToFrame);
+
+			if (status.views != overlayViews || status.estimates != overlayEstimates) {
+
+				overlayViews = status.views;
+				overlayEstimates = status.estimates;
+
+				snprintf(overlayBuffer, sizeof(overlayBuffer), "Aufnahmen: %d  RMS: %.2f px  Abdeckung: %d%%%s",
+					status.views, status.reprojectionError, (int)(status.coverage * 100),
+					status.converged ? "  konvergiert (Enter)" : "");
+				overlayText.assign(overlayBuffer);
+			}
+
+			putText(drawToFrame, overlayText, Point(10, drawToFrame.rows - 10), FONT_HERSHEY_SIMPLEX, 0.6,
+				status.converged ? Scalar(0, 255, 0) : Scalar(0, 255, 255), 2);
+		}
+
+		// Zeige das Webcam-Videobild mit den gefundenen Ecken (falls vorhanden)
+		imshow("Webcam", drawToFrame);
+
+		char character = waitKey(1);
+
+		// Was während des Prozesses gemacht werden kann, abhängig welche Taste betätigt wird
+		switch (character) {
+
+		//Leertaste: Wird die Leertatse gedrückt, werden die gefundenen Ecken gespeichert
+		case ' ':
+		{
+			vector<Point2f> foundPoints;
+
+			cvtColor(frame, grey, COLOR_BGR2GRAY);
+
+			/*findChessboardCorners()-Funktion: Findet die Positionen der inneren Ecken des Chessboards. Erst hier wird in
+			  voller Auflösung gesucht, nur für das Bild, das gespeichert werden soll
+				- @param grey: Bild das untersucht werden soll (Webcam)
+				- @param chessboardDimensions: Konstante, globale Variable für die Anzahl der Innenecken 
+						 pro Schachbrettreihe und -spalte (Size(columns, rows))
+				- @param foundPoints: Ausgabearray der erkannten Ecken
+				- @param CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE: Verschiedenen Operationsflags
+				- @output: true oder false, ob die Innenekcen gefunden werden konnten*/
+			bool found = findChessboardCorners(grey, chessboardDimensions, foundPoints,
+				CALIB_CB_ADAPTIVE_THRESH | CALIB_CB_NORMALIZE_IMAGE);
+
+			// Wenn die Ecken gefunden worden sind, werden sie subpixelgenau verfeinert und mit einem Vorschaubild zu
+			// savedSamples hinzugefügt. Das Bild selbst wird nicht gespeichert und später auch nicht erneut durchsucht
+			if (found) {
+
+				CalibrationSample sample;
+
+				cornerSubPix(grey, foundPoints, Size(11, 11), Size(-1, -1),
+					TermCriteria(TermCriteria::EPS + TermCriteria::COUNT, 30, 0.01));
+
+				sample.corners = foundPoints;
+				resize(grey, sample.thumbnail, Size(thumbnailWidth, max(1, thumbnailWidth * grey.rows / grey.cols)), 0, 0,
+					INTER_AREA);
+
+				savedSamples.push_back(sample);
+				imageSize = frame.size();
+
+				if (!calibrator) {
+
+					calibrator.reset(new IncrementalCalibrator(chessboardDimensions, calibrationSquareDimension, imageSize));
+					calibrator->start();
+				}
+
+				// Die Schätzung wird im Thread mit der neuen Aufnahme aktualisiert, ausgehend von der letzten Schätzung.
+				// Das Ergebnis erscheint in der Anzeige und auf der Konsole, sobald es fertig ist
+				calibrator->addView(foundPoints);
+
+				cout << "Anzahl Aufnahmen: " << savedSamples.size() << endl;
+			}
+			else {
+
+				cout << "Kein Chessboard gefunden!" << endl;
+			}
+
+			break;
+		}
+
+		// Enter: Wird die Enter-Taste gedrückt, wird die letzte fertige Schätzung gespeichert. Es muss nichts mehr
+		//		  nachgerechnet werden, Aufnahmen, deren Schätzung noch läuft, sind darin aber noch nicht enthalten
+		case 13:
+			
+			//Es sollten mehr als 15 Aufnahmen vorhanden sein oder die Kalibrierung muss bereits konvergiert sein
+			if (calibrator && (calibrator->status().converged || savedSamples.size() > 15) &&
+				calibrator->getCalibration(cameraMatrix, distanceCoefficients, &reprojectionError)) {
+
+				if (saveCalibrationFile(calibrationFileName, cameraMatrix, distanceCoefficients, imageSize,
+					reprojectionError)) {
+
+					cout << "Kamerakalibrierung gespeichert! (RMS: " << reprojectionError << " px)" << endl;
+				}
+			}
+
+			break;
+
+		// Escape: Der ganze Prozess wird beendet
+		case 27:
+
+			cout << "Webcam wird geschlossen!" << endl;
+			return;
+			break;
+		}
+	}
+}
+
+int main(int argv, char** argc) {
+
+	// Mit "--headless" läuft die Posenschätzung ohne Zeichnen und ohne Fenster. Mit "--source <uri>" wird statt der
+	// Webcam eine andere Bildquelle verwendet, z.B. "--source dir:." für die 4x4Marker_*.jpg-Bilder. Mit
+	// "--calibrate <uri>" wird nur aus gespeicherten Bildern kalibriert, z.B. "--calibrate dir:Aufnahmen"
+	bool headless = false;
+	string sourceUri = "0";
+	string calibrationUri;
+
+	for (int i = 1; i < argv; ++i) {
+
+		string argument = argc[i];
+
+		if (argument == "--headless") {
+
+			headless = true;
+		}
+		else if (argument == "--source" && i + 1 < argv) {
+
+			sourceUri = argc[++i];
+		}
+		else if (argument == "--calibrate" && i + 1 < argv) {
+
+			calibrationUri = argc[++i];
+		}
+	}
+
+	Mat cameraMatrix = Mat::eye(3, 3, CV_64F);
+
+	Mat distanceCoefficients;
+
+	// 0.) Kalibrierung aus gespeicherten Bildern, ohne Kamera und ohne Fenster
+	if (!calibrationUri.empty()) {
+
+		return calibrateFromSource(calibrationUri, cameraMatrix, distanceCoefficients) ? 0 : 1;
+	}
+
+	// 1.) Bilder machen, um die Koeffizienten zu bekommen, die gespeichert werden
+	//     Leertaste: Bild machen; Enter: Kalibrieung starten (min. 15 Bilder); Escape: Exit
+	//cameraCalibrationProcess(cameraMatrix, distanceCoefficients, sourceUri);
+	
+	// 2.) Kamerakalibrieung laden und Markerpositionen bestimmen/ anzeigen
+	//     Die alte Textdatei "CameraCalibration" wird beim ersten Start einmalig in das binäre Format übernommen
+	if (!loadCalibrationFile(calibrationFileName, cameraMatrix, distanceCoefficients)) {
+
+		importLegacyCalibration(legacyCalibrationFileName, calibrationFileName);
+
+		if (!loadCalibrationFile(calibrationFileName, cameraMatrix, distanceCoefficients)) {
+
+			cout << "Keine gültige Kamerakalibrierung gefunden!" << endl;
+		}
+	}
+
+	startWebcamMonitoring(cameraMatrix, distanceCoefficients, arucoSquareDimension, headless, sourceUri);
+
+	return 0;
 }
\ No newline at end of file
@@ -0,0 +1,293 @@
+#include "CalibrationFile.h"
+#include <fstream>
+#include <cmath>
+#include <cstring>
+#include <cstdio>
+#include <atomic>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+using namespace std;
+using namespace cv;
+
+// Kennung am Anfang jeder binären Kalibrierungsdatei
+static const char calibrationMagic[4] = { 'A', 'C', 'A', 'L' };
+
+
+/* computeChecksum()-Funktion: FNV-1a (32 Bit) über alle Bytes vor dem Feld checksum
+		- @param data: Zu prüfende Daten
+		- @param return: Prüfsumme*/
+static uint32_t computeChecksum(const CalibrationData& data) {
+
+	const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&data);
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < offsetof(CalibrationData, checksum); ++i) {
+
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+
+/* isValidDistortionCount()-Funktion: OpenCV kennt nur Modelle mit 4, 5, 8, 12 oder 14 Koeffizienten*/
+static bool isValidDistortionCount(int count) {
+
+	return count == 4 || count == 5 || count == 8 || count == 12 || count == 14;
+}
+
+
+bool validateCalibrationData(const CalibrationData& data) {
+
+	if (memcmp(data.magic, calibrationMagic, sizeof(calibrationMagic)) != 0 || data.version != calibrationFileVersion ||
+		data.size != sizeof(CalibrationData) || data.checksum != computeChecksum(data)) {
+
+		return false;
+	}
+
+	if (!isValidDistortionCount(data.distortionCount) || data.imageWidth < 0 || data.imageHeight < 0) {
+
+		return false;
+	}
+
+	for (int i = 0; i < 9; ++i) {
+
+		if (!isfinite(data.cameraMatrix[i])) {
+
+			return false;
+		}
+	}
+
+	for (int i = 0; i < data.distortionCount; ++i) {
+
+		if (!isfinite(data.distortion[i])) {
+
+			return false;
+		}
+	}
+
+	// Brennweiten fx und fy
+	return data.cameraMatrix[0] > 0.0 && data.cameraMatrix[4] > 0.0;
+}
+
+
+/* toCalibrationData()-Funktion: Füllt die Dateistruktur aus den OpenCV-Matrizen
+		- @param return: False, wenn die Matrizen nicht die erwartete Form haben*/
+static bool toCalibrationData(const Mat& cameraMatrix, const Mat& distanceCoefficients, const Size& imageSize,
+	double reprojectionError, CalibrationData& data) {
+
+	int distortionCount = (int)distanceCoefficients.total();
+
+	if (cameraMatrix.rows != 3 || cameraMatrix.cols != 3 || !isValidDistortionCount(distortionCount)) {
+
+		return false;
+	}
+
+	Mat camera, distortion;
+	cameraMatrix.convertTo(camera, CV_64F);
+	distanceCoefficients.reshape(1, distortionCount).convertTo(distortion, CV_64F);
+
+	// Auch Padding und unbenutzte Koeffizienten sind 0, damit die Prüfsumme eindeutig ist
+	memset(&data, 0, sizeof(data));
+	memcpy(data.magic, calibrationMagic, sizeof(calibrationMagic));
+	data.version = calibrationFileVersion;
+	data.size = sizeof(CalibrationData);
+	data.imageWidth = imageSize.width;
+	data.imageHeight = imageSize.height;
+	data.distortionCount = distortionCount;
+	data.reprojectionError = reprojectionError;
+
+	for (int i = 0; i < 9; ++i) {
+
+		data.cameraMatrix[i] = camera.at<double>(i / 3, i % 3);
+	}
+
+	for (int i = 0; i < distortionCount; ++i) {
+
+		data.distortion[i] = distortion.at<double>(i, 0);
+	}
+
+	data.checksum = computeChecksum(data);
+
+	return validateCalibrationData(data);
+}
+
+
+/* replaceFile()-Funktion: Ersetzt eine Datei in einem Schritt durch eine andere. Ein gleichzeitiges Laden findet
+   entweder die alte oder die neue Datei, aber nie keine
+		- @param source: Neue Datei, wird umbenannt
+		- @param target: Zu ersetzende Datei (muss nicht existieren)
+		- @param return: True, wenn die Datei ersetzt wurde*/
+static bool replaceFile(const string& source, const string& target) {
+
+#if defined(_WIN32)
+	// rename() verweigert unter Windows ein vorhandenes Ziel
+	return MoveFileExA(source.c_str(), target.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	// rename() ersetzt unter POSIX ein vorhandenes Ziel atomar
+	return rename(source.c_str(), target.c_str()) == 0;
+#endif
+}
+
+
+/* temporaryFileName()-Funktion: Eigener Name der temporären Datei für jeden Speichervorgang (Prozess und fortlaufende
+   Nummer), damit sich gleichzeitig speichernde Kontexte oder Programme nicht gegenseitig die Datei überschreiben
+		- @param name: Name der Zieldatei
+		- @param return: Name der temporären Datei im selben Ordner*/
+static string temporaryFileName(const string& name) {
+
+	static atomic<unsigned int> counter(0);
+
+#if defined(_WIN32)
+	unsigned long processId = GetCurrentProcessId();
+#else
+	unsigned long processId = (unsigned long)getpid();
+#endif
+
+	return name + "." + to_string(processId) + "." + to_string(counter.fetch_add(1)) + ".tmp";
+}
+
+
+/* writeCalibrationData()-Funktion: Schreibt die Daten zuerst in eine temporäre Datei und ersetzt dann die alte Datei.
+   Ein gleichzeitiges Laden aus einem anderen Kontext sieht so nie eine halb geschriebene oder fehlende Datei*/
+static bool writeCalibrationData(const string& name, const CalibrationData& data) {
+
+	string temporaryName = temporaryFileName(name);
+
+	{
+		ofstream outStream(temporaryName, ios::out | ios::binary | ios::trunc);
+
+		if (!outStream || !outStream.write(reinterpret_cast<const char*>(&data), sizeof(data)) || !outStream.flush()) {
+
+			remove(temporaryName.c_str());
+			return false;
+		}
+	}
+
+	if (!replaceFile(temporaryName, name)) {
+
+		remove(temporaryName.c_str());
+		return false;
+	}
+
+	return true;
+}
+
+
+bool saveCalibrationFile(const string& name, const Mat& cameraMatrix, const Mat& distanceCoefficients,
+	const Size& imageSize, double reprojectionError) {
+
+	CalibrationData data;
+
+	return toCalibrationData(cameraMatrix, distanceCoefficients, imageSize, reprojectionError, data) &&
+		writeCalibrationData(name, data);
+}
+
+
+/* readLegacyCalibration()-Funktion: Liest das alte Textformat (Zeilen, Spalten und Werte der Kameramatrix, danach
+   Zeilen, Spalten und Werte der Verzeichnungskoeffizienten)
+		- @param return: False, wenn die Datei unvollständig ist oder nicht dem Format entspricht*/
+static bool readLegacyCalibration(istream& inStream, Mat& cameraMatrix, Mat& distanceCoefficients) {
+
+	int rows = 0;
+	int columns = 0;
+
+	if (!(inStream >> rows >> columns) || rows != 3 || columns != 3) {
+
+		return false;
+	}
+
+	cameraMatrix.create(3, 3, CV_64F);
+
+	for (int i = 0; i < 9; ++i) {
+
+		if (!(inStream >> cameraMatrix.at<double>(i / 3, i % 3))) {
+
+			return false;
+		}
+	}
+
+	if (!(inStream >> rows >> columns) || rows <= 0 || columns <= 0 || !isValidDistortionCount(rows * columns)) {
+
+		return false;
+	}
+
+	distanceCoefficients.create(rows * columns, 1, CV_64F);
+
+	for (int i = 0; i < rows * columns; ++i) {
+
+		if (!(inStream >> distanceCoefficients.at<double>(i, 0))) {
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/* loadCalibrationData()-Funktion: Liest eine binäre Datei mit einem einzigen Lesevorgang und prüft sie. Das alte
+   Textformat wird hier nicht erkannt, es wird nur von importLegacyCalibration() gelesen
+		- @param return: False, wenn die Datei fehlt, kein binäres Format hat oder ungültig ist*/
+static bool loadCalibrationData(const string& name, CalibrationData& data) {
+
+	ifstream inStream(name, ios::in | ios::binary);
+
+	if (!inStream) {
+
+		return false;
+	}
+
+	inStream.read(reinterpret_cast<char*>(&data), sizeof(data));
+
+	return inStream.gcount() == (streamsize)sizeof(data) &&
+		memcmp(data.magic, calibrationMagic, sizeof(calibrationMagic)) == 0 && validateCalibrationData(data);
+}
+
+
+bool loadCalibrationFile(const string& name, Mat& cameraMatrix, Mat& distanceCoefficients, Size* imageSize,
+	double* reprojectionError) {
+
+	CalibrationData data;
+
+	if (!loadCalibrationData(name, data)) {
+
+		return false;
+	}
+
+	Mat(3, 3, CV_64F, data.cameraMatrix).copyTo(cameraMatrix);
+	Mat(data.distortionCount, 1, CV_64F, data.distortion).copyTo(distanceCoefficients);
+
+	if (imageSize) {
+
+		*imageSize = Size(data.imageWidth, data.imageHeight);
+	}
+
+	if (reprojectionError) {
+
+		*reprojectionError = data.reprojectionError;
+	}
+
+	return true;
+}
+
+
+bool importLegacyCalibration(const string& legacyName, const string& name, const Size& imageSize) {
+
+	ifstream inStream(legacyName);
+	Mat cameraMatrix, distanceCoefficients;
+
+	if (!inStream || !readLegacyCalibration(inStream, cameraMatrix, distanceCoefficients)) {
+
+		return false;
+	}
+
+	return saveCalibrationFile(name, cameraMatrix, distanceCoefficients, imageSize, -1.0);
+}
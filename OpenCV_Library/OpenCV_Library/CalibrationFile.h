@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <opencv2/core.hpp>
+
+// Aktuelle Version des binären Kalibrierungsformats
+const uint32_t calibrationFileVersion = 1;
+
+// Maximale Anzahl der Verzeichnungskoeffizienten (k1, k2, p1, p2, k3, k4, k5, k6, s1, s2, s3, s4, tx, ty)
+const int maxDistortionCoefficients = 14;
+
+/* CalibrationData-Struktur: Inhalt einer binären Kalibrierungsdatei (z.B. "CameraCalibration.bin"). Die Datei ist genau
+   diese Struktur in Little-Endian (wie x86/x64 sie im Speicher ablegt), ohne Zeiger und mit festen Offsets. Sie kann
+   daher mit einem einzigen read() gelesen werden*/
+struct CalibrationData {
+
+	char magic[4];				// "ACAL"
+	uint32_t version;			// calibrationFileVersion
+	uint32_t size;				// sizeof(CalibrationData), schützt vor abgeschnittenen Dateien
+	int32_t imageWidth;			// Bildgröße, mit der kalibriert wurde (0, wenn unbekannt)
+	int32_t imageHeight;
+	int32_t distortionCount;	// Gültige Einträge in distortion (4, 5, 8, 12 oder 14)
+	double cameraMatrix[9];		// 3x3-Kameramatrix zeilenweise
+	double distortion[maxDistortionCoefficients];
+	double reprojectionError;	// RMS von calibrateCamera() in Pixeln (negativ, wenn unbekannt)
+	uint32_t checksum;			// FNV-1a über alle vorherigen Bytes
+	uint32_t reserved;			// Immer 0
+};
+
+static_assert(sizeof(CalibrationData) == 224, "Das Dateiformat darf sich nicht durch Padding verändern");
+
+/* validateCalibrationData()-Funktion: Prüft Kennung, Version, Größe und Prüfsumme sowie die Plausibilität der Werte
+   (positive Brennweiten, endliche Zahlen, gültige Anzahl an Verzeichnungskoeffizienten)
+		- @param data: Zu prüfende Daten
+		- @param return: True, wenn die Daten verwendet werden können*/
+bool validateCalibrationData(const CalibrationData& data);
+
+/* saveCalibrationFile()-Funktion: Speichert eine Kalibrierung im binären Format
+		- @param name: Name der zu speichernden Datei
+		- @param cameraMatrix: 3x3-Kameramatrix
+		- @param distanceCoefficients: Verzeichnungskoeffizienten (4, 5, 8, 12 oder 14 Werte)
+		- @param imageSize: Bildgröße der Kalibrierung (Size() wenn unbekannt)
+		- @param reprojectionError: RMS von calibrateCamera() (negativ wenn unbekannt)
+		- @param return: True, wenn die Datei vollständig geschrieben werden konnte*/
+bool saveCalibrationFile(const std::string& name, const cv::Mat& cameraMatrix, const cv::Mat& distanceCoefficients,
+	const cv::Size& imageSize, double reprojectionError);
+
+/* loadCalibrationFile()-Funktion: Lädt eine Kalibrierung im binären Format ohne Ausgaben auf der Konsole. Dateien im
+   alten Textformat werden abgelehnt und müssen einmalig mit importLegacyCalibration() umgewandelt werden. Die Ausgaben
+   werden nur bei Erfolg verändert
+		- @param name: Name der zu ladenden Datei
+		- @param cameraMatrix: 3x3-Kameramatrix (CV_64F)
+		- @param distanceCoefficients: Verzeichnungskoeffizienten als Spaltenvektor (CV_64F)
+		- @param imageSize: Optional, Bildgröße der Kalibrierung (Size() wenn unbekannt)
+		- @param reprojectionError: Optional, RMS der Kalibrierung (negativ wenn unbekannt)
+		- @param return: True, wenn eine gültige Kalibrierung geladen wurde*/
+bool loadCalibrationFile(const std::string& name, cv::Mat& cameraMatrix, cv::Mat& distanceCoefficients,
+	cv::Size* imageSize = nullptr, double* reprojectionError = nullptr);
+
+/* importLegacyCalibration()-Funktion: Wandelt eine Datei im alten Textformat einmalig in das binäre Format um. Die
+   Textdatei bleibt unverändert
+		- @param legacyName: Name der Textdatei (z.B. "CameraCalibration")
+		- @param name: Name der binären Datei (z.B. "CameraCalibration.bin")
+		- @param imageSize: Bildgröße der Kalibrierung, falls bekannt (steht nicht in der Textdatei)
+		- @param return: True, wenn die Textdatei gültig war und die binäre Datei geschrieben werden konnte*/
+bool importLegacyCalibration(const std::string& legacyName, const std::string& name,
+	const cv::Size& imageSize = cv::Size());
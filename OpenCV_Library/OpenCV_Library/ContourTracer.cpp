@@ -0,0 +1,354 @@
+#include "ContourTracer.h"
+#include <cmath>
+
+using namespace std;
+using namespace cv;
+
+
+// Schritte der acht Richtungen (0 = rechts, gegen den Uhrzeigersinn im Bild) wie icvCodeDeltas in OpenCV
+static const Point directionSteps[8] = {
+	Point(1, 0), Point(1, -1), Point(0, -1), Point(-1, -1), Point(-1, 0), Point(-1, 1), Point(0, 1), Point(1, 1)
+};
+
+// Markierung verfolgter Ränder wie in findContours(): 2, am rechten Rand eines Bereichs 2 | -128
+static const schar borderMark = 2;
+static const schar rightBorderMark = (schar)(borderMark | -128);
+
+
+void ContourTracer::trace(const Mat& binary) {
+
+	CV_Assert(binary.type() == CV_8UC1);
+
+	const int width = binary.cols + 2;
+	const int height = binary.rows + 2;
+
+	step = width;
+	image.assign((size_t)width * height, 0);
+	points.clear();
+	starts.clear();
+
+	for (int y = 0; y < binary.rows; ++y) {
+
+		const uchar* src = binary.ptr<uchar>(y);
+		schar* dst = &image[(size_t)(y + 1) * step + 1];
+
+		for (int x = 0; x < binary.cols; ++x) {
+
+			dst[x] = src[x] != 0;
+		}
+	}
+
+	// Zeilenweise Suche nach dem Beginn äußerer Ränder (0 -> 1) und von Lochrändern (>= 1 -> 0), die Reihenfolge und
+	// die Bedingungen entsprechen cvFindNextContour()
+	for (int y = 1; y < height - 1; ++y) {
+
+		schar* row = &image[(size_t)y * step];
+		int previous = 0;
+
+		for (int x = 1; x < width - 1; ++x) {
+
+			const int pixel = row[x];
+
+			if (pixel == previous) {
+
+				continue;
+			}
+
+			if (previous == 0 && pixel == 1) {
+
+				fetchContour(y * step + x, Point(x - 1, y - 1), false);
+			}
+			else if (pixel == 0 && previous >= 1) {
+
+				fetchContour(y * step + x - 1, Point(x - 2, y - 1), true);
+			}
+
+			// Nach der Verfolgung zählt die Markierung des Startpixels
+			previous = row[x];
+		}
+	}
+
+	starts.push_back((int)points.size());
+}
+
+
+int ContourTracer::contourCount() const {
+
+	return (int)starts.size() - 1;
+}
+
+
+const Point* ContourTracer::contour(int index, int& length) const {
+
+	const int stored = contourCount() - 1 - index;
+
+	length = starts[stored + 1] - starts[stored];
+
+	return points.data() + starts[stored];
+}
+
+
+/* fetchContour()-Funktion: Folgt einem Rand ab seinem Startpixel und hängt alle Punkte an (wie icvFetchContour())
+		- @param offset: Index des Startpixels im Bild mit Rand
+		- @param origin: Koordinaten des Startpixels im Binärbild
+		- @param hole: True bei einem Lochrand*/
+void ContourTracer::fetchContour(int offset, Point origin, bool hole) {
+
+	// Indexabstände der acht Nachbarn, zweimal hintereinander für den Umlauf über Richtung 7 hinaus
+	const int deltas[16] = {
+		1, -step + 1, -step, -step - 1, -1, step - 1, step, step + 1,
+		1, -step + 1, -step, -step - 1, -1, step - 1, step, step + 1
+	};
+
+	schar* const start = &image[offset];
+	schar* second;
+	int direction = hole ? 0 : 4;
+	int end = direction;
+
+	starts.push_back((int)points.size());
+
+	// Ersten Nachbarn im Uhrzeigersinn suchen
+	do {
+
+		direction = (direction - 1) & 7;
+		second = start + deltas[direction];
+
+	} while (*second == 0 && direction != end);
+
+	// Einzelnes Pixel
+	if (direction == end) {
+
+		*start = rightBorderMark;
+		points.push_back(origin);
+		return;
+	}
+
+	schar* current = start;
+	schar* next = start;
+	Point point = origin;
+
+	for (;;) {
+
+		end = direction;
+
+		// Nächsten Nachbarn gegen den Uhrzeigersinn suchen
+		while (direction < 15) {
+
+			next = current + deltas[++direction];
+
+			if (*next != 0) {
+
+				break;
+			}
+		}
+
+		direction &= 7;
+
+		if ((unsigned)(direction - 1) < (unsigned)end) {
+
+			*current = rightBorderMark;
+		}
+		else if (*current == 1) {
+
+			*current = borderMark;
+		}
+
+		points.push_back(point);
+		point += directionSteps[direction];
+
+		if (next == start && current == second) {
+
+			break;
+		}
+
+		current = next;
+		direction = (direction + 4) & 7;
+	}
+}
+
+
+void ContourTracer::approximatePolygon(const Point* contour, int count, double epsilon, vector<Point>& polygon) {
+
+	// Ablauf wie approxPolyDP_() in OpenCV für eine geschlossene Kontur: zwei ungefähr entfernteste Punkte teilen die
+	// Kontur, jeder Abschnitt wird am weitesten entfernten Punkt geteilt, bis alle Punkte nah genug an der Sehne liegen
+	polygon.resize(count);
+
+	if (count == 0) {
+
+		return;
+	}
+
+	const double epsilonSquared = epsilon * epsilon;
+	Range slice(0, 0), rightSlice(0, 0);
+	Point startPoint, endPoint, point;
+	int position = 0;
+	int written = 0;
+	bool withinEpsilon = false;
+
+	slices.clear();
+
+	for (int iteration = 0; iteration < 3; ++iteration) {
+
+		double maxDistance = 0.0;
+
+		position = (position + rightSlice.start) % count;
+		startPoint = contour[position];
+
+		if (++position >= count) {
+
+			position = 0;
+		}
+
+		for (int j = 1; j < count; ++j) {
+
+			point = contour[position];
+
+			if (++position >= count) {
+
+				position = 0;
+			}
+
+			double dx = point.x - startPoint.x;
+			double dy = point.y - startPoint.y;
+			double distance = dx * dx + dy * dy;
+
+			if (distance > maxDistance) {
+
+				maxDistance = distance;
+				rightSlice.start = j;
+			}
+		}
+
+		withinEpsilon = maxDistance <= epsilonSquared;
+	}
+
+	if (!withinEpsilon) {
+
+		rightSlice.end = slice.start = position % count;
+		slice.end = rightSlice.start = (rightSlice.start + slice.start) % count;
+
+		slices.push_back(rightSlice);
+		slices.push_back(slice);
+	}
+	else {
+
+		polygon[written++] = startPoint;
+	}
+
+	while (!slices.empty()) {
+
+		slice = slices.back();
+		slices.pop_back();
+
+		endPoint = contour[slice.end];
+		position = slice.start;
+		startPoint = contour[position];
+
+		if (++position >= count) {
+
+			position = 0;
+		}
+
+		if (position != slice.end) {
+
+			double dx = endPoint.x - startPoint.x;
+			double dy = endPoint.y - startPoint.y;
+			double maxDistance = 0.0;
+
+			while (position != slice.end) {
+
+				point = contour[position];
+
+				if (++position >= count) {
+
+					position = 0;
+				}
+
+				double distance = fabs((point.y - startPoint.y) * dx - (point.x - startPoint.x) * dy);
+
+				if (distance > maxDistance) {
+
+					maxDistance = distance;
+					rightSlice.start = (position + count - 1) % count;
+				}
+			}
+
+			withinEpsilon = maxDistance * maxDistance <= epsilonSquared * (dx * dx + dy * dy);
+		}
+		else {
+
+			withinEpsilon = true;
+		}
+
+		if (withinEpsilon) {
+
+			polygon[written++] = startPoint;
+		}
+		else {
+
+			rightSlice.end = slice.end;
+			slice.end = rightSlice.start;
+
+			slices.push_back(rightSlice);
+			slices.push_back(slice);
+		}
+	}
+
+	// Punkte auf [fast] geraden Strecken entfernen, wie die abschließende Bereinigung in approxPolyDP_()
+	count = written;
+	position = count - 1;
+	startPoint = polygon[position];
+	position = 0;
+	int writePosition = position;
+	point = polygon[position];
+	position = count > 1 ? 1 : 0;
+
+	for (int i = 0; i < count && written > 2; ++i) {
+
+		endPoint = polygon[position];
+
+		if (++position >= count) {
+
+			position = 0;
+		}
+
+		double dx = endPoint.x - startPoint.x;
+		double dy = endPoint.y - startPoint.y;
+		double distance = fabs((point.x - startPoint.x) * dy - (point.y - startPoint.y) * dx);
+		double innerProduct = (point.x - startPoint.x) * (endPoint.x - point.x) +
+			(point.y - startPoint.y) * (endPoint.y - point.y);
+
+		if (distance * distance <= 0.5 * epsilonSquared * (dx * dx + dy * dy) && dx != 0 && dy != 0 &&
+			innerProduct >= 0) {
+
+			--written;
+			polygon[writePosition] = startPoint = endPoint;
+
+			if (++writePosition >= count) {
+
+				writePosition = 0;
+			}
+
+			point = polygon[position];
+
+			if (++position >= count) {
+
+				position = 0;
+			}
+
+			++i;
+			continue;
+		}
+
+		polygon[writePosition] = startPoint = point;
+
+		if (++writePosition >= count) {
+
+			writePosition = 0;
+		}
+
+		point = endPoint;
+	}
+
+	polygon.resize(written);
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+/* ContourTracer-Klasse: Konturverfolgung und Polygonannäherung der eigenen Kandidatensuche (FastMarkerDetector).
+   trace() folgt dem Verfahren von Suzuki, das findContours() mit RETR_LIST und CHAIN_APPROX_NONE verwendet, und
+   approximatePolygon() dem Douglas-Peucker-Verfahren von approxPolyDP() für geschlossene Konturen. Die Ergebnisse
+   sind dieselben, aber alle Puffer (Binärbild mit Rand, Konturpunkte, Stapel der Annäherung) gehören dem Objekt und
+   werden von Bild zu Bild wiederverwendet. findContours() legt dagegen bei jedem Aufruf eine Kopie des Bildes mit Rand,
+   seinen Konturspeicher und einen Vektor pro Kontur an, approxPolyDP() zwei Puffer pro Kontur*/
+class ContourTracer {
+
+public:
+
+	/* trace()-Funktion: Verfolgt alle Konturen des Binärbilds
+			- @param binary: Binärbild (CV_8UC1, alles ungleich 0 ist Vordergrund), bleibt unverändert*/
+	void trace(const cv::Mat& binary);
+
+	/* contourCount()-Funktion: Anzahl der Konturen des letzten trace()-Aufrufs*/
+	int contourCount() const;
+
+	/* contour()-Funktion: Liefert eine Kontur, in derselben Reihenfolge wie findContours() (zuletzt gefundene zuerst)
+			- @param index: 0 bis contourCount() - 1
+			- @param length: Ausgabe der Anzahl der Punkte
+			- @param return: Erster Punkt der Kontur, gültig bis zum nächsten trace()-Aufruf*/
+	const cv::Point* contour(int index, int& length) const;
+
+	/* approximatePolygon()-Funktion: Entspricht approxPolyDP() mit closed = true
+			- @param contour: Punkte der geschlossenen Kontur
+			- @param count: Anzahl der Punkte
+			- @param epsilon: Größter Abstand der Kontur vom Polygon
+			- @param polygon: Ausgabe der Ecken des Polygons*/
+	void approximatePolygon(const cv::Point* contour, int count, double epsilon, std::vector<cv::Point>& polygon);
+
+private:
+
+	void fetchContour(int offset, cv::Point origin, bool hole);
+
+	// Binärbild mit einem Pixel Rand (0 oder 1, verfolgte Ränder werden wie in findContours() markiert)
+	std::vector<cv::schar> image;
+	int step;
+
+	// Punkte aller Konturen hintereinander und der Beginn jeder Kontur (plus das Ende der letzten)
+	std::vector<cv::Point> points;
+	std::vector<int> starts;
+
+	// Stapel der noch zu teilenden Abschnitte der Annäherung
+	std::vector<cv::Range> slices;
+};
@@ -0,0 +1,641 @@
+#include "DetectorContext.h"
+#include "CalibrationFile.h"
+#include <string>
+#include <chrono>
+#include <new>
+#include <cstdlib>
+
+#ifdef _WIN32
+#include <malloc.h>
+#endif
+
+using namespace std;
+using namespace cv;
+
+// Länge des ArUco-Markers aus dem Lexikon in Metern DICT_4X4_50
+const float arucoSquareDimension = 0.132f;
+
+// Maximale Bildrate der Debug-Anzeige. Die Erkennung selbst läuft davon unabhängig mit voller Kamerarate
+const double debugViewFramesPerSecond = 15.0;
+
+
+DetectorContext::DetectorContext(const string& sourceUri, int flags)
+	: calibrationVersion(0), colorBufferValid(false), pipelineCalibrationVersion(-1), projectedCorners(4),
+	  rectifiedView(false), poseTracker(arucoSquareDimension), poseFiltering(true), poseBusActive(false), publishedSequence(0), detectionRunning(false) {
+
+	// Kameramatrix als 3x3
+	cameraMatrix = Mat::eye(3, 3, CV_64F);
+
+	source = createFrameSource(sourceUri,
+		(flags & INIT_LUMINANCE_CAPTURE) ? CAPTURE_FORMAT_LUMINANCE : CAPTURE_FORMAT_BGR);
+
+	// Erstellung des verwendeten Lexikons der ArUco-Marker (hier: DICT_4X4_50)
+	dictionary = aruco::getPredefinedDictionary(aruco::DICT_4X4_50);
+	markerDetector.setDictionary(dictionary);
+
+	// Die Puffer der Pipeline werden für die höchstens veröffentlichten Marker angelegt, damit sie im laufenden Betrieb
+	// nicht mehr wachsen müssen
+	markerIds.reserve(maxMarkers);
+	rotationVectors.reserve(maxMarkers);
+	translationVectors.reserve(maxMarkers);
+	trackedPoses.reserve(maxMarkers);
+	undistortedCornerPool.reserve(maxMarkers);
+
+	// Die Debug-Anzeige zeichnet in einem eigenen Thread auf einer Kopie des Bildes. Im Headless-Modus gibt es sie nicht.
+	// Jede Bildquelle bekommt ihr eigenes Fenster
+	if (!(flags & INIT_HEADLESS)) {
+
+		string windowName = sourceUri == "0" || sourceUri == "camera:0" ? "Webcam" : "Webcam " + sourceUri;
+
+		visualizer.reset(new Visualizer(windowName, debugViewFramesPerSecond));
+		visualizer->setStats(&stats);
+		visualizer->start();
+	}
+
+	if (flags & INIT_BACKGROUND_WORKER) {
+
+		startDetectionThread();
+	}
+}
+
+
+DetectorContext::~DetectorContext() {
+
+	stopDetectionThread();
+	visualizer.reset();
+}
+
+
+void* DetectorContext::operator new(size_t size) {
+
+#ifdef _WIN32
+	void* memory = _aligned_malloc(size, alignof(DetectorContext));
+#else
+	void* memory = nullptr;
+
+	if (posix_memalign(&memory, alignof(DetectorContext), size) != 0) {
+
+		memory = nullptr;
+	}
+#endif
+
+	if (!memory) {
+
+		throw bad_alloc();
+	}
+
+	return memory;
+}
+
+
+void DetectorContext::operator delete(void* memory) noexcept {
+
+#ifdef _WIN32
+	_aligned_free(memory);
+#else
+	free(memory);
+#endif
+}
+
+
+/* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei (nur binäres Format, siehe
+   CalibrationFile.h). Die Datei wird außerhalb der Sperre gelesen und geprüft, die Pipeline wartet
+   nur auf das Austauschen der Matrizen. Schlägt das Laden fehl, bleibt die bisherige Kalibrierung erhalten
+		- @param cameraCalibrationFileName: Name der zu ladenen Datei (const char* für C-Übersetzung)
+		- @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
+bool DetectorContext::loadCameraCalibration(const char* cameraCalibrationFileName) {
+
+	Mat loadedCameraMatrix, loadedDistanceCoefficients;
+
+	if (!cameraCalibrationFileName ||
+		!loadCalibrationFile(cameraCalibrationFileName, loadedCameraMatrix, loadedDistanceCoefficients)) {
+
+		return false;
+	}
+
+	// Die Pipeline darf die Matrizen nicht lesen, während sie ausgetauscht werden
+	lock_guard<mutex> lock(calibrationMutex);
+	swap(cameraMatrix, loadedCameraMatrix);
+	swap(distanceCoefficients, loadedDistanceCoefficients);
+	calibrationVersion++;
+
+	return true;
+}
+
+
+/* estimatePoseMarkerAndDetection()-Funktion: Durchführung der Posenschätzung der Marker und deren Erkennung.
+   Läuft der Detektions-Thread, wird nur das neueste fertige Ergebnis für die Getter übernommen (blockiert nie)
+		- @param return: -1 für einen Fehlschlag (auch am Ende einer Datei bzw. eines Ordners ohne Schleife, der
+						 Detektions-Thread hat sich dann beendet), 1 für eine Durchführung bzw. ein neues Ergebnis,
+						 0 wenn der Detektions-Thread seit dem letzten Aufruf kein neues Ergebnis hat*/
+int DetectorContext::estimatePoseMarkerAndDetection() {
+
+	// Acquire, damit nach dem Ende des Detektions-Threads alles sichtbar ist, was er zuletzt geschrieben hat
+	if (detectionRunning.load(memory_order_acquire)) {
+
+		return poseBuffer.update() ? 1 : 0;
+	}
+
+	int status = processNextFrame();
+
+	// Ergebnis auch im synchronen Modus über den Dreifachpuffer an die Getter weitergeben
+	poseBuffer.update();
+
+	return status;
+}
+
+
+/* startDetectionThread()-Funktion: Startet den Detektions-Thread. Danach blockiert estimatePoseMarkerAndDetection()
+   nicht mehr, sondern übernimmt nur noch das neueste fertige Ergebnis
+		- @param return: True, wenn der Thread läuft, false wenn die Bildquelle nicht geöffnet oder schon zu Ende ist*/
+bool DetectorContext::startDetectionThread() {
+
+	if (detectionRunning.load()) {
+
+		return true;
+	}
+
+	if (!source || !source->isOpened() || source->isFinished()) {
+
+		return false;
+	}
+
+	// Ein Thread, der sich am Ende der Bildquelle selbst beendet hat, muss noch abgeholt werden
+	if (detectionThread.joinable()) {
+
+		detectionThread.join();
+	}
+
+	detectionRunning.store(true);
+	detectionThread = thread(&DetectorContext::detectionLoop, this);
+
+	return true;
+}
+
+
+/* stopDetectionThread()-Funktion: Beendet den Detektions-Thread und wartet, bis das aktuelle Bild fertig bearbeitet ist*/
+void DetectorContext::stopDetectionThread() {
+
+	detectionRunning.store(false);
+
+	if (detectionThread.joinable()) {
+
+		detectionThread.join();
+	}
+}
+
+
+/* getResultSequence()-Funktion: Nummer des zuletzt veröffentlichten Ergebnisses. Ändert sie sich, liegt eine neue
+   Pose vor (0 = noch kein Ergebnis)
+		- @param return: Fortlaufende Nummer des letzten Ergebnisses*/
+unsigned long long DetectorContext::getResultSequence() const {
+
+	return publishedSequence.load(memory_order_acquire);
+}
+
+
+const PoseResult& DetectorContext::currentResult() const {
+
+	return poseBuffer.readBuffer();
+}
+
+
+/* getMarkerPoses()-Funktion: Kopiert alle Marker des aktuellen Ergebnisses in einen Array des Aufrufers
+		- @param poses: Array des Aufrufers, in den geschrieben wird (wird von der DLL nicht allokiert)
+		- @param capacity: Anzahl der Elemente in poses. Es werden höchstens so viele Marker geschrieben
+		- @param return: Anzahl der erkannten Marker. Ist sie größer als capacity, war der Array zu klein und es wurden nur
+						 die ersten capacity Marker geschrieben*/
+int DetectorContext::getMarkerPoses(MarkerPose* poses, int capacity) const {
+
+	const PoseResult& result = poseBuffer.readBuffer();
+
+	int count = min(result.markerCount, capacity);
+
+	for (int i = 0; i < count; ++i) {
+
+		poses[i] = result.markers[i];
+	}
+
+	return result.markerCount;
+}
+
+
+/* getExtrapolatedMarkerPoses()-Funktion: Wie getMarkerPoses(), aber jede Pose wird mit der Geschwindigkeit ihrer
+   Spur vom Aufnahmezeitpunkt auf einen Zeitpunkt des Aufrufers fortgeschrieben (z.B. den Zeitpunkt, zu dem das
+   nächste Bild angezeigt wird). So wird die Zeit zwischen Aufnahme und Anzeige ausgeglichen. Fortgeschrieben wird
+   höchstens PoseTracker::maxPredictionTime weit, nie in die Vergangenheit
+		- @param targetTimestamp: Gewünschter Zeitpunkt in Mikrosekunden (monotonicMicroseconds())
+		- @param poses: Array des Aufrufers, in den geschrieben wird
+		- @param capacity: Anzahl der Elemente in poses
+		- @param return: Anzahl der Marker des aktuellen Ergebnisses (wie bei getMarkerPoses())*/
+int DetectorContext::getExtrapolatedMarkerPoses(long long targetTimestamp, MarkerPose* poses, int capacity) const {
+
+	const PoseResult& result = poseBuffer.readBuffer();
+
+	int count = min(result.markerCount, capacity);
+
+	for (int i = 0; i < count; ++i) {
+
+		const MarkerMotion& motion = result.motions[i];
+
+		poses[i] = result.markers[i];
+
+		long long ahead = min(max(targetTimestamp - poses[i].captureTimestamp, 0LL), PoseTracker::maxPredictionTime);
+		double dt = ahead * 1e-6;
+
+		for (int k = 0; k < 3; ++k) {
+
+			poses[i].rotationVector[k] += motion.rotationVelocity[k] * dt;
+			poses[i].translationVector[k] += motion.translationVelocity[k] * dt;
+		}
+
+		poses[i].flags |= MARKER_POSE_EXTRAPOLATED;
+	}
+
+	return result.markerCount;
+}
+
+
+/* getResultCaptureTimestamp()-Funktion: Aufnahmezeitpunkt des aktuellen Ergebnisses, auch wenn es keine Marker enthält.
+   Die Differenz zu monotonicMicroseconds() ist das Alter des Ergebnisses
+		- @param return: Zeitpunkt in Mikrosekunden (monotone Uhr), 0 wenn es noch kein Ergebnis gibt*/
+long long DetectorContext::getResultCaptureTimestamp() const {
+
+	return poseBuffer.readBuffer().captureTimestamp;
+}
+
+
+FrameExport& DetectorContext::frameExport() {
+
+	return exportedFrames;
+}
+
+
+bool DetectorContext::startPoseBus(const string& name) {
+
+	// Ein Bus gehört genau einem Publisher, der laufende Bus dieses Kontexts gibt seinen Namen deshalb zuerst frei
+	stopPoseBus();
+
+	unique_ptr<PoseBusPublisher> publisher(new PoseBusPublisher());
+
+	if (!publisher->open(name)) {
+
+		return false;
+	}
+
+	lock_guard<mutex> lock(poseBusMutex);
+	poseBus = move(publisher);
+	poseBusActive.store(true, memory_order_relaxed);
+
+	return true;
+}
+
+
+void DetectorContext::stopPoseBus() {
+
+	unique_ptr<PoseBusPublisher> publisher;
+
+	{
+		lock_guard<mutex> lock(poseBusMutex);
+		poseBusActive.store(false, memory_order_relaxed);
+		publisher = move(poseBus);
+	}
+
+	// Der Speicher wird erst außerhalb der Sperre freigegeben, damit die Pipeline nicht darauf wartet
+}
+
+
+MarkerDetector& DetectorContext::detector() {
+
+	return markerDetector;
+}
+
+
+/* getStats()-Funktion: Laufzeiten der Stufen (p50/p95/p99/max über die letzten Bilder) und Zähler der Pipeline
+		- @param stats: Struktur des Aufrufers, in die geschrieben wird*/
+void DetectorContext::getStats(DetectorStats& stats) const {
+
+	this->stats.snapshot(stats);
+}
+
+
+/* resetStats()-Funktion: Verwirft alle bisherigen Messungen, z.B. nach dem Aufwärmen (nur bei gestopptem
+   Detektions-Thread aufrufen)*/
+void DetectorContext::resetStats() {
+
+	stats.reset();
+}
+
+
+/* setStatsDumpFile()-Funktion: Schreibt die Statistik regelmäßig als CSV-Zeile in eine Datei
+		- @param path: Pfad der Datei, nullptr oder "" beendet das Schreiben
+		- @param intervalMilliseconds: Abstand zwischen zwei Zeilen
+		- @param return: False, wenn die Datei nicht geöffnet werden konnte*/
+bool DetectorContext::setStatsDumpFile(const char* path, int intervalMilliseconds) {
+
+	return stats.setDumpFile(path, intervalMilliseconds);
+}
+
+
+void DetectorContext::setRectifiedView(bool enabled) {
+
+	rectifiedView.store(enabled, memory_order_relaxed);
+}
+
+
+void DetectorContext::setPoseFiltering(bool enabled) {
+
+	poseFiltering.store(enabled, memory_order_relaxed);
+}
+
+
+/* refreshCalibration()-Funktion: Übernimmt eine neue Kalibrierung in die Pipeline, falls loadCameraCalibration()
+   inzwischen aufgerufen wurde. Ohne Änderung kostet der Aufruf nur das Lesen eines atomaren Zählers*/
+void DetectorContext::refreshCalibration() {
+
+	if (pipelineCalibrationVersion == calibrationVersion.load(memory_order_acquire)) {
+
+		return;
+	}
+
+	lock_guard<mutex> lock(calibrationMutex);
+	cameraMatrix.copyTo(pipelineCameraMatrix);
+	distanceCoefficients.copyTo(pipelineDistanceCoefficients);
+	pipelineCalibrationVersion = calibrationVersion.load(memory_order_relaxed);
+
+	// Mit der alten Kalibrierung geschätzte Posen passen nicht zu den neuen Messungen
+	poseTracker.reset();
+
+	// Die Brennweite bestimmt, wie groß ein Marker im Bild erscheint (automatische Skalierung der Kandidatensuche)
+	if (pipelineCameraMatrix.rows == 3 && pipelineCameraMatrix.cols == 3) {
+
+		markerDetector.setMarkerGeometry(pipelineCameraMatrix.at<double>(0, 0), arucoSquareDimension);
+	}
+}
+
+
+/* processNextFrame()-Funktion: Ein Durchlauf der Pipeline: Bild aufnehmen, Marker erkennen, Pose schätzen, Ergebnis
+   veröffentlichen und (falls aktiv) an die Debug-Anzeige übergeben
+		- @param return: -1 wenn kein Bild gelesen werden konnte, sonst 1*/
+int DetectorContext::processNextFrame() {
+
+	// Wenn die Bildquelle nicht geöffnet werden kann, dann return -1
+	if (!source->isOpened()) {
+
+		return -1;
+	}
+
+	// Aufnahme in zwei Schritten, damit Warten auf die Kamera (grab()) und Dekodieren (retrieve()) getrennt gemessen
+	// werden. Falls das Videobild der Kamera nicht gelesen werden kann, dann return -1
+	STATS_TIMESTAMP(captureStart);
+
+	if (!source->grab()) {
+
+		STATS_COUNT(stats, COUNTER_CAPTURE_FAILURES);
+		return -1;
+	}
+
+	long long captureTimestamp = monotonicMicroseconds();
+	STATS_RECORD(stats, STAGE_CAPTURE_WAIT, captureStart);
+
+	if (!source->retrieve(frame)) {
+
+		STATS_COUNT(stats, COUNTER_CAPTURE_FAILURES);
+		return -1;
+	}
+
+	STATS_RECORD(stats, STAGE_DECODE, captureTimestamp);
+	STATS_COUNT(stats, COUNTER_FRAMES_CAPTURED);
+
+	// Ein Farbbild wandelt die Erkennung erst in ein Graubild um (3 bzw. 4 Bytes lesen, 1 Byte schreiben pro Pixel)
+	STATS_ADD(stats, COUNTER_INGESTED_BYTES, source->touchedBytes() +
+		(frame.channels() == 1 ? 0 : (long long)frame.total() * (frame.channels() + 1)));
+	colorBufferValid = false;
+
+	refreshCalibration();
+
+	// Nur bei neuer Kalibrierung oder Bildgröße werden die Tabellen neu gebaut
+	undistortionCache.update(pipelineCameraMatrix, pipelineDistanceCoefficients, pipelineCalibrationVersion, frame.size());
+
+	/* detect()-Funktion: Grundlegende Markererkennung (aruco::detectMarkers()), im Verfolgungsmodus nur in Ausschnitten
+	   um die Marker des letzten Bildes
+				- @param frame: Eingabebild (Webcam)
+				- @param markerCorners: Vektor der erkannten Marker-Ecken. Für N erkannte Marker sind die Dimensionen des Arrays Nx4
+				- @param markerIds: Vektor der Identifikationen der erkannten Markierungen. Für N erkannte Marker ist die Dimension
+									des Arrays N
+				- @param return: Weg der Erkennung (DETECTION_PATH_FULL oder DETECTION_PATH_ROI)*/
+	STATS_TIMESTAMP(detectStart);
+	int detectionPath = markerDetector.detect(frame, markerCorners, markerIds);
+	STATS_RECORD(stats, STAGE_DETECT_MARKERS, detectStart);
+
+
+	/* track()-Funktion: Posenschätzung für einzelne Marker. Bekannte Marker werden von der Vorhersage ihrer Spur aus
+	   gelöst und geglättet, nicht erkannte Marker für kurze Zeit vorhergesagt
+				- @param captureTimestamp: Aufnahmezeitpunkt, aus dem Abstand zum letzten Bild wird die Bewegung fortgeschrieben
+				- @param undistortedCorners: Vektor der bereits erkannten und über die Tabelle entzerrten Markerecken
+				- @param idealCameraMatrix(): Die zuvor bestimmte intrinsische Kameramatrix
+				- @param noDistortion(): Keine Abstandskoeffizienten, da die Ecken bereits entzerrt sind
+				- @param rotationVectors: Ausgabearray der gemessenen Rotationsvektoren (für Debug-Anzeige und Rückprojektion)
+				- @param translationVectors: Ausgabearray der gemessenen Translationsvektoren in Metern
+				- @param trackedPoses: Geglättete und vorhergesagte Posen, die veröffentlicht werden*/
+	STATS_TIMESTAMP(poseStart);
+
+	// Bei unveränderter Szene sind Ecken, gemessene Posen und Spuren noch die des letzten erkannten Bildes. Das Ergebnis
+	// wird nur mit dem neuen Aufnahmezeitpunkt wiederholt
+	if (detectionPath == DETECTION_PATH_SKIPPED) {
+
+		poseTracker.hold(captureTimestamp);
+		STATS_COUNT(stats, COUNTER_FRAMES_SKIPPED);
+	}
+	else {
+
+		undistortionCache.undistortCorners(markerCorners, undistortedCorners, undistortedCornerPool);
+		poseTracker.setFiltering(poseFiltering.load(memory_order_relaxed));
+		poseTracker.track(captureTimestamp, markerIds, undistortedCorners, undistortionCache.idealCameraMatrix(),
+			undistortionCache.noDistortion(), rotationVectors, translationVectors, trackedPoses);
+	}
+
+	publishPoseResult(captureTimestamp, detectionPath);
+	STATS_RECORD(stats, STAGE_ESTIMATE_POSE, poseStart);
+
+	// Das Bild wird erst nach der Pose umgewandelt, damit der Export die Latenz der Pose nicht erhöht. Über die Nummer
+	// des Ergebnisses kann der Aufrufer Bild und Pose einander zuordnen
+	exportedFrames.write(exportedFrames.getFormat() == FRAME_EXPORT_RGBA ? colorFrame() : frame,
+		publishedSequence.load(memory_order_relaxed), captureTimestamp);
+
+	// Gezeichnet und angezeigt wird nur in der Debug-Anzeige auf einer Kopie des Bildes, nie im Headless-Modus.
+	// In der entzerrten Ansicht wird das Bild dort mit den Karten des Caches entzerrt
+	if (visualizer && visualizer->isDue()) {
+
+		if (rectifiedView.load(memory_order_relaxed) &&
+			undistortionCache.rectificationMaps(rectificationMap1, rectificationMap2)) {
+
+			visualizer->submit(colorFrame(), markerIds, undistortedCorners, rotationVectors, translationVectors,
+				undistortionCache.idealCameraMatrix(), undistortionCache.noDistortion(), rectificationMap1,
+				rectificationMap2);
+		}
+		else {
+
+			visualizer->submit(colorFrame(), markerIds, markerCorners, rotationVectors, translationVectors,
+				pipelineCameraMatrix, pipelineDistanceCoefficients);
+		}
+	}
+
+	return 1;
+}
+
+
+/* colorFrame()-Funktion: Farbbild des aktuellen Bildes für Debug-Anzeige und Export. Im Format CAPTURE_FORMAT_BGR ist
+   das frame selbst, im Helligkeitsformat wird es beim ersten Aufruf pro Bild aus den Rohdaten der Quelle umgewandelt
+		- @param return: Farbbild bzw. das Graubild, falls die Quelle nicht umwandeln konnte*/
+const Mat& DetectorContext::colorFrame() {
+
+	if (source->getCaptureFormat() != CAPTURE_FORMAT_LUMINANCE) {
+
+		return frame;
+	}
+
+	if (!colorBufferValid) {
+
+		colorBufferValid = source->retrieveColor(colorBuffer);
+		STATS_ADD(stats, COUNTER_INGESTED_BYTES, source->touchedBytes());
+	}
+
+	return colorBufferValid ? colorBuffer : frame;
+}
+
+
+/* computeReprojectionError()-Funktion: Projiziert die Markerecken mit der geschätzten Pose zurück ins Bild und
+   vergleicht sie mit den erkannten Ecken. Beides geschieht wie bei der Posenschätzung in entzerrten Pixelkoordinaten
+		- @param undistorted: Die 4 erkannten und entzerrten Markerecken
+		- @param rVec: Geschätzter Rotationsvektor
+		- @param tVec: Geschätzter Translationsvektor
+		- @param return: RMS-Abstand der Ecken in Pixeln*/
+double DetectorContext::computeReprojectionError(const vector<Point2f>& undistorted, const Vec3d& rVec, const Vec3d& tVec) {
+
+	poseTracker.projectMarker(rVec, tVec, undistortionCache.idealCameraMatrix(), undistortionCache.noDistortion(),
+		projectedCorners);
+
+	double squaredError = 0.0;
+
+	for (int c = 0; c < 4; ++c) {
+
+		Point2f difference = undistorted[c] - projectedCorners[c];
+		squaredError += difference.x * difference.x + difference.y * difference.y;
+	}
+
+	return sqrt(squaredError / 4.0);
+}
+
+
+/* publishPoseResult()-Funktion: Schreibt die verfolgten Marker in den Back-Puffer und veröffentlicht ihn. Für
+   vorhergesagte Marker werden die Ecken aus der vorhergesagten Pose ins aufgenommene Bild projiziert. Bei
+   unveränderter Szene (DETECTION_PATH_SKIPPED) werden nur die gemessenen Marker ohne Bewegung wiederholt
+		- @param captureTimestamp: Aufnahmezeitpunkt des Bildes in Mikrosekunden (monotonicMicroseconds())
+		- @param detectionPath: Weg der Erkennung (DETECTION_PATH_FULL oder DETECTION_PATH_ROI)*/
+void DetectorContext::publishPoseResult(long long captureTimestamp, int detectionPath) {
+
+	PoseResult& result = poseBuffer.writeBuffer();
+
+	result.detectionPath = detectionPath;
+	result.captureTimestamp = captureTimestamp;
+	result.markerCount = 0;
+
+	bool skipped = detectionPath == DETECTION_PATH_SKIPPED;
+
+	for (size_t t = 0; t < trackedPoses.size() && result.markerCount < maxMarkers; ++t) {
+
+		const TrackedPose& tracked = trackedPoses[t];
+		int measured = tracked.measurementIndex;
+
+		if (skipped && measured < 0) {
+
+			continue;
+		}
+
+		int i = result.markerCount++;
+		MarkerPose& pose = result.markers[i];
+
+		pose.id = tracked.id;
+		pose.flags = measured < 0 ? MARKER_POSE_PREDICTED : 0;
+
+		for (int k = 0; k < 3; ++k) {
+
+			pose.rotationVector[k] = tracked.rotationVector[k];
+			pose.translationVector[k] = tracked.translationVector[k];
+			result.motions[i].rotationVelocity[k] = skipped ? 0.0 : tracked.rotationVelocity[k];
+			result.motions[i].translationVelocity[k] = skipped ? 0.0 : tracked.translationVelocity[k];
+		}
+
+		if (measured < 0) {
+
+			poseTracker.projectMarker(tracked.rotationVector, tracked.translationVector, pipelineCameraMatrix,
+				pipelineDistanceCoefficients, projectedCorners);
+		}
+
+		const vector<Point2f>& corners = measured < 0 ? projectedCorners : markerCorners[measured];
+
+		for (int c = 0; c < 4; ++c) {
+
+			pose.corners[2 * c] = corners[c].x;
+			pose.corners[2 * c + 1] = corners[c].y;
+		}
+
+		pose.reprojectionError = measured < 0 ? -1.0 :
+			computeReprojectionError(undistortedCorners[measured], rotationVectors[measured], translationVectors[measured]);
+		pose.captureTimestamp = captureTimestamp;
+	}
+
+	result.sequence = publishedSequence.load(memory_order_relaxed) + 1;
+	STATS_RECORD(stats, STAGE_CAPTURE_TO_PUBLISH, captureTimestamp);
+
+	// Der Bus bekommt dieselben Posen wie der Dreifachpuffer, solange der Back-Puffer noch der Pipeline gehört
+	if (poseBusActive.load(memory_order_relaxed)) {
+
+		lock_guard<mutex> lock(poseBusMutex);
+
+		if (poseBus) {
+
+			poseBus->publish(result.sequence, detectionPath, captureTimestamp, result.markers, result.markerCount);
+		}
+	}
+
+	bool dropped = poseBuffer.publish();
+	publishedSequence.store(result.sequence, memory_order_release);
+
+	STATS_COUNT(stats, COUNTER_FRAMES_PROCESSED);
+
+	if (!markerIds.empty()) {
+
+		STATS_COUNT(stats, COUNTER_FRAMES_WITH_MARKERS);
+	}
+
+	if (dropped) {
+
+		STATS_COUNT(stats, COUNTER_DROPPED_RESULTS);
+	}
+}
+
+
+/* detectionLoop()-Funktion: Schleife des Detektions-Threads. Nimmt Bilder auf, erkennt die Marker, schätzt deren Pose
+   und veröffentlicht das Ergebnis über den Dreifachpuffer. Gezeichnet wird nur in der Debug-Anzeige. Am Ende einer
+   Datei bzw. eines Ordners ohne Schleife beendet sich der Thread selbst*/
+void DetectorContext::detectionLoop() {
+
+	while (detectionRunning.load(memory_order_relaxed)) {
+
+		if (processNextFrame() >= 0) {
+
+			continue;
+		}
+
+		if (source->isFinished()) {
+
+			detectionRunning.store(false, memory_order_release);
+			break;
+		}
+
+		// Falls das Videobild nicht gelesen werden kann, kurz warten und erneut versuchen
+		this_thread::sleep_for(chrono::milliseconds(10));
+	}
+}
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <string>
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+#include "TripleBuffer.h"
+#include "MarkerPose.h"
+#include "MarkerDetector.h"
+#include "Visualizer.h"
+#include "PipelineStats.h"
+#include "FrameSource.h"
+#include "UndistortionCache.h"
+#include "PoseTracker.h"
+#include "FrameExport.h"
+#include "PoseBusPublisher.h"
+
+// Flags für initializeEx() bzw. initializeContext():
+//		- INIT_BACKGROUND_WORKER: Startet direkt den Detektions-Thread, der Aufnahme und Erkennung im Hintergrund durchführt
+//		- INIT_HEADLESS: Kein Zeichnen und keine HighGUI-Fenster (Produktivbetrieb, kein GUI-Backend nötig)
+//		- INIT_LUMINANCE_CAPTURE: Die Bildquelle liefert nur die Helligkeit (CAPTURE_FORMAT_LUMINANCE), das Farbbild wird
+//		  nur für Debug-Anzeige und RGBA-Export umgewandelt
+const int INIT_BACKGROUND_WORKER = 1;
+const int INIT_HEADLESS = 2;
+const int INIT_LUMINANCE_CAPTURE = 4;
+
+// Maximale Anzahl an Markern pro Ergebnis (Größe des Lexikons DICT_4X4_50)
+const int maxMarkers = 50;
+
+// Geschwindigkeit eines Markers zum Aufnahmezeitpunkt (rad/s bzw. m/s), aus der Spur des PoseTrackers
+struct MarkerMotion {
+
+	double rotationVelocity[3];
+	double translationVelocity[3];
+};
+
+// Ergebnis einer Erkennung mit fester Größe, damit beim Veröffentlichen nichts allokiert werden muss
+struct PoseResult {
+
+	// Fortlaufende Nummer des Ergebnisses (0 = noch kein Ergebnis)
+	unsigned long long sequence = 0;
+
+	// Weg der Erkennung für dieses Bild (DETECTION_PATH_FULL oder DETECTION_PATH_ROI)
+	int detectionPath = DETECTION_PATH_FULL;
+
+	// Aufnahmezeitpunkt des Bildes in Mikrosekunden (monotonicMicroseconds(), 0 = noch kein Ergebnis)
+	long long captureTimestamp = 0;
+
+	int markerCount = 0;
+	MarkerPose markers[maxMarkers];
+
+	// Geschwindigkeiten in derselben Reihenfolge wie markers, für getExtrapolatedMarkerPoses()
+	MarkerMotion motions[maxMarkers];
+};
+
+/* DetectorContext-Klasse: Alles, was für eine Kamera gebraucht wird: Bildquelle, Kalibrierung, Markererkennung,
+   Debug-Anzeige, Ergebnispuffer und der eigene Detektions-Thread. Mehrere Kontexte sind voneinander unabhängig und
+   können parallel laufen (eine Kamera pro Kontext, jeder Kontext auf seinem eigenen Thread).
+   Die Ergebnisse werden von genau einem Leser-Thread abgeholt (estimatePoseMarkerAndDetection() und die Getter)*/
+class DetectorContext {
+
+public:
+
+	/* DetectorContext()-Konstruktor: Öffnet die Bildquelle und legt das Lexikon an
+			- @param sourceUri: Bildquelle, siehe createFrameSource() (z.B. "0" für die Standard-Webcam)
+			- @param flags: Kombination der INIT_*-Flags*/
+	DetectorContext(const std::string& sourceUri, int flags);
+	~DetectorContext();
+
+	DetectorContext(const DetectorContext&) = delete;
+	DetectorContext& operator=(const DetectorContext&) = delete;
+
+	/* operator new()-Funktion: Der Ergebnispuffer ist auf Cache-Lines ausgerichtet (alignas(64) in TripleBuffer.h).
+	   Vor C++17 beachtet das globale new diese Ausrichtung nicht, deshalb legt der Kontext sich selbst ausgerichtet an
+			- @param size: Größe des Objekts
+			- @param return: Auf alignof(DetectorContext) ausgerichteter Speicher*/
+	static void* operator new(std::size_t size);
+	static void operator delete(void* memory) noexcept;
+
+	bool loadCameraCalibration(const char* cameraCalibrationFileName);
+
+	int estimatePoseMarkerAndDetection();
+
+	bool startDetectionThread();
+	void stopDetectionThread();
+
+	unsigned long long getResultSequence() const;
+
+	/* currentResult()-Funktion: Das zuletzt mit estimatePoseMarkerAndDetection() übernommene Ergebnis
+			- @param return: Referenz auf den Front-Puffer (nur im Leser-Thread verwenden)*/
+	const PoseResult& currentResult() const;
+
+	int getMarkerPoses(MarkerPose* poses, int capacity) const;
+	int getExtrapolatedMarkerPoses(long long targetTimestamp, MarkerPose* poses, int capacity) const;
+	long long getResultCaptureTimestamp() const;
+
+	MarkerDetector& detector();
+
+	void getStats(DetectorStats& stats) const;
+	void resetStats();
+	bool setStatsDumpFile(const char* path, int intervalMilliseconds);
+
+	/* setRectifiedView()-Funktion: Zeigt in der Debug-Anzeige das entzerrte Bild (mit entzerrten Ecken und Achsen)
+			- @param enabled: True für das entzerrte Bild, false für das aufgenommene Bild*/
+	void setRectifiedView(bool enabled);
+
+	/* setPoseFiltering()-Funktion: Schaltet die Verfolgung der Posen über die Bilder ein oder aus (siehe PoseTracker)
+			- @param enabled: True für Warmstart, Glättung und Vorhersage nicht erkannter Marker, false für Einzelposen*/
+	void setPoseFiltering(bool enabled);
+
+	/* frameExport()-Funktion: Doppelpuffer, über den das Kamerabild an den Aufrufer weitergegeben wird
+			- @param return: Referenz auf den Export (setFormat() aus jedem Thread, acquire()/release() nur im Leser-Thread)*/
+	FrameExport& frameExport();
+
+	/* startPoseBus()-Funktion: Veröffentlicht ab dem nächsten Bild jedes Ergebnis zusätzlich im gemeinsamen Speicher,
+	   damit andere lokale Prozesse die Posen lesen können (siehe PoseBusPublisher). Ein schon laufender Bus dieses
+	   Kontexts wird vorher beendet
+			- @param name: Name des Busses
+			- @param return: False, wenn der gemeinsame Speicher nicht angelegt werden konnte oder ein anderer Kontext bzw.
+							 Prozess den Bus schon beschreibt*/
+	bool startPoseBus(const std::string& name);
+	void stopPoseBus();
+
+private:
+
+	int processNextFrame();
+	void refreshCalibration();
+	void publishPoseResult(long long captureTimestamp, int detectionPath);
+	double computeReprojectionError(const std::vector<cv::Point2f>& undistorted, const cv::Vec3d& rVec, const cv::Vec3d& tVec);
+	const cv::Mat& colorFrame();
+	void detectionLoop();
+
+	// Bildquelle (Webcam, Videodatei, Bildordner oder synthetisch)
+	std::unique_ptr<FrameSource> source;
+
+	// ArUco-Lexikon-Objekt
+	cv::Ptr<cv::aruco::Dictionary> dictionary;
+
+	// Markererkennung mit Verfolgung der bekannten Marker in Bildausschnitten
+	MarkerDetector markerDetector;
+
+	// Laufzeiten der Stufen und Zähler der Pipeline
+	PipelineStats stats;
+
+	// Debug-Anzeige der erkannten Marker (nullptr im Headless-Modus)
+	std::unique_ptr<Visualizer> visualizer;
+
+	// Geladene Kalibrierung. calibrationMutex schützt sie, während die Pipeline sich eine Kopie davon holt.
+	// calibrationVersion wird bei jedem Laden erhöht, damit nur bei Änderungen kopiert werden muss
+	std::mutex calibrationMutex;
+	cv::Mat cameraMatrix, distanceCoefficients;
+	std::atomic<int> calibrationVersion;
+
+	// Arbeitsdaten der Pipeline. Sie gehören entweder dem Detektions-Thread oder dem synchronen Aufrufer, nie beiden.
+	// Im Format CAPTURE_FORMAT_LUMINANCE ist frame das Graubild und colorBuffer das bei Bedarf umgewandelte Farbbild
+	cv::Mat frame;
+	cv::Mat colorBuffer;
+	bool colorBufferValid;
+	std::vector<int> markerIds;
+	std::vector<std::vector<cv::Point2f>> markerCorners;
+	std::vector<cv::Vec3d> rotationVectors, translationVectors;
+	cv::Mat pipelineCameraMatrix, pipelineDistanceCoefficients;
+	int pipelineCalibrationVersion;
+	std::vector<cv::Point2f> projectedCorners;
+
+	// Tabellen zum Entzerren der Ecken (werden bei neuer Kalibrierung oder Bildgröße neu gebaut) und die entzerrten
+	// Ecken, mit denen die Pose geschätzt wird (mit eigenem Pool, damit ihre Vektoren nicht neu angelegt werden)
+	UndistortionCache undistortionCache;
+	std::vector<std::vector<cv::Point2f>> undistortedCorners;
+	CornerPool undistortedCornerPool;
+	cv::Mat rectificationMap1, rectificationMap2;
+	std::atomic<bool> rectifiedView;
+
+	// Spuren der Marker (Warmstart, Glättung, Vorhersage) und die daraus veröffentlichten Posen
+	PoseTracker poseTracker;
+	std::vector<TrackedPose> trackedPoses;
+	std::atomic<bool> poseFiltering;
+
+	// Kamerabild für den Aufrufer (z.B. als Hintergrund in Unity), wird nach dem Veröffentlichen der Pose umgewandelt
+	FrameExport exportedFrames;
+
+	// Posen-Bus für andere Prozesse. Der Speicher wird im aufrufenden Thread angelegt und nur unter poseBusMutex an die
+	// Pipeline übergeben, poseBusActive erspart der Pipeline ohne Bus das Sperren
+	std::mutex poseBusMutex;
+	std::unique_ptr<PoseBusPublisher> poseBus;
+	std::atomic<bool> poseBusActive;
+
+	// Dreifachpuffer zwischen Pipeline (Schreiber) und den Getter-Funktionen (Leser)
+	TripleBuffer<PoseResult> poseBuffer;
+	std::atomic<unsigned long long> publishedSequence;
+
+	// Detektions-Thread und Flag, ob er laufen soll
+	std::thread detectionThread;
+	std::atomic<bool> detectionRunning;
+};
@@ -0,0 +1,535 @@
+#include "FastMarkerDetector.h"
+#include "ImageKernels.h"
+#include <algorithm>
+#include <cfloat>
+#include <climits>
+#include <cmath>
+#include <opencv2/imgproc.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+// Bits pro Markerseite der unterstützten Lexika
+static const int markerSize = 4;
+
+
+FastMarkerDetector::FastMarkerDetector()
+	: active(false), integralThreshold(false) {
+}
+
+
+bool FastMarkerDetector::setDictionary(const Ptr<aruco::Dictionary>& arucoDictionary) {
+
+	active = !arucoDictionary.empty() && dictionary.load(*arucoDictionary);
+
+	return active;
+}
+
+
+bool FastMarkerDetector::isActive() const {
+
+	return active;
+}
+
+
+void FastMarkerDetector::detect(const Mat& image, const aruco::DetectorParameters& parameters,
+	vector<vector<Point2f>>& corners, vector<int>& ids, CornerPool& cornerPool) {
+
+	cornerPool.resize(corners, 0);
+	ids.clear();
+
+	gray = workspaceImage(grayBuffer, image.size(), CV_8UC1);
+	convertToGray(image, gray);
+
+	findCandidates(parameters);
+	removeCloseCandidates(parameters);
+
+	if (candidates.empty()) {
+
+		return;
+	}
+
+	identifyCandidates(parameters, corners, ids, cornerPool);
+}
+
+
+void FastMarkerDetector::findCandidates(const aruco::DetectorParameters& parameters) {
+
+	int scaleCount = 1;
+
+	if (parameters.adaptiveThreshWinSizeStep > 0) {
+
+		scaleCount = max((parameters.adaptiveThreshWinSizeMax - parameters.adaptiveThreshWinSizeMin) /
+			parameters.adaptiveThreshWinSizeStep + 1, 1);
+	}
+
+	// Ein Integralbild für alle Fenstergrößen statt eines Boxfilters pro Fenstergröße
+	integralThreshold = canUseIntegralThreshold(gray.size());
+
+	if (integralThreshold) {
+
+		integralImage = workspaceImage(integralBuffer, Size(gray.cols + 1, gray.rows + 1), CV_32SC1);
+		integral(gray, integralImage, CV_32S);
+	}
+
+	scales.resize(scaleCount);
+
+	// Wie bei detectMarkers() laufen die Fenstergrößen parallel, jede schreibt nur in ihre eigenen Puffer
+	parallel_for_(Range(0, scaleCount), [&](const Range& range) {
+
+		for (int scale = range.start; scale < range.end; ++scale) {
+
+			findCandidatesAtScale(parameters, scale);
+		}
+	});
+
+	candidates.clear();
+
+	for (const ScaleWorkspace& workspace : scales) {
+
+		candidates.insert(candidates.end(), workspace.candidates.begin(), workspace.candidates.end());
+	}
+}
+
+
+void FastMarkerDetector::findCandidatesAtScale(const aruco::DetectorParameters& parameters, int scale) {
+
+	int windowSize = parameters.adaptiveThreshWinSizeMin + scale * parameters.adaptiveThreshWinSizeStep;
+
+	// adaptiveThreshold() braucht eine ungerade Fenstergröße >= 3
+	windowSize = max(windowSize | 1, 3);
+
+	ScaleWorkspace& workspace = scales[scale];
+	vector<Candidate>& found = workspace.candidates;
+	vector<Point>& approxCurve = workspace.approxCurve;
+
+	found.clear();
+
+	workspace.threshold = workspaceImage(workspace.thresholdBuffer, gray.size(), CV_8UC1);
+	Mat& threshold = workspace.threshold;
+
+	if (integralThreshold) {
+
+		boxThreshold(gray, integralImage, windowSize, parameters.adaptiveThreshConstant, threshold);
+	}
+	else {
+
+		adaptiveThreshold(gray, threshold, 255, ADAPTIVE_THRESH_MEAN_C, THRESH_BINARY_INV, windowSize,
+			parameters.adaptiveThreshConstant);
+	}
+
+	int maxDimension = max(gray.cols, gray.rows);
+	int minPerimeter = (int)(parameters.minMarkerPerimeterRate * maxDimension);
+	int maxPerimeter = (int)(parameters.maxMarkerPerimeterRate * maxDimension);
+
+	// Dieselben Konturen in derselben Reihenfolge wie findContours() mit RETR_LIST und CHAIN_APPROX_NONE in
+	// detectMarkers(), aber in den Puffern des letzten Bildes
+	ContourTracer& tracer = workspace.tracer;
+	tracer.trace(threshold);
+
+	for (int i = 0; i < tracer.contourCount(); ++i) {
+
+		int perimeter;
+		const Point* contour = tracer.contour(i, perimeter);
+
+		if (perimeter < minPerimeter || perimeter > maxPerimeter) {
+
+			continue;
+		}
+
+		tracer.approximatePolygon(contour, perimeter, perimeter * parameters.polygonalApproxAccuracyRate, approxCurve);
+
+		if (approxCurve.size() != 4 || !isContourConvex(approxCurve)) {
+
+			continue;
+		}
+
+		// Zu kurze Seiten und zu nah am Bildrand liegende Ecken verwerfen (wie _findMarkerContours())
+		double minSideSquared = DBL_MAX;
+
+		for (int j = 0; j < 4; ++j) {
+
+			Point side = approxCurve[j] - approxCurve[(j + 1) % 4];
+			minSideSquared = min(minSideSquared, (double)side.dot(side));
+		}
+
+		double minCornerDistance = perimeter * parameters.minCornerDistanceRate;
+
+		if (minSideSquared < minCornerDistance * minCornerDistance) {
+
+			continue;
+		}
+
+		bool tooNearBorder = false;
+
+		for (const Point& corner : approxCurve) {
+
+			if (corner.x < parameters.minDistanceToBorder || corner.y < parameters.minDistanceToBorder ||
+				corner.x > gray.cols - 1 - parameters.minDistanceToBorder ||
+				corner.y > gray.rows - 1 - parameters.minDistanceToBorder) {
+
+				tooNearBorder = true;
+			}
+		}
+
+		if (tooNearBorder) {
+
+			continue;
+		}
+
+		Candidate candidate;
+		candidate.perimeter = perimeter;
+
+		for (int j = 0; j < 4; ++j) {
+
+			candidate.corners[j] = Point2f((float)approxCurve[j].x, (float)approxCurve[j].y);
+		}
+
+		// Ecken im Uhrzeigersinn (Bildkoordinaten) ordnen wie _reorderCandidatesCorners()
+		Point2f d1 = candidate.corners[1] - candidate.corners[0];
+		Point2f d2 = candidate.corners[2] - candidate.corners[0];
+
+		if (d1.x * d2.y - d1.y * d2.x < 0.0f) {
+
+			swap(candidate.corners[1], candidate.corners[3]);
+		}
+
+		found.push_back(candidate);
+	}
+}
+
+
+void FastMarkerDetector::removeCloseCandidates(const aruco::DetectorParameters& parameters) {
+
+	removed.assign(candidates.size(), 0);
+
+	for (size_t i = 0; i < candidates.size(); ++i) {
+
+		for (size_t j = i + 1; j < candidates.size(); ++j) {
+
+			if (removed[i] || removed[j]) {
+
+				continue;
+			}
+
+			const Candidate& a = candidates[i];
+			const Candidate& b = candidates[j];
+
+			double minDistance = min(a.perimeter, b.perimeter) * parameters.minMarkerDistanceRate;
+			double minDistanceSquared = minDistance * minDistance;
+
+			// Kleinste mittlere quadratische Eckdistanz über die vier möglichen Zuordnungen der Ecken
+			for (int shift = 0; shift < 4; ++shift) {
+
+				double distanceSquared = 0.0;
+
+				for (int k = 0; k < 4; ++k) {
+
+					Point2f d = a.corners[k] - b.corners[(k + shift) % 4];
+					distanceSquared += d.x * d.x + d.y * d.y;
+				}
+
+				if (distanceSquared / 4.0 < minDistanceSquared) {
+
+					// Der kleinere der beiden (meist die innere Kante des schwarzen Rahmens) fällt weg
+					removed[a.perimeter > b.perimeter ? j : i] = 1;
+					break;
+				}
+			}
+		}
+	}
+
+	size_t kept = 0;
+
+	for (size_t i = 0; i < candidates.size(); ++i) {
+
+		if (!removed[i]) {
+
+			candidates[kept++] = candidates[i];
+		}
+	}
+
+	candidates.resize(kept);
+}
+
+
+/* perspectiveTransform()-Funktion: Wie getPerspectiveTransform() (dasselbe Gleichungssystem, dieselbe LU-Zerlegung
+   über Matx::solve()), aber ohne Mat und damit ohne Allokation
+		- @param source: Vier Punkte im Ausgangsbild
+		- @param target: Die vier zugehörigen Punkte im Zielbild
+		- @param return: 3x3-Transformation von source nach target (Nullmatrix, wenn das System singulär ist)*/
+static Matx33d perspectiveTransform(const Point2f source[4], const Point2f target[4]) {
+
+	Matx<double, 8, 8> a;
+	Matx<double, 8, 1> b;
+
+	for (int i = 0; i < 4; ++i) {
+
+		a(i, 0) = a(i + 4, 3) = source[i].x;
+		a(i, 1) = a(i + 4, 4) = source[i].y;
+		a(i, 2) = a(i + 4, 5) = 1;
+		a(i, 3) = a(i, 4) = a(i, 5) = a(i + 4, 0) = a(i + 4, 1) = a(i + 4, 2) = 0;
+		a(i, 6) = -source[i].x * target[i].x;
+		a(i, 7) = -source[i].y * target[i].x;
+		a(i + 4, 6) = -source[i].x * target[i].y;
+		a(i + 4, 7) = -source[i].y * target[i].y;
+		b(i) = target[i].x;
+		b(i + 4) = target[i].y;
+	}
+
+	Matx<double, 8, 1> x = a.solve(b, DECOMP_LU);
+
+	return Matx33d(x(0), x(1), x(2), x(3), x(4), x(5), x(6), x(7), 1.0);
+}
+
+
+/* invertTransform()-Funktion: Inverse einer 3x3-Matrix mit derselben geschlossenen Formel, die invert() für 3x3-Matrizen
+   verwendet (und warpPerspective() damit für die Rückabbildung)
+		- @param m: Zu invertierende Matrix
+		- @param inverse: Ausgabe der Inversen
+		- @param return: False, wenn die Matrix singulär ist*/
+static bool invertTransform(const Matx33d& m, Matx33d& inverse) {
+
+	double d = m(0, 0) * (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) - m(0, 1) * (m(1, 0) * m(2, 2) - m(1, 2) * m(2, 0)) +
+		m(0, 2) * (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0));
+
+	if (d == 0.0) {
+
+		return false;
+	}
+
+	d = 1.0 / d;
+
+	inverse(0, 0) = (m(1, 1) * m(2, 2) - m(1, 2) * m(2, 1)) * d;
+	inverse(0, 1) = (m(0, 2) * m(2, 1) - m(0, 1) * m(2, 2)) * d;
+	inverse(0, 2) = (m(0, 1) * m(1, 2) - m(0, 2) * m(1, 1)) * d;
+	inverse(1, 0) = (m(1, 2) * m(2, 0) - m(1, 0) * m(2, 2)) * d;
+	inverse(1, 1) = (m(0, 0) * m(2, 2) - m(0, 2) * m(2, 0)) * d;
+	inverse(1, 2) = (m(0, 2) * m(1, 0) - m(0, 0) * m(1, 2)) * d;
+	inverse(2, 0) = (m(1, 0) * m(2, 1) - m(1, 1) * m(2, 0)) * d;
+	inverse(2, 1) = (m(0, 1) * m(2, 0) - m(0, 0) * m(2, 1)) * d;
+	inverse(2, 2) = (m(0, 0) * m(1, 1) - m(0, 1) * m(1, 0)) * d;
+
+	return true;
+}
+
+
+/* otsuThreshold()-Funktion: Schwellwert nach Otsu wie threshold() mit THRESH_OTSU für 8-Bit-Bilder
+		- @param pixels: Bildpunkte
+		- @param count: Anzahl der Bildpunkte
+		- @param return: Schwellwert (Bildpunkte größer als der Schwellwert sind weiß)*/
+static int otsuThreshold(const uchar* pixels, int count) {
+
+	int histogram[256] = {};
+
+	for (int i = 0; i < count; ++i) {
+
+		histogram[pixels[i]]++;
+	}
+
+	double mu = 0.0, scale = 1.0 / count;
+
+	for (int i = 0; i < 256; ++i) {
+
+		mu += i * (double)histogram[i];
+	}
+
+	mu *= scale;
+
+	double mu1 = 0.0, q1 = 0.0;
+	double maxSigma = 0.0;
+	int maxValue = 0;
+
+	for (int i = 0; i < 256; ++i) {
+
+		double p = histogram[i] * scale;
+
+		mu1 *= q1;
+		q1 += p;
+
+		double q2 = 1.0 - q1;
+
+		if (min(q1, q2) < FLT_EPSILON || max(q1, q2) > 1.0 - FLT_EPSILON) {
+
+			continue;
+		}
+
+		mu1 = (mu1 + i * p) / q1;
+
+		double mu2 = (mu - q1 * mu1) / q2;
+		double sigma = q1 * q2 * (mu1 - mu2) * (mu1 - mu2);
+
+		if (sigma > maxSigma) {
+
+			maxSigma = sigma;
+			maxValue = i;
+		}
+	}
+
+	return maxValue;
+}
+
+
+/* extractBits()-Funktion: Liest die Bits eines Kandidaten (mit Rand) genau wie _extractBits() von aruco: Entzerrung auf
+   perspectiveRemovePixelPerCell Pixel pro Zelle mit nächstem Nachbarn (wie warpPerspective() mit INTER_NEAREST und
+   schwarzem Rand), bei zu geringer Standardabweichung im Inneren alle Bits gleich, sonst Schwellwert nach Otsu über das
+   entzerrte Bild und pro Zelle die Mehrheit der weißen Pixel. Das entzerrte Bild liegt in einem Puffer des Detektors
+		- @param parameters: Parameter der Identifikation
+		- @param candidate: Kandidat mit geordneten Ecken
+		- @param bits: Ausgabe der Bits zeilenweise (gridCells² Werte, 1 = weiß)
+		- @param return: False, wenn der Kandidat keine gültige Perspektive hat*/
+bool FastMarkerDetector::extractBits(const aruco::DetectorParameters& parameters, const Candidate& candidate,
+	uchar* bits) {
+
+	const int gridCells = markerSize + 2 * parameters.markerBorderBits;
+	const int cellSize = parameters.perspectiveRemovePixelPerCell;
+	const int imageSize = gridCells * cellSize;
+	const int cellMargin = (int)(parameters.perspectiveRemoveIgnoredMarginPerCell * cellSize);
+
+	const Point2f imageCorners[4] = {
+		Point2f(0.0f, 0.0f), Point2f((float)imageSize - 1, 0.0f),
+		Point2f((float)imageSize - 1, (float)imageSize - 1), Point2f(0.0f, (float)imageSize - 1) };
+
+	// warpPerspective() invertiert die Transformation vom Kandidaten auf das entzerrte Bild und tastet damit ab
+	Matx33d m;
+
+	if (!invertTransform(perspectiveTransform(candidate.corners, imageCorners), m)) {
+
+		return false;
+	}
+
+	markerImage.resize(imageSize * imageSize);
+
+	for (int y = 0; y < imageSize; ++y) {
+
+		double x0 = m(0, 1) * y + m(0, 2);
+		double y0 = m(1, 1) * y + m(1, 2);
+		double w0 = m(2, 1) * y + m(2, 2);
+		uchar* row = &markerImage[y * imageSize];
+
+		for (int x = 0; x < imageSize; ++x) {
+
+			double w = w0 + m(2, 0) * x;
+			w = w != 0.0 ? 1.0 / w : 0.0;
+
+			int sourceX = cvRound(max((double)INT_MIN, min((double)INT_MAX, (x0 + m(0, 0) * x) * w)));
+			int sourceY = cvRound(max((double)INT_MIN, min((double)INT_MAX, (y0 + m(1, 0) * x) * w)));
+
+			row[x] = (unsigned)sourceX < (unsigned)gray.cols && (unsigned)sourceY < (unsigned)gray.rows ?
+				gray.ptr<uchar>(sourceY)[sourceX] : 0;
+		}
+	}
+
+	// Standardabweichung im Inneren (ohne eine halbe Zelle am Rand) wie meanStdDev()
+	long long sum = 0, squaredSum = 0;
+	int innerCount = 0;
+
+	for (int y = cellSize / 2; y < imageSize - cellSize / 2; ++y) {
+
+		for (int x = cellSize / 2; x < imageSize - cellSize / 2; ++x) {
+
+			int value = markerImage[y * imageSize + x];
+			sum += value;
+			squaredSum += value * value;
+			++innerCount;
+		}
+	}
+
+	double innerScale = innerCount > 0 ? 1.0 / innerCount : 0.0;
+	double mean = sum * innerScale;
+	double deviation = sqrt(max(squaredSum * innerScale - mean * mean, 0.0));
+
+	// Einheitliche Fläche: alle Bits schwarz oder alle weiß, abhängig vom Mittelwert
+	if (deviation < parameters.minOtsuStdDev) {
+
+		fill(bits, bits + gridCells * gridCells, (uchar)(mean > 127 ? 1 : 0));
+		return true;
+	}
+
+	const int threshold = otsuThreshold(markerImage.data(), imageSize * imageSize);
+	const int cellPixels = cellSize - 2 * cellMargin;
+
+	for (int cellY = 0; cellY < gridCells; ++cellY) {
+
+		for (int cellX = 0; cellX < gridCells; ++cellX) {
+
+			int white = 0;
+
+			for (int y = 0; y < cellPixels; ++y) {
+
+				const uchar* row = &markerImage[(cellY * cellSize + cellMargin + y) * imageSize + cellX * cellSize + cellMargin];
+
+				for (int x = 0; x < cellPixels; ++x) {
+
+					white += row[x] > threshold ? 1 : 0;
+				}
+			}
+
+			bits[cellY * gridCells + cellX] = white > cellPixels * cellPixels / 2 ? 1 : 0;
+		}
+	}
+
+	return true;
+}
+
+
+void FastMarkerDetector::identifyCandidates(const aruco::DetectorParameters& parameters,
+	vector<vector<Point2f>>& corners, vector<int>& ids, CornerPool& cornerPool) {
+
+	const int border = parameters.markerBorderBits;
+	const int gridCells = markerSize + 2 * border;
+	const int maxBorderErrors = (int)(markerSize * markerSize * parameters.maxErroneousBitsInBorderRate);
+
+	cellBits.resize(gridCells * gridCells);
+	uchar bits[Dictionary4x4::bitCount];
+
+	for (size_t c = 0; c < candidates.size(); ++c) {
+
+		if (!extractBits(parameters, candidates[c], cellBits.data())) {
+
+			continue;
+		}
+
+		int borderErrors = 0;
+
+		for (int y = 0; y < gridCells; ++y) {
+
+			for (int x = 0; x < gridCells; ++x) {
+
+				uchar bit = cellBits[y * gridCells + x];
+
+				if (x < border || y < border || x >= gridCells - border || y >= gridCells - border) {
+
+					borderErrors += bit;
+				}
+				else {
+
+					bits[(y - border) * markerSize + (x - border)] = bit;
+				}
+			}
+		}
+
+		if (borderErrors > maxBorderErrors) {
+
+			continue;
+		}
+
+		int id = 0, rotation = 0;
+
+		if (!dictionary.identify(Dictionary4x4::packBits(bits), parameters.errorCorrectionRate, id, rotation)) {
+
+			continue;
+		}
+
+		// Ecken so drehen, dass die erste Ecke wie bei detectMarkers() die Ecke oben links des Markers ist
+		vector<Point2f>& markerCorners = cornerPool.append(corners);
+
+		for (int j = 0; j < 4; ++j) {
+
+			markerCorners[j] = candidates[c].corners[(j + 4 - rotation) % 4];
+		}
+
+		ids.push_back(id);
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+#include "ContourTracer.h"
+#include "FixedDictionary.h"
+#include "Workspace.h"
+
+/* FastMarkerDetector-Klasse: Markererkennung für Lexika mit 4x4 Bits (DICT_4X4_50 bis DICT_4X4_1000) ohne den
+   allgemeinen Weg von aruco::detectMarkers(). Die Kandidatensuche (adaptive Schwellwerte, Konturen, Vierecke) folgt
+   detectMarkers() mit denselben DetectorParameters, die Grauwandlung und die Schwellwerte laufen aber vektorisiert über
+   ein gemeinsames Integralbild (siehe ImageKernels.h), Konturen und Vierecke kommen aus ContourTracer statt aus
+   findContours() und approxPolyDP(). Die Bits eines Kandidaten werden genau wie von _extractBits() in
+   aruco gelesen (Entzerrung mit nächstem Nachbarn, Otsu, Mehrheit pro Zelle), aber ohne Mat direkt aus dem Graubild in
+   einen Puffer des Detektors. Die Identifikation ist auf das feste Lexikon zugeschnitten: der gepackte 16-Bit-Code wird
+   über die Hashtabelle von FixedDictionary gesucht statt mit jedem Marker in jeder Drehung verglichen.
+   Ecken werden wie bei detectMarkers() mit CORNER_REFINE_NONE nicht verfeinert.
+   Alle Puffer gehören dem Detektor und werden von Bild zu Bild wiederverwendet, nach dem Aufwärmen allokiert detect()
+   nichts mehr*/
+class FastMarkerDetector {
+
+public:
+
+	typedef FixedDictionary<4, 1000> Dictionary4x4;
+
+	FastMarkerDetector();
+
+	/* setDictionary()-Funktion: Übernimmt das Lexikon, falls es in Dictionary4x4 passt
+			- @param dictionary: aruco-Lexikon
+			- @param return: True, wenn der schnelle Weg verwendet werden kann*/
+	bool setDictionary(const cv::Ptr<cv::aruco::Dictionary>& dictionary);
+
+	bool isActive() const;
+
+	/* detect()-Funktion: Erkennt die Marker im Bild wie aruco::detectMarkers()
+			- @param image: Eingabebild (BGR oder Graustufen)
+			- @param parameters: Parameter der Kandidatensuche und Identifikation
+			- @param corners: Ausgabe der erkannten Markerecken (Nx4, im Uhrzeigersinn ab der Ecke oben links des Markers)
+			- @param ids: Ausgabe der erkannten Marker-IDs
+			- @param cornerPool: Pool, über den corners immer verkleinert und vergrößert wird*/
+	void detect(const cv::Mat& image, const cv::aruco::DetectorParameters& parameters,
+		std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids, CornerPool& cornerPool);
+
+private:
+
+	struct Candidate {
+
+		cv::Point2f corners[4];
+
+		// Länge der Kontur in Pixeln (zum Vergleich zu naher Kandidaten)
+		int perimeter;
+	};
+
+	// Puffer einer Fenstergröße des adaptiven Schwellwerts. Die Fenstergrößen laufen parallel, jede nur auf ihrem
+	// eigenen Puffer
+	struct ScaleWorkspace {
+
+		// Binärbild und die Konturverfolgung mit ihren Puffern
+		cv::Mat threshold, thresholdBuffer;
+		ContourTracer tracer;
+
+		// Polygon der gerade geprüften Kontur
+		std::vector<cv::Point> approxCurve;
+		std::vector<Candidate> candidates;
+	};
+
+	void findCandidates(const cv::aruco::DetectorParameters& parameters);
+	void findCandidatesAtScale(const cv::aruco::DetectorParameters& parameters, int scale);
+	void removeCloseCandidates(const cv::aruco::DetectorParameters& parameters);
+	bool extractBits(const cv::aruco::DetectorParameters& parameters, const Candidate& candidate, cv::uchar* bits);
+	void identifyCandidates(const cv::aruco::DetectorParameters& parameters,
+		std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids, CornerPool& cornerPool);
+
+	Dictionary4x4 dictionary;
+	bool active;
+
+	// Graubild und sein Integralbild (Ausschnitte der Puffer, die Größe wechselt mit den Ausschnitten der Verfolgung)
+	// und die Puffer jeder Fenstergröße
+	cv::Mat gray, grayBuffer, integralImage, integralBuffer;
+	bool integralThreshold;
+	std::vector<ScaleWorkspace> scales;
+
+	// Kandidaten aller Fenstergrößen, das entzerrte Bild des gerade gelesenen Kandidaten und seine Bits mit Rand
+	std::vector<Candidate> candidates;
+	std::vector<char> removed;
+	std::vector<cv::uchar> markerImage;
+	std::vector<cv::uchar> cellBits;
+};
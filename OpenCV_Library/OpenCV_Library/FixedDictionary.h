@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cstdint>
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+
+/* fixedDictionaryTableSize()-Funktion: Kleinste Zweierpotenz, bei der die Hashtabelle höchstens halb gefüllt ist
+		- @param entries: Anzahl der Einträge
+		- @param return: Größe der Hashtabelle*/
+constexpr int fixedDictionaryTableSize(int entries) {
+
+	int size = 1;
+
+	while (size < 2 * entries) {
+
+		size *= 2;
+	}
+
+	return size;
+}
+
+/* FixedDictionary-Klasse: Lexikon mit höchstens 16 Bits pro Marker und fester Größe, dessen Codes in allen vier
+   Drehungen als 16-Bit-Wörter in Arrays fester Länge liegen. Ein Kandidat wird über eine Hashtabelle in einem Schritt
+   gefunden statt wie bei aruco::Dictionary::identify() für jeden Marker und jede Drehung byteweise verglichen zu
+   werden. Nur wenn Fehlerkorrektur erlaubt ist und der Code nicht exakt vorkommt, wird über die Hamming-Distanz gesucht.
+   Die Codes selbst werden beim Laden aus dem aruco-Lexikon übernommen, damit IDs und Drehungen genau denen von
+   detectMarkers() entsprechen
+		- @param MarkerSize: Anzahl der Bits pro Seite (4 für DICT_4X4_*)
+		- @param Capacity: Höchstzahl an Markern (50 für DICT_4X4_50)*/
+template<int MarkerSize, int Capacity>
+class FixedDictionary {
+
+public:
+
+	static const int bitCount = MarkerSize * MarkerSize;
+	static const int byteCount = (bitCount + 7) / 8;
+
+	static_assert(bitCount <= 16, "FixedDictionary packt einen Code in 16 Bits");
+
+	FixedDictionary() : codes(), table(), markerCount(0), maxCorrectionBits(0) {}
+
+	/* load()-Funktion: Übernimmt die Codes eines aruco-Lexikons
+			- @param dictionary: Lexikon mit markerSize == MarkerSize und höchstens Capacity Markern
+			- @param return: False, wenn das Lexikon nicht passt (dann muss der allgemeine Weg verwendet werden)*/
+	bool load(const cv::aruco::Dictionary& dictionary) {
+
+		markerCount = 0;
+
+		for (int slot = 0; slot < tableSize; ++slot) {
+
+			table[slot] = 0;
+		}
+
+		if (dictionary.markerSize != MarkerSize || dictionary.bytesList.rows > Capacity ||
+			dictionary.bytesList.cols != byteCount) {
+
+			return false;
+		}
+
+		// bytesList enthält pro Marker die Bytes der vier Drehungen hintereinander (Drehung r ab Byte r * byteCount)
+		for (int id = 0; id < dictionary.bytesList.rows; ++id) {
+
+			const cv::uchar* bytes = dictionary.bytesList.ptr<cv::uchar>(id);
+
+			for (int rotation = 0; rotation < 4; ++rotation) {
+
+				uint16_t code = 0;
+
+				for (int b = 0; b < byteCount; ++b) {
+
+					code = (uint16_t)((code << 8) | bytes[rotation * byteCount + b]);
+				}
+
+				codes[id * 4 + rotation] = code;
+				insert(code, id * 4 + rotation);
+			}
+		}
+
+		markerCount = dictionary.bytesList.rows;
+		maxCorrectionBits = dictionary.maxCorrectionBits;
+
+		return true;
+	}
+
+	bool isLoaded() const {
+
+		return markerCount > 0;
+	}
+
+	/* packBits()-Funktion: Packt die Bits eines Kandidaten (zeilenweise, 1 = weiß) genau wie
+	   aruco::Dictionary::getByteListFromBits() ohne Drehung
+			- @param bits: bitCount Werte (0 oder 1)
+			- @param return: Code als 16-Bit-Wort*/
+	static uint16_t packBits(const cv::uchar* bits) {
+
+		uint16_t code = 0;
+
+		for (int b = 0; b < byteCount; ++b) {
+
+			int byteValue = 0;
+
+			for (int i = b * 8; i < bitCount && i < (b + 1) * 8; ++i) {
+
+				byteValue = (byteValue << 1) | bits[i];
+			}
+
+			code = (uint16_t)((code << 8) | byteValue);
+		}
+
+		return code;
+	}
+
+	/* identify()-Funktion: Sucht den Marker zu einem Code. Bei mehreren Treffern gewinnt wie bei
+	   aruco::Dictionary::identify() die kleinste ID und dort die kleinste Drehung
+			- @param code: Mit packBits() gepackter Code des Kandidaten
+			- @param errorCorrectionRate: Anteil von maxCorrectionBits, der korrigiert werden darf (DetectorParameters)
+			- @param id: Ausgabe der Marker-ID
+			- @param rotation: Ausgabe der Drehung (0..3) wie bei aruco::Dictionary::identify()
+			- @param return: False, wenn der Code zu keinem Marker passt*/
+	bool identify(uint16_t code, double errorCorrectionRate, int& id, int& rotation) const {
+
+		for (int slot = hash(code); table[slot] != 0; slot = (slot + 1) & (tableSize - 1)) {
+
+			int index = table[slot] - 1;
+
+			if (codes[index] == code) {
+
+				id = index / 4;
+				rotation = index % 4;
+				return true;
+			}
+		}
+
+		// Ein exakter Treffer ist auch bei aruco das Ergebnis: die Codes der Lexika liegen mehr als 2 * maxCorrectionBits
+		// auseinander, so dass kein anderer Marker innerhalb der Korrekturdistanz liegen kann
+		int maxCorrection = (int)(maxCorrectionBits * errorCorrectionRate);
+
+		if (maxCorrection <= 0) {
+
+			return false;
+		}
+
+		for (int m = 0; m < markerCount; ++m) {
+
+			int bestDistance = bitCount + 1;
+			int bestRotation = -1;
+
+			for (int r = 0; r < 4; ++r) {
+
+				int distance = bitDistance(codes[m * 4 + r], code);
+
+				if (distance < bestDistance) {
+
+					bestDistance = distance;
+					bestRotation = r;
+				}
+			}
+
+			if (bestDistance <= maxCorrection) {
+
+				id = m;
+				rotation = bestRotation;
+				return true;
+			}
+		}
+
+		return false;
+	}
+
+private:
+
+	static const int tableSize = fixedDictionaryTableSize(4 * Capacity);
+
+	static int hash(uint16_t code) {
+
+		return (int)(((uint32_t)code * 40503u) >> 4) & (tableSize - 1);
+	}
+
+	static int bitDistance(uint16_t a, uint16_t b) {
+
+		int distance = 0;
+
+		for (uint16_t difference = a ^ b; difference != 0; difference &= difference - 1) {
+
+			++distance;
+		}
+
+		return distance;
+	}
+
+	// Gleiche Codes (symmetrische Marker) werden nur einmal eingetragen, damit die kleinste ID/Drehung gefunden wird
+	void insert(uint16_t code, int index) {
+
+		int slot = hash(code);
+
+		for (; table[slot] != 0; slot = (slot + 1) & (tableSize - 1)) {
+
+			if (codes[table[slot] - 1] == code) {
+
+				return;
+			}
+		}
+
+		table[slot] = (uint16_t)(index + 1);
+	}
+
+	// Codes aller Marker in allen Drehungen (Index id * 4 + Drehung)
+	uint16_t codes[Capacity * 4];
+
+	// Offene Adressierung mit linearer Suche, Eintrag = Index in codes + 1 (0 = leer)
+	uint16_t table[tableSize];
+
+	int markerCount;
+	int maxCorrectionBits;
+};
@@ -0,0 +1,127 @@
+#include "FrameExport.h"
+#include "ImageKernels.h"
+#include <opencv2/imgproc.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+FrameExport::FrameExport()
+	: format(FRAME_EXPORT_NONE), ready(-1), inUse(-1), readySequence(0), dropped(0) {
+
+	for (Buffer& buffer : buffers) {
+
+		buffer.info = ExportedFrame();
+	}
+}
+
+
+void FrameExport::setFormat(int format) {
+
+	if (format != FRAME_EXPORT_RGBA && format != FRAME_EXPORT_GRAY) {
+
+		format = FRAME_EXPORT_NONE;
+	}
+
+	this->format.store(format, memory_order_relaxed);
+}
+
+
+int FrameExport::getFormat() const {
+
+	return format.load(memory_order_relaxed);
+}
+
+
+void FrameExport::write(const Mat& frame, unsigned long long sequence, long long captureTimestamp) {
+
+	const int requested = format.load(memory_order_relaxed);
+
+	if (requested == FRAME_EXPORT_NONE || frame.empty()) {
+
+		return;
+	}
+
+	// Geschrieben wird immer in den Puffer, der nicht der zuletzt fertige ist. Hält der Leser genau diesen Puffer
+	// (er hat ihn vor dem letzten write() geholt und noch nicht freigegeben), wird das Bild verworfen
+	const int target = ready.load() == 0 ? 1 : 0;
+
+	if (inUse.load() == target) {
+
+		dropped.fetch_add(1, memory_order_relaxed);
+		return;
+	}
+
+	Buffer& buffer = buffers[target];
+
+	if (requested == FRAME_EXPORT_RGBA) {
+
+		const int code = frame.channels() == 1 ? COLOR_GRAY2RGBA : frame.channels() == 4 ? COLOR_BGRA2RGBA : COLOR_BGR2RGBA;
+		cvtColor(frame, buffer.pixels, code);
+	}
+	else if (frame.channels() == 1) {
+
+		frame.copyTo(buffer.pixels);
+	}
+	else {
+
+		convertToGray(frame, buffer.pixels);
+	}
+
+	ExportedFrame& info = buffer.info;
+	info.pixels = buffer.pixels.ptr<unsigned char>();
+	info.width = buffer.pixels.cols;
+	info.height = buffer.pixels.rows;
+	info.stride = (int)buffer.pixels.step[0];
+	info.size = info.stride * info.height;
+	info.format = requested;
+	info.bufferIndex = target;
+	info.sequence = sequence;
+	info.captureTimestamp = captureTimestamp;
+
+	ready.store(target);
+	readySequence.store(sequence, memory_order_release);
+}
+
+
+bool FrameExport::acquire(ExportedFrame& exported) {
+
+	for (;;) {
+
+		const int index = ready.load();
+
+		if (index < 0) {
+
+			inUse.store(-1);
+			return false;
+		}
+
+		inUse.store(index);
+
+		// Hat der Schreiber inzwischen den anderen Puffer freigegeben, schreibt er womöglich schon in diesen hier.
+		// Dann wird der neuere Puffer gehalten
+		if (ready.load() == index) {
+
+			exported = buffers[index].info;
+			return true;
+		}
+	}
+}
+
+
+void FrameExport::release() {
+
+	inUse.store(-1);
+}
+
+
+unsigned long long FrameExport::latestSequence() const {
+
+	return readySequence.load(memory_order_acquire);
+}
+
+
+unsigned long long FrameExport::droppedFrames() const {
+
+	return dropped.load(memory_order_relaxed);
+}
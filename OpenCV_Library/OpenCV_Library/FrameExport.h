@@ -0,0 +1,99 @@
+#pragma once
+
+#include <atomic>
+#include <opencv2/core.hpp>
+
+// Formate des exportierten Kamerabildes (setFrameExport())
+const int FRAME_EXPORT_NONE = 0;
+const int FRAME_EXPORT_RGBA = 1;
+const int FRAME_EXPORT_GRAY = 2;
+
+/* ExportedFrame-Struktur: Beschreibung eines exportierten Kamerabildes. Nur Werttypen, damit die Struktur direkt an C#
+   übergeben werden kann (siehe CubeScript.cs)*/
+struct ExportedFrame {
+
+	// Erster Pixel der obersten Bildzeile. Der Speicher gehört der DLL und bleibt bis releaseExportedFrame() gültig
+	const unsigned char* pixels;
+
+	int width;
+	int height;
+
+	// Bytes pro Zeile und Bytes des ganzen Bildes (stride * height)
+	int stride;
+	int size;
+
+	// FRAME_EXPORT_RGBA (4 Bytes pro Pixel) oder FRAME_EXPORT_GRAY (nur die Helligkeit, 1 Byte pro Pixel)
+	int format;
+
+	// Puffer, aus dem das Bild stammt (0 oder 1)
+	int bufferIndex;
+
+	// Nummer des Ergebnisses, das zu diesem Bild gehört (wie getResultSequence()), und sein Aufnahmezeitpunkt in
+	// Mikrosekunden (monotonicMicroseconds())
+	unsigned long long sequence;
+	long long captureTimestamp;
+};
+
+/* FrameExport-Klasse: Doppelpuffer, über den die Pipeline das Kamerabild an den Aufrufer (Unity) weitergibt. Die
+   Pipeline wandelt jedes Bild genau einmal in das gewünschte Format um, direkt in einen der beiden Puffer der DLL.
+   Der Leser hält sich mit acquire() den zuletzt fertigen Puffer und liest (bzw. lädt in eine Textur) direkt aus
+   diesem Speicher, ohne Kopie über P/Invoke. Solange er ihn hält, schreibt die Pipeline nur in den anderen Puffer.
+   Ist der andere Puffer schon fertig und der gehaltene noch nicht freigegeben, wird das Bild nicht exportiert,
+   die Pipeline wartet nie auf den Leser. Die Puffer werden nur bei anderer Bildgröße oder anderem Format neu angelegt*/
+class FrameExport {
+
+public:
+
+	FrameExport();
+
+	FrameExport(const FrameExport&) = delete;
+	FrameExport& operator=(const FrameExport&) = delete;
+
+	/* setFormat()-Funktion: Schaltet den Export ein oder aus. Darf aus jedem Thread aufgerufen werden, das neue Format
+	   gilt ab dem nächsten Bild
+			- @param format: FRAME_EXPORT_NONE, FRAME_EXPORT_RGBA oder FRAME_EXPORT_GRAY*/
+	void setFormat(int format);
+	int getFormat() const;
+
+	/* write()-Funktion: Wandelt ein Bild in den freien Puffer um und gibt ihn frei (nur im Thread der Pipeline)
+			- @param frame: Aufgenommenes Bild (BGR, BGRA oder Graustufen)
+			- @param sequence: Nummer des zugehörigen Ergebnisses
+			- @param captureTimestamp: Aufnahmezeitpunkt des Bildes in Mikrosekunden*/
+	void write(const cv::Mat& frame, unsigned long long sequence, long long captureTimestamp);
+
+	/* acquire()-Funktion: Hält den zuletzt fertigen Puffer, bis release() oder das nächste acquire() aufgerufen wird
+	   (nur im Leser-Thread)
+			- @param exported: Ausgabe der Beschreibung des Bildes
+			- @param return: False, wenn noch kein Bild exportiert wurde*/
+	bool acquire(ExportedFrame& exported);
+
+	/* release()-Funktion: Gibt den mit acquire() gehaltenen Puffer wieder frei (nur im Leser-Thread)*/
+	void release();
+
+	/* latestSequence()-Funktion: Nummer des zuletzt fertigen Bildes, damit der Leser nur bei einem neuen Bild acquire()
+	   aufrufen muss
+			- @param return: Nummer des zugehörigen Ergebnisses, 0 wenn noch kein Bild exportiert wurde*/
+	unsigned long long latestSequence() const;
+
+	/* droppedFrames()-Funktion: Anzahl der Bilder, die nicht exportiert wurden, weil der Leser beide Puffer blockiert hat*/
+	unsigned long long droppedFrames() const;
+
+private:
+
+	struct Buffer {
+
+		cv::Mat pixels;
+		ExportedFrame info;
+	};
+
+	Buffer buffers[2];
+	std::atomic<int> format;
+
+	// Index des zuletzt fertigen Puffers und des vom Leser gehaltenen Puffers (-1 = keiner). Beide werden mit
+	// sequentieller Konsistenz gelesen und geschrieben: Schreiber und Leser prüfen jeweils den Index des anderen, nachdem
+	// sie ihren eigenen gesetzt haben, so dass nie beide denselben Puffer verwenden
+	std::atomic<int> ready;
+	std::atomic<int> inUse;
+	std::atomic<unsigned long long> readySequence;
+	std::atomic<unsigned long long> dropped;
+};
@@ -0,0 +1,573 @@
+#include "FrameSource.h"
+#include <cstdlib>
+#include <cmath>
+#include <thread>
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/imgcodecs.hpp>
+#include <opencv2/aruco.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+VideoCaptureFrameSource::VideoCaptureFrameSource(int cameraInput, int captureFormat)
+	: capture(cameraInput), loop(false), captureFormat(captureFormat), file(false), finished(false),
+	  rawLayout(RAW_LAYOUT_BGR) {
+
+	if (captureFormat == CAPTURE_FORMAT_LUMINANCE && capture.isOpened()) {
+
+		// Media Foundation liefert mit CAP_MODE_GRAY die Y-Ebene von NV12, V4L2 ohne Umwandlung nach RGB den Puffer des
+		// Treibers (YUYV, NV12, GREY oder bei MJPEG-Kameras das komprimierte Bild). Backends, die beides nicht kennen,
+		// liefern weiter BGR
+		capture.set(CAP_PROP_FORMAT, CAP_MODE_GRAY);
+		capture.set(CAP_PROP_CONVERT_RGB, 0);
+	}
+
+	frameSize = Size((int)capture.get(CAP_PROP_FRAME_WIDTH), (int)capture.get(CAP_PROP_FRAME_HEIGHT));
+}
+
+
+// Bei Videodateien gibt es keine Rohdaten der Kamera, das Helligkeitsformat wandelt dann das dekodierte Bild um
+VideoCaptureFrameSource::VideoCaptureFrameSource(const string& fileName, bool loop, int captureFormat)
+	: capture(fileName), loop(loop), captureFormat(captureFormat), file(true), finished(false),
+	  rawLayout(RAW_LAYOUT_BGR) {
+
+	frameSize = Size((int)capture.get(CAP_PROP_FRAME_WIDTH), (int)capture.get(CAP_PROP_FRAME_HEIGHT));
+}
+
+
+bool VideoCaptureFrameSource::isOpened() const {
+
+	return capture.isOpened();
+}
+
+
+bool VideoCaptureFrameSource::grab() {
+
+	if (capture.grab()) {
+
+		return true;
+	}
+
+	// Am Ende der Datei wieder zum ersten Bild springen
+	if (loop && capture.set(CAP_PROP_POS_FRAMES, 0) && capture.grab()) {
+
+		return true;
+	}
+
+	// Eine Webcam kann kurz ausfallen, eine Datei ist dagegen zu Ende
+	finished = file;
+	return false;
+}
+
+
+bool VideoCaptureFrameSource::isFinished() const {
+
+	return finished;
+}
+
+
+bool VideoCaptureFrameSource::retrieve(Mat& frame) {
+
+	if (captureFormat != CAPTURE_FORMAT_LUMINANCE) {
+
+		if (!capture.retrieve(frame)) {
+
+			return false;
+		}
+
+		lastTouchedBytes = (long long)(frame.total() * frame.elemSize());
+		return true;
+	}
+
+	return capture.retrieve(raw) && !raw.empty() && extractLuminance(frame);
+}
+
+
+/* extractLuminance()-Funktion: Erkennt an Typ und Größe der Rohdaten, was das Backend geliefert hat, und gibt die
+   Helligkeit weiter. Graustufen und NV12 (die Y-Ebene liegt vor den Farbebenen) werden ohne Kopie als Header
+   weitergegeben, bei YUYV wird jedes zweite Byte herausgezogen, MJPEG wird nur in Graustufen dekodiert (ohne
+   Farbebenen und Farbumwandlung). Hat das Backend die Rohdaten verweigert, wird das Farbbild umgewandelt
+		- @param frame: Ausgabe der Helligkeit
+		- @param return: False, wenn die Rohdaten nicht gelesen werden konnten*/
+bool VideoCaptureFrameSource::extractLuminance(Mat& frame) {
+
+	const int width = frameSize.width;
+	const int height = frameSize.height;
+	const size_t pixels = (size_t)width * height;
+	const size_t rawBytes = raw.total() * raw.elemSize();
+
+	// Eine lange Zeile (Puffer des Treibers) lässt sich nur bei zusammenhängendem Speicher neu einteilen
+	const bool packed = raw.type() == CV_8UC1 && raw.isContinuous() && pixels > 0;
+
+	lastTouchedBytes = 0;
+
+	if (raw.channels() == 3 || raw.channels() == 4) {
+
+		rawLayout = RAW_LAYOUT_BGR;
+		rawView = raw;
+		cvtColor(raw, luminance, raw.channels() == 4 ? COLOR_BGRA2GRAY : COLOR_BGR2GRAY);
+		frame = luminance;
+		lastTouchedBytes = (long long)(rawBytes + luminance.total());
+	}
+	else if (raw.type() == CV_8UC1 && raw.rows > 1 && (raw.size() == frameSize || pixels == 0)) {
+
+		rawLayout = RAW_LAYOUT_GRAY;
+		rawView = raw;
+		frame = raw;
+	}
+	else if (raw.type() == CV_8UC1 && raw.rows == height * 3 / 2 && raw.cols == width) {
+
+		rawLayout = RAW_LAYOUT_NV12;
+		rawView = raw;
+		frame = raw.rowRange(0, height);
+	}
+	else if (packed && (rawBytes == pixels || rawBytes == pixels * 3 / 2)) {
+
+		rawLayout = rawBytes == pixels ? RAW_LAYOUT_GRAY : RAW_LAYOUT_NV12;
+		rawView = Mat(rawLayout == RAW_LAYOUT_GRAY ? height : height * 3 / 2, width, CV_8UC1, raw.data);
+		frame = rawView.rowRange(0, height);
+	}
+	else if (raw.type() == CV_8UC2 || (packed && rawBytes == pixels * 2)) {
+
+		rawLayout = RAW_LAYOUT_YUYV;
+		rawView = raw.type() == CV_8UC2 ? raw : Mat(height, width, CV_8UC2, raw.data);
+		extractChannel(rawView, luminance, 0);
+		frame = luminance;
+		lastTouchedBytes = (long long)(rawView.total() * 2 + luminance.total());
+	}
+	else {
+
+		rawLayout = RAW_LAYOUT_ENCODED;
+		rawView = raw;
+		imdecode(raw, IMREAD_GRAYSCALE, &luminance);
+
+		if (luminance.empty()) {
+
+			return false;
+		}
+
+		frame = luminance;
+		lastTouchedBytes = (long long)(rawBytes + luminance.total());
+	}
+
+	return true;
+}
+
+
+/* retrieveColor()-Funktion: Wandelt die Rohdaten des letzten Bildes in BGR um, in der Anordnung, die
+   extractLuminance() erkannt hat. Bei Rohdaten mit 1,5 Bytes pro Pixel wird NV12 angenommen (Media Foundation und die
+   meisten V4L2-Kameras), bei I420 stimmen nur die Farben nicht*/
+bool VideoCaptureFrameSource::retrieveColor(Mat& frame) {
+
+	if (captureFormat != CAPTURE_FORMAT_LUMINANCE) {
+
+		return retrieve(frame);
+	}
+
+	if (rawView.empty()) {
+
+		return false;
+	}
+
+	switch (rawLayout) {
+
+	case RAW_LAYOUT_GRAY:
+		cvtColor(rawView, frame, COLOR_GRAY2BGR);
+		break;
+
+	case RAW_LAYOUT_NV12:
+		cvtColor(rawView, frame, COLOR_YUV2BGR_NV12);
+		break;
+
+	case RAW_LAYOUT_YUYV:
+		cvtColor(rawView, frame, COLOR_YUV2BGR_YUYV);
+		break;
+
+	case RAW_LAYOUT_ENCODED:
+		imdecode(rawView, IMREAD_COLOR, &frame);
+		break;
+
+	default:
+		if (rawView.channels() == 4) {
+
+			cvtColor(rawView, frame, COLOR_BGRA2BGR);
+		}
+		else {
+
+			rawView.copyTo(frame);
+		}
+	}
+
+	lastTouchedBytes = (long long)(rawView.total() * rawView.elemSize() + frame.total() * frame.elemSize());
+
+	return !frame.empty();
+}
+
+
+int VideoCaptureFrameSource::getCaptureFormat() const {
+
+	return captureFormat;
+}
+
+
+ImageDirectoryFrameSource::ImageDirectoryFrameSource(const string& directory, bool loop, int captureFormat)
+	: loop(loop), captureFormat(captureFormat), current(-1) {
+
+	const char* patterns[] = { "*.jpg", "*.jpeg", "*.png", "*.bmp" };
+
+	vector<String> fileNames;
+
+	for (const char* pattern : patterns) {
+
+		vector<String> found;
+		glob(directory + "/" + pattern, found, false);
+		fileNames.insert(fileNames.end(), found.begin(), found.end());
+	}
+
+	sort(fileNames.begin(), fileNames.end());
+
+	for (size_t i = 0; i < fileNames.size(); ++i) {
+
+		Mat image = imread(fileNames[i], IMREAD_COLOR);
+
+		if (!image.empty()) {
+
+			images.push_back(image);
+		}
+	}
+
+	// Die Graubilder werden einmal beim Öffnen umgewandelt
+	if (captureFormat == CAPTURE_FORMAT_LUMINANCE) {
+
+		grayImages.resize(images.size());
+
+		for (size_t i = 0; i < images.size(); ++i) {
+
+			cvtColor(images[i], grayImages[i], COLOR_BGR2GRAY);
+		}
+	}
+}
+
+
+bool ImageDirectoryFrameSource::isOpened() const {
+
+	return !images.empty();
+}
+
+
+bool ImageDirectoryFrameSource::grab() {
+
+	if (images.empty()) {
+
+		return false;
+	}
+
+	if (current + 1 >= (int)images.size()) {
+
+		if (!loop) {
+
+			return false;
+		}
+
+		current = -1;
+	}
+
+	++current;
+	return true;
+}
+
+
+bool ImageDirectoryFrameSource::retrieve(Mat& frame) {
+
+	if (current < 0) {
+
+		return false;
+	}
+
+	if (captureFormat == CAPTURE_FORMAT_LUMINANCE) {
+
+		frame = grayImages[current];
+		lastTouchedBytes = 0;
+		return true;
+	}
+
+	images[current].copyTo(frame);
+	lastTouchedBytes = 2 * (long long)(frame.total() * frame.elemSize());
+	return true;
+}
+
+
+bool ImageDirectoryFrameSource::retrieveColor(Mat& frame) {
+
+	if (current < 0) {
+
+		return false;
+	}
+
+	images[current].copyTo(frame);
+	lastTouchedBytes = 2 * (long long)(frame.total() * frame.elemSize());
+	return true;
+}
+
+
+int ImageDirectoryFrameSource::getCaptureFormat() const {
+
+	return captureFormat;
+}
+
+
+bool ImageDirectoryFrameSource::isFinished() const {
+
+	return !loop && current + 1 >= (int)images.size();
+}
+
+
+SyntheticFrameSource::SyntheticFrameSource(const Size& size, int markerCount, double framesPerSecond, int markerSize,
+	int captureFormat)
+	: size(size), markerSize(0), captureFormat(captureFormat), frameInterval(chrono::steady_clock::duration::zero()),
+	  nextFrameTime(chrono::steady_clock::now()), frameIndex(-1) {
+
+	Ptr<aruco::Dictionary> dictionary = aruco::getPredefinedDictionary(aruco::DICT_4X4_50);
+
+	markerCount = min(max(markerCount, 0), 50);
+
+	// Seitenlänge der Marker, so dass alle nebeneinander und mit Platz für die Bewegung ins Bild passen. Ein Marker
+	// belegt mit seinem weißen Rand 4/3 seiner Seitenlänge
+	int columns = max(1, (int)ceil(sqrt((double)markerCount)));
+	int rows = max(1, (markerCount + columns - 1) / columns);
+	int largestMarkerSize = (min(size.width / columns, size.height / rows) - 2) * 3 / 4;
+
+	this->markerSize = markerSize > 0 ? markerSize : min(size.width, size.height) / (2 * columns + 1);
+	this->markerSize = max(6, min(this->markerSize, largestMarkerSize));
+
+	int border = this->markerSize / 6;
+
+	for (int id = 0; id < markerCount; ++id) {
+
+		Mat marker, withBorder;
+
+		aruco::drawMarker(dictionary, id, this->markerSize, marker, 1);
+
+		// Weißer Rand, damit der Marker auch vor dunklem Hintergrund erkannt wird
+		copyMakeBorder(marker, withBorder, border, border, border, border, BORDER_CONSTANT, Scalar::all(255));
+
+		if (captureFormat == CAPTURE_FORMAT_LUMINANCE) {
+
+			markerImages.push_back(withBorder);
+		}
+		else {
+
+			cvtColor(withBorder, marker, COLOR_GRAY2BGR);
+			markerImages.push_back(marker);
+		}
+	}
+
+	// Neutrale Farbebenen (128), gezeichnet wird bei jedem Bild nur die Y-Ebene
+	if (captureFormat == CAPTURE_FORMAT_LUMINANCE && size.area() > 0) {
+
+		nv12.create(size.height * 3 / 2, size.width, CV_8UC1);
+		nv12.rowRange(size.height, nv12.rows).setTo(Scalar::all(128));
+	}
+
+	if (framesPerSecond > 0.0) {
+
+		frameInterval = chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / framesPerSecond));
+	}
+}
+
+
+int SyntheticFrameSource::getMarkerSize() const {
+
+	return markerSize;
+}
+
+
+bool SyntheticFrameSource::isOpened() const {
+
+	return size.area() > 0;
+}
+
+
+bool SyntheticFrameSource::grab() {
+
+	// Bildrate einer Kamera nachbilden
+	if (frameInterval > chrono::steady_clock::duration::zero()) {
+
+		this_thread::sleep_until(nextFrameTime);
+		nextFrameTime = max(nextFrameTime + frameInterval, chrono::steady_clock::now());
+	}
+
+	++frameIndex;
+	return isOpened();
+}
+
+
+bool SyntheticFrameSource::retrieve(Mat& frame) {
+
+	// Wie bei einer Kamera, die NV12 liefert: Die Y-Ebene wird ohne Kopie weitergegeben
+	if (captureFormat == CAPTURE_FORMAT_LUMINANCE) {
+
+		frame = nv12.rowRange(0, size.height);
+		frame.setTo(Scalar::all(90));
+		drawMarkers(frame);
+		lastTouchedBytes = 0;
+
+		return true;
+	}
+
+	frame.create(size, CV_8UC3);
+	frame.setTo(Scalar(90, 90, 90));
+	drawMarkers(frame);
+
+	// Gezählt wird wie bei einer Kamera das dekodierte Farbbild, nicht das Zeichnen
+	lastTouchedBytes = (long long)(frame.total() * frame.elemSize());
+
+	return true;
+}
+
+
+bool SyntheticFrameSource::retrieveColor(Mat& frame) {
+
+	if (captureFormat != CAPTURE_FORMAT_LUMINANCE) {
+
+		return retrieve(frame);
+	}
+
+	cvtColor(nv12, frame, COLOR_YUV2BGR_NV12);
+	lastTouchedBytes = (long long)(nv12.total() + frame.total() * frame.elemSize());
+
+	return true;
+}
+
+
+int SyntheticFrameSource::getCaptureFormat() const {
+
+	return captureFormat;
+}
+
+
+/* drawMarkers()-Funktion: Zeichnet alle Marker an ihre Position im aktuellen Bild
+		- @param frame: Bild mit dem Typ der Marker (BGR bzw. Graustufen)*/
+void SyntheticFrameSource::drawMarkers(Mat& frame) const {
+
+	int markerCount = (int)markerImages.size();
+	int columns = max(1, (int)ceil(sqrt((double)markerCount)));
+	int rows = max(1, (markerCount + columns - 1) / columns);
+
+	for (int i = 0; i < markerCount; ++i) {
+
+		const Mat& marker = markerImages[i];
+
+		// Jeder Marker kreist um die Mitte seiner Zelle, damit Verfolgung und Bewegung realistisch getestet werden
+		double cellWidth = (double)size.width / columns;
+		double cellHeight = (double)size.height / rows;
+		double angle = frameIndex * 0.05 + i;
+		double radiusX = max(0.0, (cellWidth - marker.cols) / 2.0 - 1.0);
+		double radiusY = max(0.0, (cellHeight - marker.rows) / 2.0 - 1.0);
+
+		int x = (int)((i % columns + 0.5) * cellWidth + radiusX * cos(angle)) - marker.cols / 2;
+		int y = (int)((i / columns + 0.5) * cellHeight + radiusY * sin(angle)) - marker.rows / 2;
+
+		Rect target = Rect(x, y, marker.cols, marker.rows) & Rect(0, 0, size.width, size.height);
+
+		if (target.area() == marker.cols * marker.rows) {
+
+			marker.copyTo(frame(target));
+		}
+	}
+}
+
+
+/* parseOption()-Funktion: Liest eine Zahl aus dem Abfrageteil einer URI (z.B. "markers=4" in "synthetic?markers=4")
+		- @param query: Abfrageteil ohne "?"
+		- @param name: Name der Option
+		- @param defaultValue: Wert, falls die Option fehlt
+		- @param return: Wert der Option*/
+static double parseOption(const string& query, const string& name, double defaultValue) {
+
+	size_t start = 0;
+
+	while (start <= query.size()) {
+
+		size_t end = query.find('&', start);
+
+		if (end == string::npos) {
+
+			end = query.size();
+		}
+
+		string option = query.substr(start, end - start);
+
+		if (option.compare(0, name.size() + 1, name + "=") == 0) {
+
+			return atof(option.c_str() + name.size() + 1);
+		}
+
+		start = end + 1;
+	}
+
+	return defaultValue;
+}
+
+
+unique_ptr<FrameSource> createFrameSource(const string& uri, int captureFormat) {
+
+	string target = uri;
+	string query;
+
+	size_t queryStart = uri.find('?');
+
+	if (queryStart != string::npos) {
+
+		target = uri.substr(0, queryStart);
+		query = uri.substr(queryStart + 1);
+	}
+
+	bool loop = parseOption(query, "loop", 0.0) != 0.0;
+
+	// Nur eine Zahl: Webcam mit diesem Index
+	if (target.empty() || target.find_first_not_of("0123456789") == string::npos) {
+
+		return unique_ptr<FrameSource>(new VideoCaptureFrameSource(target.empty() ? 0 : atoi(target.c_str()),
+			captureFormat));
+	}
+
+	if (target.compare(0, 7, "camera:") == 0) {
+
+		return unique_ptr<FrameSource>(new VideoCaptureFrameSource(atoi(target.c_str() + 7), captureFormat));
+	}
+
+	if (target.compare(0, 5, "file:") == 0) {
+
+		return unique_ptr<FrameSource>(new VideoCaptureFrameSource(target.substr(5), loop, captureFormat));
+	}
+
+	if (target.compare(0, 4, "dir:") == 0) {
+
+		return unique_ptr<FrameSource>(new ImageDirectoryFrameSource(target.substr(4), loop, captureFormat));
+	}
+
+	if (target.compare(0, 9, "synthetic") == 0) {
+
+		Size size(1280, 720);
+
+		if (target.size() > 10 && target[9] == ':') {
+
+			char* end = nullptr;
+			long width = strtol(target.c_str() + 10, &end, 10);
+			long height = *end == 'x' ? strtol(end + 1, nullptr, 10) : 0;
+
+			if (width > 0 && height > 0) {
+
+				size = Size((int)width, (int)height);
+			}
+		}
+
+		return unique_ptr<FrameSource>(new SyntheticFrameSource(size, (int)parseOption(query, "markers", 1.0),
+			parseOption(query, "fps", 0.0), (int)parseOption(query, "size", 0.0), captureFormat));
+	}
+
+	return unique_ptr<FrameSource>(new VideoCaptureFrameSource(uri, loop, captureFormat));
+}
@@ -0,0 +1,203 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <opencv2/core.hpp>
+#include <opencv2/videoio.hpp>
+
+// Formate, in denen eine Bildquelle ihre Bilder an die Pipeline liefert (createFrameSource())
+//		- CAPTURE_FORMAT_BGR: Dekodiertes Farbbild
+//		- CAPTURE_FORMAT_LUMINANCE: Nur die Helligkeit (Graubild), ohne Umwandlung über BGR. Die Erkennung braucht nur
+//		  diese, das Farbbild wird erst auf Anfrage (retrieveColor()) aus den Rohdaten umgewandelt
+const int CAPTURE_FORMAT_BGR = 0;
+const int CAPTURE_FORMAT_LUMINANCE = 1;
+
+/* FrameSource-Klasse: Schnittstelle für alle Bildquellen der Pipeline (Webcam, Videodatei, Bildordner, synthetische
+   Bilder). Das Lesen ist wie bei VideoCapture in grab() (auf das nächste Bild warten) und retrieve() (Bild in den
+   Puffer des Aufrufers schreiben) geteilt. retrieve() schreibt immer in den übergebenen Puffer, so dass bei gleicher
+   Bildgröße kein neuer Speicher angelegt wird. Im Format CAPTURE_FORMAT_LUMINANCE ist das Graubild nach Möglichkeit
+   nur ein Header auf den Puffer der Quelle (Y-Ebene), der bis zum nächsten grab() gültig bleibt*/
+class FrameSource {
+
+public:
+
+	virtual ~FrameSource() {}
+
+	virtual bool isOpened() const = 0;
+
+	/* grab()-Funktion: Wartet auf das nächste Bild
+			- @param return: False, wenn kein Bild mehr gelesen werden kann*/
+	virtual bool grab() = 0;
+
+	/* retrieve()-Funktion: Schreibt das zuletzt mit grab() geholte Bild in den Puffer des Aufrufers
+			- @param frame: Wiederverwendeter Puffer des Aufrufers (BGR bzw. Graustufen im Format CAPTURE_FORMAT_LUMINANCE)
+			- @param return: False, wenn das Bild nicht dekodiert werden konnte*/
+	virtual bool retrieve(cv::Mat& frame) = 0;
+
+	/* retrieveColor()-Funktion: Farbbild des zuletzt mit grab() geholten Bildes für Anzeige und Export. Im Format
+	   CAPTURE_FORMAT_BGR dasselbe wie retrieve(), im Helligkeitsformat wird erst hier aus den Rohdaten umgewandelt
+			- @param frame: Wiederverwendeter Puffer des Aufrufers (BGR)
+			- @param return: False, wenn das Bild nicht umgewandelt werden konnte*/
+	virtual bool retrieveColor(cv::Mat& frame) {
+
+		return retrieve(frame);
+	}
+
+	virtual int getCaptureFormat() const {
+
+		return CAPTURE_FORMAT_BGR;
+	}
+
+	/* isFinished()-Funktion: Unterscheidet das Ende einer endlichen Quelle von einem vorübergehenden Fehler der Kamera
+			- @param return: True, wenn grab() nie wieder ein Bild liefern wird (Datei bzw. Ordner ohne Schleife am Ende)*/
+	virtual bool isFinished() const {
+
+		return false;
+	}
+
+	/* touchedBytes()-Funktion: Bytes, die der letzte Aufruf von retrieve() bzw. retrieveColor() gelesen und
+	   geschrieben hat. Ein Header auf den Puffer der Quelle zählt nichts, ebenso was die Kamera bzw. ihr Treiber selbst
+	   schreibt. Vom Dekodieren innerhalb von VideoCapture ist nur das geschriebene Bild bekannt
+			- @param return: Anzahl der Bytes*/
+	long long touchedBytes() const {
+
+		return lastTouchedBytes;
+	}
+
+	bool read(cv::Mat& frame) {
+
+		return grab() && retrieve(frame);
+	}
+
+protected:
+
+	FrameSource() : lastTouchedBytes(0) {}
+
+	long long lastTouchedBytes;
+};
+
+/* VideoCaptureFrameSource-Klasse: Webcam, Videodatei oder alles andere, was VideoCapture öffnen kann. Im Format
+   CAPTURE_FORMAT_LUMINANCE wird eine Webcam um Rohdaten statt BGR gebeten. Welches Format dann tatsächlich kommt
+   (Graustufen, NV12, YUYV, MJPEG oder doch BGR), hängt von Backend und Kamera ab und wird an jedem Bild erkannt*/
+class VideoCaptureFrameSource : public FrameSource {
+
+public:
+
+	// Webcam mit Index (0 als Standard für eine angeschlossene Kamera)
+	VideoCaptureFrameSource(int cameraInput, int captureFormat);
+
+	// Videodatei (oder URL). Mit loop wird am Ende wieder von vorne begonnen
+	VideoCaptureFrameSource(const std::string& fileName, bool loop, int captureFormat);
+
+	bool isOpened() const override;
+	bool grab() override;
+	bool retrieve(cv::Mat& frame) override;
+	bool retrieveColor(cv::Mat& frame) override;
+	int getCaptureFormat() const override;
+	bool isFinished() const override;
+
+private:
+
+	// Erkannte Anordnung der Rohdaten
+	enum RawLayout { RAW_LAYOUT_BGR, RAW_LAYOUT_GRAY, RAW_LAYOUT_NV12, RAW_LAYOUT_YUYV, RAW_LAYOUT_ENCODED };
+
+	bool extractLuminance(cv::Mat& frame);
+
+	cv::VideoCapture capture;
+	bool loop;
+	int captureFormat;
+
+	// Datei statt Webcam (nur eine Datei kann zu Ende sein) und ob sie es ist
+	bool file, finished;
+
+	// Bildgröße laut Backend (für Rohdaten, die als eine lange Zeile kommen)
+	cv::Size frameSize;
+
+	// Rohdaten des letzten Bildes, ihre Anordnung und ein Header darauf in dieser Anordnung (z.B. alle Ebenen von NV12),
+	// sowie der Puffer für die Helligkeit, falls sie nicht als eigene Ebene vorliegt (YUYV, MJPEG, BGR)
+	cv::Mat raw;
+	RawLayout rawLayout;
+	cv::Mat rawView;
+	cv::Mat luminance;
+};
+
+/* ImageDirectoryFrameSource-Klasse: Alle Bilder eines Ordners (jpg, png, bmp) in alphabetischer Reihenfolge, z.B. die
+   4x4Marker_*.jpg-Dateien. Die Bilder werden beim Öffnen einmal dekodiert, danach wird nur noch kopiert*/
+class ImageDirectoryFrameSource : public FrameSource {
+
+public:
+
+	ImageDirectoryFrameSource(const std::string& directory, bool loop, int captureFormat);
+
+	bool isOpened() const override;
+	bool grab() override;
+	bool retrieve(cv::Mat& frame) override;
+	bool retrieveColor(cv::Mat& frame) override;
+	int getCaptureFormat() const override;
+	bool isFinished() const override;
+
+private:
+
+	// Im Format CAPTURE_FORMAT_LUMINANCE zusätzlich die Graubilder, die ohne Kopie weitergegeben werden
+	std::vector<cv::Mat> images, grayImages;
+	bool loop;
+	int captureFormat;
+	int current;
+};
+
+/* SyntheticFrameSource-Klasse: Erzeugt Bilder mit bewegten ArUco-Markern (DICT_4X4_50) im Speicher. Braucht weder
+   Kamera noch Dateien und ist damit auf jedem Rechner reproduzierbar. Im Format CAPTURE_FORMAT_LUMINANCE verhält sie
+   sich wie eine Kamera, die NV12 liefert: gezeichnet wird nur in die Y-Ebene, die Farbebenen sind neutral*/
+class SyntheticFrameSource : public FrameSource {
+
+public:
+
+	/* SyntheticFrameSource()-Konstruktor
+			- @param size: Bildgröße
+			- @param markerCount: Anzahl der Marker im Bild (IDs 0 bis markerCount - 1)
+			- @param framesPerSecond: Bildrate, mit der grab() Bilder liefert (0 = so schnell wie möglich)
+			- @param markerSize: Seitenlänge eines Markers in Pixeln (0 = automatisch). Wird verkleinert, falls die Marker
+								 sonst nicht ins Bild passen
+			- @param captureFormat: CAPTURE_FORMAT_BGR oder CAPTURE_FORMAT_LUMINANCE*/
+	SyntheticFrameSource(const cv::Size& size, int markerCount, double framesPerSecond, int markerSize = 0,
+		int captureFormat = CAPTURE_FORMAT_BGR);
+
+	/* getMarkerSize()-Funktion: Tatsächliche Seitenlänge eines Markers in Pixeln (ohne weißen Rand)
+			- @param return: Seitenlänge in Pixeln*/
+	int getMarkerSize() const;
+
+	bool isOpened() const override;
+	bool grab() override;
+	bool retrieve(cv::Mat& frame) override;
+	bool retrieveColor(cv::Mat& frame) override;
+	int getCaptureFormat() const override;
+
+private:
+
+	void drawMarkers(cv::Mat& frame) const;
+
+	cv::Size size;
+	int markerSize;
+	int captureFormat;
+
+	// Marker mit weißem Rand (BGR bzw. Graustufen im Helligkeitsformat) und das Bild im Format NV12
+	std::vector<cv::Mat> markerImages;
+	cv::Mat nv12;
+	std::chrono::steady_clock::duration frameInterval;
+	std::chrono::steady_clock::time_point nextFrameTime;
+	long long frameIndex;
+};
+
+/* createFrameSource()-Funktion: Erstellt eine Bildquelle aus einer URI-ähnlichen Angabe:
+		- "0", "camera:0": Webcam mit Index
+		- "file:video.mp4", "file:video.mp4?loop=1": Videodatei (optional in Schleife)
+		- "dir:Bilder", "dir:Bilder?loop=1": Bilder eines Ordners (optional in Schleife)
+		- "synthetic", "synthetic:1920x1080?markers=4&fps=30&size=96": Synthetische Bilder (Standard 1280x720, 1 Marker,
+		  ohne Bildratenbegrenzung, automatische Markergröße)
+		- Alles andere wird direkt an VideoCapture übergeben (Dateiname, URL, ...)
+		- @param uri: Angabe der Quelle
+		- @param captureFormat: CAPTURE_FORMAT_BGR oder CAPTURE_FORMAT_LUMINANCE
+		- @param return: Die Bildquelle (nie nullptr, ob sie geöffnet werden konnte zeigt isOpened())*/
+std::unique_ptr<FrameSource> createFrameSource(const std::string& uri, int captureFormat = CAPTURE_FORMAT_BGR);
@@ -0,0 +1,214 @@
+#include "ImageKernels.h"
+#include "ImageKernelsAVX2.h"
+#include <algorithm>
+#include <climits>
+#include <opencv2/core/hal/intrin.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+// Gewichte der Grauwandlung in 1/256 (Summe 256), so dass B * 29 + G * 150 + R * 77 + 128 in 16 Bits passt
+static const int blueWeight = 29;
+static const int greenWeight = 150;
+static const int redWeight = 77;
+
+
+/* canUseAVX2Kernels()-Funktion: Prüft einmal, ob die AVX2-Varianten übersetzt wurden und die CPU AVX2 unterstützt
+		- @param return: True, wenn die Schleifen aus ImageKernelsAVX2.cpp verwendet werden*/
+static bool canUseAVX2Kernels() {
+
+	static const bool available = avx2KernelsCompiled && checkHardwareSupport(CV_CPU_AVX2);
+
+	return available;
+}
+
+
+void convertToGray(const Mat& image, Mat& gray) {
+
+	CV_Assert(image.depth() == CV_8U && (image.channels() == 1 || image.channels() == 3 || image.channels() == 4));
+
+	const int channels = image.channels();
+
+	if (channels == 1) {
+
+		gray = image;
+		return;
+	}
+
+	gray.create(image.size(), CV_8UC1);
+
+	// Zusammenhängende Bilder werden als eine lange Zeile verarbeitet
+	Size size = image.size();
+
+	if (image.isContinuous() && gray.isContinuous()) {
+
+		size.width *= size.height;
+		size.height = 1;
+	}
+
+	const bool avx2 = canUseAVX2Kernels();
+
+	for (int y = 0; y < size.height; ++y) {
+
+		const uchar* src = image.ptr<uchar>(y);
+		uchar* dst = gray.ptr<uchar>(y);
+		int x = avx2 ? convertToGrayAVX2(src, dst, size.width, channels) : 0;
+
+#if CV_SIMD
+		const int step = v_uint8::nlanes;
+		const v_uint16 vBlue = vx_setall_u16(blueWeight);
+		const v_uint16 vGreen = vx_setall_u16(greenWeight);
+		const v_uint16 vRed = vx_setall_u16(redWeight);
+		const v_uint16 vHalf = vx_setall_u16(128);
+
+		for (; x <= size.width - step; x += step) {
+
+			v_uint8 b, g, r, a;
+
+			if (channels == 3) {
+
+				v_load_deinterleave(src + 3 * x, b, g, r);
+			}
+			else {
+
+				v_load_deinterleave(src + 4 * x, b, g, r, a);
+			}
+
+			v_uint16 b0, b1, g0, g1, r0, r1;
+			v_expand(b, b0, b1);
+			v_expand(g, g0, g1);
+			v_expand(r, r0, r1);
+
+			v_uint16 gray0 = (v_mul_wrap(b0, vBlue) + v_mul_wrap(g0, vGreen) + v_mul_wrap(r0, vRed) + vHalf) >> 8;
+			v_uint16 gray1 = (v_mul_wrap(b1, vBlue) + v_mul_wrap(g1, vGreen) + v_mul_wrap(r1, vRed) + vHalf) >> 8;
+
+			v_store(dst + x, v_pack(gray0, gray1));
+		}
+#endif
+
+		for (; x < size.width; ++x) {
+
+			const uchar* pixel = src + channels * x;
+			dst[x] = (uchar)((pixel[0] * blueWeight + pixel[1] * greenWeight + pixel[2] * redWeight + 128) >> 8);
+		}
+	}
+
+#if CV_SIMD
+	vx_cleanup();
+#endif
+}
+
+
+bool canUseIntegralThreshold(const Size& size) {
+
+	return (double)(size.width + 1) * (size.height + 1) * 255.0 < (double)INT_MAX;
+}
+
+
+/* thresholdPixel()-Funktion: Vergleicht einen Pixel mit dem gerundeten Mittelwert seines Fensters wie
+   adaptiveThreshold(), ohne zu dividieren: round(sum / area) >= t  <=>  2 * sum + area >= 2 * area * t
+		- @param value: Grauwert des Pixels
+		- @param sum: Summe der Grauwerte im Fenster
+		- @param area: Anzahl der Pixel im Fenster
+		- @param delta: Abgerundete Konstante
+		- @param return: 255 für Vordergrund (dunkler als der Mittelwert), sonst 0*/
+static inline uchar thresholdPixel(int value, int sum, int area, int delta) {
+
+	return 2 * sum + area >= 2 * area * (value + delta) ? 255 : 0;
+}
+
+
+void boxThreshold(const Mat& gray, const Mat& integral, int windowSize, double constant, Mat& binary) {
+
+	CV_Assert(gray.type() == CV_8UC1 && integral.type() == CV_32SC1 && windowSize % 2 == 1 &&
+		integral.rows == gray.rows + 1 && integral.cols == gray.cols + 1);
+
+	binary.create(gray.size(), CV_8UC1);
+
+	const int radius = windowSize / 2;
+	const int rows = gray.rows, cols = gray.cols;
+
+	// adaptiveThreshold() rundet die Konstante bei THRESH_BINARY_INV ab
+	const int delta = cvFloor(constant);
+
+	// In diesen Spalten liegt das Fenster horizontal ganz im Bild
+	const int innerBegin = min(radius, cols);
+	const int innerEnd = max(cols - radius, innerBegin);
+
+	const bool avx2 = canUseAVX2Kernels();
+
+	for (int y = 0; y < rows; ++y) {
+
+		const int y0 = max(y - radius, 0);
+		const int y1 = min(y + radius + 1, rows);
+		const int* top = integral.ptr<int>(y0);
+		const int* bottom = integral.ptr<int>(y1);
+		const uchar* src = gray.ptr<uchar>(y);
+		uchar* dst = binary.ptr<uchar>(y);
+
+		int x = 0;
+
+		// Linker Rand: Fenster horizontal abgeschnitten
+		for (; x < innerBegin; ++x) {
+
+			int x0 = 0, x1 = min(x + radius + 1, cols);
+			int sum = bottom[x1] - bottom[x0] - top[x1] + top[x0];
+			dst[x] = thresholdPixel(src[x], sum, (y1 - y0) * (x1 - x0), delta);
+		}
+
+		const int area = (y1 - y0) * windowSize;
+
+		if (avx2) {
+
+			x = boxThresholdAVX2(top, bottom, src, dst, x, innerEnd, radius, area, delta);
+		}
+
+#if CV_SIMD
+		const int step = v_uint8::nlanes;
+		const int lanes = v_int32::nlanes;
+		const v_int32 vArea = vx_setall_s32(area);
+		const v_int32 vDoubleArea = vx_setall_s32(2 * area);
+		const v_int32 vDelta = vx_setall_s32(delta);
+		const v_int32 vOne = vx_setall_s32(1);
+
+		for (; x <= innerEnd - step; x += step) {
+
+			v_int32 masks[4];
+
+			for (int q = 0; q < 4; ++q) {
+
+				const int xq = x + q * lanes;
+
+				v_int32 sum = vx_load(bottom + xq + radius + 1) - vx_load(bottom + xq - radius) -
+					vx_load(top + xq + radius + 1) + vx_load(top + xq - radius);
+				v_int32 value = v_reinterpret_as_s32(v_load_expand_q(src + xq));
+
+				// 2 * sum + area >= 2 * area * (value + delta), als ">" mit um 1 verkleinerter rechter Seite
+				masks[q] = (sum + sum + vArea) > ((value + vDelta) * vDoubleArea - vOne);
+			}
+
+			// Die Masken (0 oder -1) werden auf 8 Bits gepackt, -1 wird dabei zu 255
+			v_store(dst + x, v_reinterpret_as_u8(v_pack(v_pack(masks[0], masks[1]), v_pack(masks[2], masks[3]))));
+		}
+#endif
+
+		for (; x < innerEnd; ++x) {
+
+			int sum = bottom[x + radius + 1] - bottom[x - radius] - top[x + radius + 1] + top[x - radius];
+			dst[x] = thresholdPixel(src[x], sum, area, delta);
+		}
+
+		// Rechter Rand
+		for (; x < cols; ++x) {
+
+			int x0 = max(x - radius, 0), x1 = cols;
+			int sum = bottom[x1] - bottom[x0] - top[x1] + top[x0];
+			dst[x] = thresholdPixel(src[x], sum, (y1 - y0) * (x1 - x0), delta);
+		}
+	}
+
+#if CV_SIMD
+	vx_cleanup();
+#endif
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+/* Vektorisierte Bildoperationen der eigenen Kandidatensuche (FastMarkerDetector). Auf CPUs mit AVX2 laufen die
+   inneren Schleifen über ImageKernelsAVX2.cpp, sonst über die universellen Intrinsics von OpenCV (SSE oder NEON, je nach
+   Grundausstattung des OpenCV-Builds). Ohne SIMD (CV_SIMD == 0) wird derselbe Algorithmus skalar ausgeführt*/
+
+/* convertToGray()-Funktion: Wandelt ein BGR- oder BGRA-Bild in ein Graubild um (Gewichte 29/150/77 von 256, weicht
+   höchstens um eine Graustufe von cvtColor() ab). Ein Graubild wird ohne Kopie übernommen
+		- @param image: Eingabebild (CV_8UC1, CV_8UC3 oder CV_8UC4)
+		- @param gray: Ausgabe des Graubildes (CV_8UC1)*/
+void convertToGray(const cv::Mat& image, cv::Mat& gray);
+
+/* canUseIntegralThreshold()-Funktion: Prüft, ob die Summen eines Bildes dieser Größe in das Integralbild (CV_32S)
+   passen. Größere Bilder müssen über adaptiveThreshold() gehen
+		- @param size: Bildgröße
+		- @param return: True bis etwa 8 Megapixel (3840x2160)*/
+bool canUseIntegralThreshold(const cv::Size& size);
+
+/* boxThreshold()-Funktion: Entspricht adaptiveThreshold() mit ADAPTIVE_THRESH_MEAN_C und THRESH_BINARY_INV, der
+   Mittelwert jedes Fensters wird aber aus dem Integralbild gelesen. Das Integralbild wird einmal pro Bild berechnet
+   und von allen Fenstergrößen geteilt, statt für jede Fenstergröße einen eigenen Boxfilter laufen zu lassen. Am
+   Bildrand wird nur über den Teil des Fensters im Bild gemittelt (adaptiveThreshold() wiederholt dort den Randpixel)
+		- @param gray: Graubild (CV_8UC1)
+		- @param integral: Integralbild von gray (CV_32SC1, eine Zeile und Spalte größer, siehe cv::integral())
+		- @param windowSize: Ungerade Kantenlänge des Fensters
+		- @param constant: Vom Mittelwert abgezogene Konstante (adaptiveThreshConstant)
+		- @param binary: Ausgabe, 255 wo gray um mindestens constant dunkler als der Mittelwert ist, sonst 0*/
+void boxThreshold(const cv::Mat& gray, const cv::Mat& integral, int windowSize, double constant, cv::Mat& binary);
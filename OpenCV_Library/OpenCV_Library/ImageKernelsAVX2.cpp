@@ -0,0 +1,112 @@
+#include "ImageKernelsAVX2.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+using namespace cv;
+
+
+#if defined(__AVX2__)
+
+const bool avx2KernelsCompiled = true;
+
+
+int convertToGrayAVX2(const uchar* src, uchar* dst, int width, int channels) {
+
+	// Gewichte pro Pixel (B, G, R, A) als 16-Bit-Paare für _mm256_madd_epi16, wie in ImageKernels.cpp
+	const __m256i weights = _mm256_setr_epi16(29, 150, 77, 0, 29, 150, 77, 0, 29, 150, 77, 0, 29, 150, 77, 0);
+	const __m256i half = _mm256_set1_epi32(128);
+
+	// hadd liefert die Pixel in der Reihenfolge 0, 1, 4, 5, 2, 3, 6, 7
+	const __m256i order = _mm256_setr_epi32(0, 1, 4, 5, 2, 3, 6, 7);
+
+	// BGR: 4 Pixel (12 Bytes) pro 128-Bit-Hälfte auf 4 Bytes pro Pixel verteilen, das vierte Byte wird 0
+	const __m256i spread = _mm256_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1,
+		0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+
+	int x = 0;
+
+	// Bei BGR liest die zweite Hälfte 16 Bytes ab Pixel x + 4, es müssen also 28 Bytes lesbar sein
+	const int end = channels == 3 ? width - 10 : width - 8;
+
+	for (; x <= end; x += 8) {
+
+		__m256i pixels;
+
+		if (channels == 3) {
+
+			const uchar* p = src + 3 * x;
+			pixels = _mm256_inserti128_si256(_mm256_castsi128_si256(_mm_loadu_si128((const __m128i*)p)),
+				_mm_loadu_si128((const __m128i*)(p + 12)), 1);
+			pixels = _mm256_shuffle_epi8(pixels, spread);
+		}
+		else {
+
+			pixels = _mm256_loadu_si256((const __m256i*)(src + 4 * x));
+		}
+
+		__m256i low = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm256_castsi256_si128(pixels)), weights);
+		__m256i high = _mm256_madd_epi16(_mm256_cvtepu8_epi16(_mm256_extracti128_si256(pixels, 1)), weights);
+
+		__m256i gray = _mm256_srli_epi32(_mm256_add_epi32(_mm256_hadd_epi32(low, high), half), 8);
+		gray = _mm256_permutevar8x32_epi32(gray, order);
+
+		__m128i words = _mm_packus_epi32(_mm256_castsi256_si128(gray), _mm256_extracti128_si256(gray, 1));
+		_mm_storel_epi64((__m128i*)(dst + x), _mm_packus_epi16(words, words));
+	}
+
+	return x;
+}
+
+
+int boxThresholdAVX2(const int* top, const int* bottom, const uchar* src, uchar* dst, int begin, int end,
+	int radius, int area, int delta) {
+
+	const __m256i vArea = _mm256_set1_epi32(area);
+	const __m256i vDoubleArea = _mm256_set1_epi32(2 * area);
+	const __m256i vDelta = _mm256_set1_epi32(delta);
+	const __m256i vOne = _mm256_set1_epi32(1);
+
+	int x = begin;
+
+	for (; x <= end - 8; x += 8) {
+
+		__m256i sum = _mm256_add_epi32(
+			_mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(bottom + x + radius + 1)),
+				_mm256_loadu_si256((const __m256i*)(bottom + x - radius))),
+			_mm256_sub_epi32(_mm256_loadu_si256((const __m256i*)(top + x - radius)),
+				_mm256_loadu_si256((const __m256i*)(top + x + radius + 1))));
+
+		__m256i value = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(src + x)));
+
+		// 2 * sum + area >= 2 * area * (value + delta), als ">" mit um 1 verkleinerter rechter Seite
+		__m256i mask = _mm256_cmpgt_epi32(_mm256_add_epi32(_mm256_add_epi32(sum, sum), vArea),
+			_mm256_sub_epi32(_mm256_mullo_epi32(_mm256_add_epi32(value, vDelta), vDoubleArea), vOne));
+
+		// Die Masken (0 oder -1) werden auf 8 Bits gepackt, -1 wird dabei zu 255
+		__m128i words = _mm_packs_epi32(_mm256_castsi256_si128(mask), _mm256_extracti128_si256(mask, 1));
+		_mm_storel_epi64((__m128i*)(dst + x), _mm_packs_epi16(words, words));
+	}
+
+	return x;
+}
+
+#else
+
+// Ohne AVX2 übersetzt (z.B. ARM), die Funktionen werden dann nicht aufgerufen
+const bool avx2KernelsCompiled = false;
+
+
+int convertToGrayAVX2(const uchar*, uchar*, int, int) {
+
+	return 0;
+}
+
+
+int boxThresholdAVX2(const int*, const int*, const uchar*, uchar*, int begin, int, int, int, int) {
+
+	return begin;
+}
+
+#endif
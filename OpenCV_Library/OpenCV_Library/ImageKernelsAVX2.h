@@ -0,0 +1,36 @@
+#pragma once
+
+#include <opencv2/core.hpp>
+
+/* AVX2-Varianten der inneren Schleifen von ImageKernels.cpp. Die universellen Intrinsics von OpenCV richten sich nach
+   der Grundausstattung, mit der OpenCV selbst übersetzt wurde (bei den fertigen Paketen SSE), und nicht nach den
+   Compiler-Optionen dieses Projekts. Deshalb wird nur ImageKernelsAVX2.cpp mit AVX2 übersetzt (/arch:AVX2 bzw. -mavx2)
+   und nur aufgerufen, wenn die CPU AVX2 unterstützt (canUseAVX2Kernels() in ImageKernels.cpp). Die Bibliothek bleibt
+   damit auf Prozessoren ohne AVX2 lauffähig. Die Ergebnisse sind bitgleich mit den skalaren Schleifen*/
+
+// True, wenn ImageKernelsAVX2.cpp mit AVX2 übersetzt wurde. Eine Konstante statt einer Funktion, damit vor der Prüfung
+// der CPU kein mit AVX2 übersetzter Code läuft
+extern const bool avx2KernelsCompiled;
+
+/* convertToGrayAVX2()-Funktion: Grauwandlung einer Zeile mit 8 Pixeln pro Schritt (Gewichte wie convertToGray())
+		- @param src: Zeile des BGR- oder BGRA-Bildes
+		- @param dst: Zeile des Graubildes
+		- @param width: Anzahl der Pixel der Zeile
+		- @param channels: 3 oder 4
+		- @param return: Anzahl der umgewandelten Pixel ab dem Anfang der Zeile, den Rest übernimmt der Aufrufer*/
+int convertToGrayAVX2(const cv::uchar* src, cv::uchar* dst, int width, int channels);
+
+/* boxThresholdAVX2()-Funktion: Schwellwert einer Zeile mit 8 Pixeln pro Schritt, nur wo das Fenster horizontal ganz im
+   Bild liegt (Vergleich wie thresholdPixel() in ImageKernels.cpp)
+		- @param top: Zeile des Integralbilds über dem Fenster
+		- @param bottom: Zeile des Integralbilds unter dem Fenster
+		- @param src: Zeile des Graubildes
+		- @param dst: Zeile des Binärbildes
+		- @param begin: Erste Spalte
+		- @param end: Spalte hinter der letzten
+		- @param radius: Halbe Fenstergröße
+		- @param area: Anzahl der Pixel im Fenster
+		- @param delta: Abgerundete Konstante
+		- @param return: Erste Spalte, die nicht mehr bearbeitet wurde*/
+int boxThresholdAVX2(const int* top, const int* bottom, const cv::uchar* src, cv::uchar* dst, int begin, int end,
+	int radius, int area, int delta);
@@ -0,0 +1,407 @@
+#include "MarkerDetector.h"
+#include <algorithm>
+#include <opencv2/imgproc.hpp>
+
+using namespace std;
+using namespace cv;
+
+// Mindestgröße eines Markers im verkleinerten Bild in Pixeln, ab der er noch zuverlässig erkannt und dekodiert wird
+// (4x4 Bits plus Rand = 6 Zellen mit je 4 Pixeln)
+const double minimumScaledMarkerPixels = 24.0;
+
+// Kleinste erlaubte Skalierung, damit auch die automatische Wahl das Bild nicht beliebig verkleinert
+const float minimumPyramidScale = 0.125f;
+
+
+DetectorSettings defaultDetectorSettings() {
+
+	DetectorSettings settings;
+
+	settings.trackingEnabled = 1;
+	settings.fullScanInterval = 15;
+	settings.roiMargin = 0.5f;
+	settings.minRoiSize = 64;
+	settings.pyramidScale = 1.0f;
+	settings.maxMarkerDistance = 2.0f;
+	settings.motionThreshold = 4.0f;
+	settings.staticRefreshInterval = 30;
+	settings.candidateSearch = CANDIDATE_SEARCH_FAST;
+	settings.tileMarkerSize = 0;
+
+	return settings;
+}
+
+
+MarkerDetector::MarkerDetector()
+	: parameters(aruco::DetectorParameters::create()), settings(defaultDetectorSettings()),
+	  pendingSettings(defaultDetectorSettings()), hasPendingSettings(false), focalLength(0.0), markerLength(0.0), effectiveScale(1.0f),
+	  framesSinceFullScan(0), framesSinceDetection(0) {
+
+	// Im Voraus für je 16 Marker in Ausgabe, letztem Ergebnis und Ausschnitten, mehr werden beim Aufwärmen angelegt
+	cornerPool.reserve(3 * 16);
+}
+
+
+void MarkerDetector::setDictionary(const Ptr<aruco::Dictionary>& dictionary) {
+
+	this->dictionary = dictionary;
+	fastDetector.setDictionary(dictionary);
+	tiledDetector.setDictionary(dictionary);
+	reset();
+}
+
+
+void MarkerDetector::setMarkerGeometry(double focalLength, double markerLength) {
+
+	this->focalLength = focalLength;
+	this->markerLength = markerLength;
+	updateEffectiveScale();
+}
+
+
+void MarkerDetector::setSettings(const DetectorSettings& settings) {
+
+	lock_guard<mutex> lock(settingsMutex);
+	pendingSettings = settings;
+	hasPendingSettings.store(true, memory_order_release);
+}
+
+
+DetectorSettings MarkerDetector::getSettings() {
+
+	lock_guard<mutex> lock(settingsMutex);
+	return hasPendingSettings.load(memory_order_relaxed) ? pendingSettings : settings;
+}
+
+
+void MarkerDetector::reset() {
+
+	cornerPool.resize(previousCorners, 0);
+	previousIds.clear();
+	framesSinceFullScan = 0;
+	motionGate.reset();
+	framesSinceDetection = 0;
+}
+
+
+float MarkerDetector::getEffectiveScale() const {
+
+	return effectiveScale;
+}
+
+
+/* updateEffectiveScale()-Funktion: Bestimmt die Skalierung für die Kandidatensuche. Bei pyramidScale = 0 wird sie so
+   gewählt, dass ein Marker im größten erwarteten Abstand (Seitenlänge f * markerLength / maxMarkerDistance Pixel) im
+   verkleinerten Bild noch minimumScaledMarkerPixels groß ist*/
+void MarkerDetector::updateEffectiveScale() {
+
+	float scale = settings.pyramidScale;
+
+	if (scale <= 0.0f) {
+
+		scale = 1.0f;
+
+		if (focalLength > 0.0 && markerLength > 0.0 && settings.maxMarkerDistance > 0.0f) {
+
+			double expectedMarkerPixels = focalLength * markerLength / settings.maxMarkerDistance;
+			scale = (float)(minimumScaledMarkerPixels / expectedMarkerPixels);
+		}
+	}
+
+	effectiveScale = min(max(scale, minimumPyramidScale), 1.0f);
+}
+
+
+/* applyPendingSettings()-Funktion: Übernimmt die zuletzt mit setSettings() gesetzten Einstellungen. Ohne neue
+   Einstellungen kostet der Aufruf nur das Lesen eines atomaren Flags*/
+void MarkerDetector::applyPendingSettings() {
+
+	if (!hasPendingSettings.load(memory_order_acquire)) {
+
+		return;
+	}
+
+	lock_guard<mutex> lock(settingsMutex);
+	settings = pendingSettings;
+	hasPendingSettings.store(false, memory_order_relaxed);
+	updateEffectiveScale();
+
+	// Geänderte Einstellungen gelten ab einer vollen Suche
+	reset();
+}
+
+
+int MarkerDetector::detect(const Mat& frame, vector<vector<Point2f>>& corners, vector<int>& ids) {
+
+	applyPendingSettings();
+
+	bool gated = settings.motionThreshold > 0.0f;
+
+	// Unveränderte Szene: Ergebnis des letzten erkannten Bildes wiederholen (kopiert nur die wenigen Ecken)
+	if (gated && !motionGate.hasChanged(frame, settings.motionThreshold) &&
+		framesSinceDetection < settings.staticRefreshInterval) {
+
+		++framesSinceDetection;
+		cornerPool.assign(corners, previousCorners);
+		ids = previousIds;
+
+		return DETECTION_PATH_SKIPPED;
+	}
+
+	int path = DETECTION_PATH_FULL;
+
+	bool useRegions = settings.trackingEnabled != 0 && !previousIds.empty() &&
+		framesSinceFullScan < settings.fullScanInterval;
+
+	// Wird ein bekannter Marker in seinem Ausschnitt nicht mehr gefunden, gilt die Verfolgung als verloren und es wird
+	// sofort das ganze Bild durchsucht
+	if (useRegions && detectInRegions(frame, corners, ids)) {
+
+		path = DETECTION_PATH_ROI;
+		++framesSinceFullScan;
+	}
+	else {
+
+		detectFull(frame, corners, ids);
+		framesSinceFullScan = 0;
+	}
+
+	cornerPool.assign(previousCorners, corners);
+	previousIds = ids;
+
+	if (gated) {
+
+		motionGate.accept();
+	}
+
+	framesSinceDetection = 0;
+
+	return path;
+}
+
+
+/* detectFull()-Funktion: Normale Markererkennung über das ganze Bild*/
+void MarkerDetector::detectFull(const Mat& frame, vector<vector<Point2f>>& corners, vector<int>& ids) {
+
+	detectScaled(frame, corners, ids);
+}
+
+
+/* detectScaled()-Funktion: Markererkennung in einem Bild oder Ausschnitt. Ist die Skalierung kleiner als 1, werden die
+   Kandidaten (Schwellwert und Konturen, der teuerste Teil von detectMarkers()) in einer verkleinerten Kopie gesucht.
+   Die gefundenen Ecken werden auf die volle Auflösung hochgerechnet und dort subpixelgenau verfeinert, damit die
+   Posenschätzung nicht an Genauigkeit verliert
+		- @param image: Eingabebild in voller Auflösung
+		- @param corners: Ausgabe der erkannten Markerecken in Koordinaten von image
+		- @param ids: Ausgabe der erkannten Marker-IDs*/
+void MarkerDetector::detectScaled(const Mat& image, vector<vector<Point2f>>& corners, vector<int>& ids) {
+
+	if (effectiveScale >= 1.0f) {
+
+		detectMarkers(image, 1.0f, corners, ids);
+		return;
+	}
+
+	// Dieselbe Zielgröße, die resize() aus dem Faktor berechnet, damit es in den Ausschnitt des Puffers schreibt
+	const Size scaledSize(saturate_cast<int>(image.cols * (double)effectiveScale),
+		saturate_cast<int>(image.rows * (double)effectiveScale));
+
+	scaledImage = workspaceImage(scaledBuffer, scaledSize, image.type());
+	resize(image, scaledImage, Size(), effectiveScale, effectiveScale, INTER_AREA);
+	detectMarkers(scaledImage, effectiveScale, corners, ids);
+
+	// INTER_AREA bildet Pixelmitten ab: x_voll = (x_klein + 0.5) / scale - 0.5
+	const float inverseScale = 1.0f / effectiveScale;
+	const float offset = 0.5f * inverseScale - 0.5f;
+
+	for (size_t i = 0; i < corners.size(); ++i) {
+
+		for (size_t c = 0; c < corners[i].size(); ++c) {
+
+			corners[i][c].x = corners[i][c].x * inverseScale + offset;
+			corners[i][c].y = corners[i][c].y * inverseScale + offset;
+		}
+	}
+
+	refineCorners(image, corners);
+}
+
+
+/* detectMarkers()-Funktion: Nimmt für Lexika mit 4x4 Bits den schnellen Weg über FastMarkerDetector, sonst (bzw. mit
+   CANDIDATE_SEARCH_ARUCO, eingeschalteter Eckenverfeinerung durch aruco oder detectInvertedMarker) den allgemeinen Weg
+   über aruco::detectMarkers(). Mit tileMarkerSize wird ein großes Bild in Kacheln parallel durchsucht
+		- @param image: Eingabebild
+		- @param scale: Skalierung von image gegenüber der vollen Auflösung (für die Markergröße der Kacheln)
+		- @param corners: Ausgabe der erkannten Markerecken
+		- @param ids: Ausgabe der erkannten Marker-IDs*/
+void MarkerDetector::detectMarkers(const Mat& image, float scale, vector<vector<Point2f>>& corners, vector<int>& ids) {
+
+	const bool fastSearch = settings.candidateSearch == CANDIDATE_SEARCH_FAST && fastDetector.isActive() &&
+		parameters->cornerRefinementMethod == aruco::CORNER_REFINE_NONE && !parameters->detectInvertedMarker;
+
+	// Passt das Bild (z.B. ein Ausschnitt der Verfolgung) in eine Kachel, wird wie gewohnt erkannt
+	if (settings.tileMarkerSize > 0 && tiledDetector.detect(image, *parameters, cvCeil(settings.tileMarkerSize * scale),
+		fastSearch, corners, ids, cornerPool)) {
+
+		return;
+	}
+
+	if (fastSearch) {
+
+		fastDetector.detect(image, *parameters, corners, ids, cornerPool);
+		return;
+	}
+
+	aruco::detectMarkers(image, dictionary, corners, ids, parameters);
+}
+
+
+/* refineCorners()-Funktion: Verfeinert die hochgerechneten Ecken mit cornerSubPix() in voller Auflösung. Es wird nur
+   ein Graustufen-Ausschnitt um jeden Marker umgewandelt, nicht das ganze Bild
+		- @param image: Eingabebild in voller Auflösung
+		- @param corners: Markerecken in Koordinaten von image, werden verfeinert*/
+void MarkerDetector::refineCorners(const Mat& image, vector<vector<Point2f>>& corners) {
+
+	// Das Suchfenster muss den Fehler der Hochrechnung (etwa 1 / scale Pixel) abdecken
+	const int halfWindow = cvCeil(1.0f / effectiveScale) + 1;
+	const TermCriteria criteria(TermCriteria::COUNT | TermCriteria::EPS, 20, 0.01);
+	const Rect imageRect(0, 0, image.cols, image.rows);
+
+	for (size_t i = 0; i < corners.size(); ++i) {
+
+		Rect box = boundingRect(corners[i]);
+		box.x -= halfWindow + 1;
+		box.y -= halfWindow + 1;
+		box.width += 2 * (halfWindow + 1);
+		box.height += 2 * (halfWindow + 1);
+		box &= imageRect;
+
+		if (box.empty()) {
+
+			continue;
+		}
+
+		if (image.channels() == 1) {
+
+			grayPatch = image(box);
+		}
+		else {
+
+			grayPatch = workspaceImage(grayPatchBuffer, box.size(), CV_8UC1);
+			cvtColor(image(box), grayPatch, image.channels() == 4 ? COLOR_BGRA2GRAY : COLOR_BGR2GRAY);
+		}
+
+		for (size_t c = 0; c < corners[i].size(); ++c) {
+
+			corners[i][c].x -= box.x;
+			corners[i][c].y -= box.y;
+		}
+
+		cornerSubPix(grayPatch, corners[i], Size(halfWindow, halfWindow), Size(-1, -1), criteria);
+
+		for (size_t c = 0; c < corners[i].size(); ++c) {
+
+			corners[i][c].x += box.x;
+			corners[i][c].y += box.y;
+		}
+	}
+}
+
+
+/* buildRegions()-Funktion: Bestimmt die Suchausschnitte aus den Ecken des letzten Bildes. Jeder Marker bekommt sein
+   umgebendes Rechteck, vergrößert um roiMargin. Überlappende Ausschnitte werden zusammengefasst, damit kein Bereich
+   doppelt durchsucht wird
+		- @param frameSize: Größe des Bildes, auf die die Ausschnitte begrenzt werden*/
+void MarkerDetector::buildRegions(const Size& frameSize) {
+
+	const Rect frameRect(0, 0, frameSize.width, frameSize.height);
+
+	regions.clear();
+
+	for (size_t i = 0; i < previousCorners.size(); ++i) {
+
+		Rect box = boundingRect(previousCorners[i]);
+
+		int margin = cvCeil(max(box.width, box.height) * settings.roiMargin);
+		int width = max(box.width + 2 * margin, settings.minRoiSize);
+		int height = max(box.height + 2 * margin, settings.minRoiSize);
+
+		Rect region(box.x + box.width / 2 - width / 2, box.y + box.height / 2 - height / 2, width, height);
+		region &= frameRect;
+
+		if (!region.empty()) {
+
+			regions.push_back(region);
+		}
+	}
+
+	// Überlappende Ausschnitte so lange vereinigen, bis keine Überlappung mehr besteht
+	bool merged = true;
+
+	while (merged) {
+
+		merged = false;
+
+		for (size_t a = 0; a < regions.size() && !merged; ++a) {
+
+			for (size_t b = a + 1; b < regions.size(); ++b) {
+
+				if ((regions[a] & regions[b]).area() > 0) {
+
+					regions[a] |= regions[b];
+					regions.erase(regions.begin() + b);
+					merged = true;
+					break;
+				}
+			}
+		}
+	}
+}
+
+
+/* detectInRegions()-Funktion: Sucht die Marker nur in den Ausschnitten um die bekannten Marker. Die Ausschnitte sind
+   nur Mat-Header auf das Originalbild, es wird nichts kopiert
+		- @param return: False, wenn mindestens ein bekannter Marker nicht wiedergefunden wurde (Verfolgung verloren)*/
+bool MarkerDetector::detectInRegions(const Mat& frame, vector<vector<Point2f>>& corners, vector<int>& ids) {
+
+	buildRegions(frame.size());
+
+	cornerPool.resize(corners, 0);
+	ids.clear();
+
+	for (size_t r = 0; r < regions.size(); ++r) {
+
+		const Rect& region = regions[r];
+
+		detectScaled(frame(region), regionCorners, regionIds);
+
+		for (size_t i = 0; i < regionIds.size(); ++i) {
+
+			// Ein Marker kann nur einmal vorkommen, auch wenn er in einem weiteren Ausschnitt teilweise sichtbar ist
+			if (find(ids.begin(), ids.end(), regionIds[i]) != ids.end()) {
+
+				continue;
+			}
+
+			// Ecken vom Ausschnitt zurück in Bildkoordinaten verschieben
+			for (size_t c = 0; c < regionCorners[i].size(); ++c) {
+
+				regionCorners[i][c].x += region.x;
+				regionCorners[i][c].y += region.y;
+			}
+
+			ids.push_back(regionIds[i]);
+			cornerPool.append(corners) = regionCorners[i];
+		}
+	}
+
+	for (size_t i = 0; i < previousIds.size(); ++i) {
+
+		if (find(ids.begin(), ids.end(), previousIds[i]) == ids.end()) {
+
+			return false;
+		}
+	}
+
+	return true;
+}
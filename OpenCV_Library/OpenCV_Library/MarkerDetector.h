@@ -0,0 +1,162 @@
+#pragma once
+
+#include <vector>
+#include <mutex>
+#include <atomic>
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+#include "MotionGate.h"
+#include "FastMarkerDetector.h"
+#include "TiledMarkerDetector.h"
+#include "Workspace.h"
+
+// Welcher Weg bei der letzten Erkennung genommen wurde
+const int DETECTION_PATH_FULL = 0;
+const int DETECTION_PATH_ROI = 1;
+const int DETECTION_PATH_SKIPPED = 2;
+
+// Wie die Markerkandidaten gesucht werden (DetectorSettings::candidateSearch)
+const int CANDIDATE_SEARCH_ARUCO = 0;
+const int CANDIDATE_SEARCH_FAST = 1;
+
+/* DetectorSettings-Struktur: Einstellungen der Markererkennung, wie sie über setDetectorSettings() aus C# gesetzt
+   werden. Nur Werttypen, damit die Struktur direkt aus C# übergeben werden kann (siehe CubeScript.cs)*/
+struct DetectorSettings {
+
+	// 1 = Verfolgung der bekannten Marker in Bildausschnitten (ROI), 0 = immer das ganze Bild durchsuchen
+	int trackingEnabled;
+
+	// Spätestens nach so vielen Bildern wird wieder das ganze Bild durchsucht, damit neue Marker gefunden werden
+	int fullScanInterval;
+
+	// Vergrößerung des Ausschnitts um einen Marker, relativ zur größeren Seite seines umgebenden Rechtecks
+	float roiMargin;
+
+	// Mindestgröße eines Ausschnitts in Pixeln (Breite und Höhe)
+	int minRoiSize;
+
+	// Skalierung für die Suche nach Markerkandidaten: 1 = volle Auflösung, 0 < x < 1 = Suche im verkleinerten Bild mit
+	// anschließender Verfeinerung der Ecken in voller Auflösung, 0 = automatisch aus Kalibrierung und maxMarkerDistance
+	float pyramidScale;
+
+	// Größter erwarteter Abstand eines Markers zur Kamera in Metern (nur für pyramidScale = 0)
+	float maxMarkerDistance;
+
+	// Ändert sich kein 16x16-Block des Graubildes seit der letzten Erkennung um mehr als so viele Graustufen, wird die
+	// Erkennung übersprungen und das letzte Ergebnis wiederholt (0 = immer erkennen)
+	float motionThreshold;
+
+	// Spätestens nach so vielen übersprungenen Bildern wird wieder erkannt, auch wenn sich das Bild nicht verändert hat
+	int staticRefreshInterval;
+
+	// CANDIDATE_SEARCH_FAST = eigene vektorisierte Kandidatensuche (FastMarkerDetector, Standard) für Lexika mit 4x4
+	// Bits, andere Lexika nehmen automatisch aruco::detectMarkers(). CANDIDATE_SEARCH_ARUCO = immer aruco::detectMarkers()
+	int candidateSearch;
+
+	// Größte erwartete Seite eines Markers im Bild in Pixeln (volle Auflösung), unabhängig von seiner Drehung. Größer 0 =
+	// große Bilder werden in sich um die Diagonale dieser Größe überlappende Kacheln aufgeteilt und parallel durchsucht
+	// (TiledMarkerDetector), 0 = aus
+	int tileMarkerSize;
+};
+
+/* defaultDetectorSettings()-Funktion: Standardeinstellungen (Verfolgung aktiv, alle 15 Bilder eine volle Suche)
+		- @param return: Standardeinstellungen*/
+DetectorSettings defaultDetectorSettings();
+
+/* MarkerDetector-Klasse: Kapselt aruco::detectMarkers(). Im Verfolgungsmodus werden die Ecken des letzten Bildes
+   verwendet, um nur vergrößerte Ausschnitte um die bekannten Marker zu durchsuchen. Das ganze Bild wird nur alle
+   fullScanInterval Bilder durchsucht oder sobald ein bekannter Marker in seinem Ausschnitt nicht mehr gefunden wird.
+   Vor der Erkennung prüft ein MotionGate, ob sich das Bild überhaupt verändert hat. Bei unveränderter Szene wird das
+   letzte Ergebnis wiederholt (DETECTION_PATH_SKIPPED). Für Lexika mit 4x4 Bits wird statt detectMarkers() der
+   FastMarkerDetector verwendet, solange candidateSearch auf CANDIDATE_SEARCH_FAST (Standard) steht. Mit tileMarkerSize werden
+   große Bilder in Kacheln parallel durchsucht*/
+class MarkerDetector {
+
+public:
+
+	MarkerDetector();
+
+	void setDictionary(const cv::Ptr<cv::aruco::Dictionary>& dictionary);
+
+	/* setMarkerGeometry()-Funktion: Angaben für die automatische Wahl der Skalierung (pyramidScale = 0). Muss im Thread
+	   von detect() aufgerufen werden
+			- @param focalLength: Brennweite in Pixeln (aus der Kameramatrix)
+			- @param markerLength: Seitenlänge der Marker in Metern*/
+	void setMarkerGeometry(double focalLength, double markerLength);
+
+	/* setSettings()-Funktion: Setzt neue Einstellungen. Darf aus einem anderen Thread als detect() aufgerufen werden,
+	   die Einstellungen werden dann beim nächsten Aufruf von detect() übernommen
+			- @param settings: Neue Einstellungen*/
+	void setSettings(const DetectorSettings& settings);
+	DetectorSettings getSettings();
+
+	/* detect()-Funktion: Erkennt die Marker im Bild
+			- @param frame: Eingabebild (Webcam)
+			- @param corners: Ausgabe der erkannten Markerecken (Nx4). Die Liste wird immer über den Pool des Detektors
+							  verkleinert und vergrößert und sollte außerhalb nur gelesen werden
+			- @param ids: Ausgabe der erkannten Marker-IDs (N)
+			- @param return: DETECTION_PATH_FULL oder DETECTION_PATH_ROI, je nachdem welcher Weg genommen wurde, bzw.
+							 DETECTION_PATH_SKIPPED, wenn sich das Bild nicht verändert hat (corners und ids sind dann
+							 das Ergebnis des letzten erkannten Bildes)*/
+	int detect(const cv::Mat& frame, std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids);
+
+	/* reset()-Funktion: Vergisst alle verfolgten Marker, das nächste Bild wird ganz durchsucht*/
+	void reset();
+
+	/* getEffectiveScale()-Funktion: Tatsächlich verwendete Skalierung für die Kandidatensuche
+			- @param return: 1 = volle Auflösung, sonst der Verkleinerungsfaktor*/
+	float getEffectiveScale() const;
+
+private:
+
+	void applyPendingSettings();
+	void detectFull(const cv::Mat& frame, std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids);
+	bool detectInRegions(const cv::Mat& frame, std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids);
+	void buildRegions(const cv::Size& frameSize);
+	void detectScaled(const cv::Mat& image, std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids);
+	void detectMarkers(const cv::Mat& image, float scale, std::vector<std::vector<cv::Point2f>>& corners,
+		std::vector<int>& ids);
+	void refineCorners(const cv::Mat& image, std::vector<std::vector<cv::Point2f>>& corners);
+	void updateEffectiveScale();
+
+	cv::Ptr<cv::aruco::Dictionary> dictionary;
+	cv::Ptr<cv::aruco::DetectorParameters> parameters;
+
+	// Schneller Weg für Lexika mit 4x4 Bits, sonst aruco::detectMarkers()
+	FastMarkerDetector fastDetector;
+
+	// Aufteilung großer Bilder in Kacheln (nur mit tileMarkerSize > 0)
+	TiledMarkerDetector tiledDetector;
+
+	// Aktive Einstellungen (nur im Thread von detect()) und die zuletzt gesetzten, noch nicht übernommenen Einstellungen
+	DetectorSettings settings;
+	std::mutex settingsMutex;
+	DetectorSettings pendingSettings;
+	std::atomic<bool> hasPendingSettings;
+
+	// Brennweite und Markergröße für die automatische Skalierung sowie die daraus bzw. aus pyramidScale bestimmte Skalierung
+	double focalLength, markerLength;
+	float effectiveScale;
+
+	// Ergebnis des letzten Bildes als Ausgangspunkt für die Verfolgung
+	std::vector<std::vector<cv::Point2f>> previousCorners;
+	std::vector<int> previousIds;
+	int framesSinceFullScan;
+
+	// Vorprüfung auf Veränderung und Anzahl der seit der letzten Erkennung übersprungenen Bilder
+	MotionGate motionGate;
+	int framesSinceDetection;
+
+	// Wiederverwendete Puffer für die Suche in den Ausschnitten
+	std::vector<cv::Rect> regions;
+	std::vector<std::vector<cv::Point2f>> regionCorners;
+	std::vector<int> regionIds;
+
+	// Wiederverwendete Puffer für die Suche im verkleinerten Bild und die Verfeinerung der Ecken (Ausschnitte der Puffer,
+	// weil sich die Größe mit jedem Ausschnitt bzw. Marker ändert)
+	cv::Mat scaledImage, scaledBuffer, grayPatch, grayPatchBuffer;
+
+	// Pool für alle Eckenlisten, die detect() verkleinert und vergrößert (Ausgabe, letztes Ergebnis, Ausschnitte),
+	// damit die Vektoren der Ecken zwischen den Listen wandern können, ohne neu angelegt zu werden
+	CornerPool cornerPool;
+};
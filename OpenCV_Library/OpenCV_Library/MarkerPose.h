@@ -0,0 +1,36 @@
+#pragma once
+
+// Bits in MarkerPose::flags:
+//		- MARKER_POSE_PREDICTED: Der Marker wurde in diesem Bild nicht erkannt, die Pose ist aus seiner Spur vorhergesagt
+//								 (Ecken aus der Pose projiziert, kein Rückprojektionsfehler)
+//		- MARKER_POSE_EXTRAPOLATED: Die Pose wurde von getExtrapolatedMarkerPoses() vom Aufnahmezeitpunkt auf den
+//									gewünschten Zeitpunkt fortgeschrieben (Ecken und Rückprojektionsfehler wie aufgenommen)
+const int MARKER_POSE_PREDICTED = 1;
+const int MARKER_POSE_EXTRAPOLATED = 2;
+
+/* MarkerPose-Struktur: Ergebnis für einen erkannten Marker, wie es über getMarkerPoses() an den Aufrufer geht.
+   Die Struktur ist "blittable" (nur Werttypen, natürliche Ausrichtung ohne Lücken), damit C# ein Array davon ohne
+   Umkopieren an die DLL übergeben kann. Reihenfolge und Typen müssen mit MarkerPose in CubeScript.cs übereinstimmen*/
+struct MarkerPose {
+
+	// Marker-ID aus dem Lexikon (hier: DICT_4X4_50)
+	int id;
+
+	// Kombination der MARKER_POSE_*-Bits. Das Feld sorgt außerdem dafür, dass die folgenden double-Werte auf 8 Byte
+	// ausgerichtet sind
+	int flags;
+
+	// Rotationsvektor (Rodrigues) und Translationsvektor in Metern, über die Bilder hinweg geglättet
+	double rotationVector[3];
+	double translationVector[3];
+
+	// Die 4 Markerecken im Bild in Pixeln (x0, y0, x1, y1, x2, y2, x3, y3), im Uhrzeigersinn ab oben links
+	float corners[8];
+
+	// Mittlerer Rückprojektionsfehler der 4 Ecken in Pixeln (RMS) mit der gemessenen, ungeglätteten Pose
+	// (-1 für vorhergesagte Marker)
+	double reprojectionError;
+
+	// Zeitpunkt der Aufnahme des Bildes in Mikrosekunden (monotone Uhr)
+	long long captureTimestamp;
+};
@@ -0,0 +1,114 @@
+#include "MotionGate.h"
+#include <algorithm>
+
+using namespace std;
+using namespace cv;
+
+// Gewichte der Grauwandlung in 1/256 wie in ImageKernels.cpp
+static const int blueWeight = 29;
+static const int greenWeight = 150;
+static const int redWeight = 77;
+
+
+MotionGate::MotionGate()
+	: change(-1.0f) {
+}
+
+
+bool MotionGate::hasChanged(const Mat& frame, float threshold) {
+
+	CV_Assert(frame.depth() == CV_8U && (frame.channels() == 1 || frame.channels() == 3 || frame.channels() == 4));
+
+	const int columns = max(frame.cols / blockSize, 1);
+	const int rows = max(frame.rows / blockSize, 1);
+	const int channels = frame.channels();
+
+	thumbnail.create(rows, columns, CV_8UC1);
+	blockSums.resize(columns);
+
+	// Summe der Grauwerte (mal 256) pro Block, die Grauwandlung geschieht dabei Pixel für Pixel
+	for (int blockRow = 0; blockRow < rows; ++blockRow) {
+
+		const int top = blockRow * blockSize;
+		const int bottom = blockRow == rows - 1 ? frame.rows : top + blockSize;
+
+		fill(blockSums.begin(), blockSums.end(), 0);
+
+		for (int y = top; y < bottom; ++y) {
+
+			const uchar* src = frame.ptr<uchar>(y);
+
+			for (int blockColumn = 0; blockColumn < columns; ++blockColumn) {
+
+				const int left = blockColumn * blockSize;
+				const int right = blockColumn == columns - 1 ? frame.cols : left + blockSize;
+				int sum = 0;
+
+				if (channels == 1) {
+
+					for (int x = left; x < right; ++x) {
+
+						sum += src[x];
+					}
+
+					sum <<= 8;
+				}
+				else {
+
+					for (int x = left; x < right; ++x) {
+
+						const uchar* pixel = src + x * channels;
+						sum += blueWeight * pixel[0] + greenWeight * pixel[1] + redWeight * pixel[2];
+					}
+				}
+
+				blockSums[blockColumn] += sum;
+			}
+		}
+
+		uchar* dst = thumbnail.ptr<uchar>(blockRow);
+
+		for (int blockColumn = 0; blockColumn < columns; ++blockColumn) {
+
+			const int left = blockColumn * blockSize;
+			const int right = blockColumn == columns - 1 ? frame.cols : left + blockSize;
+			const int area = (right - left) * (bottom - top) * 256;
+
+			dst[blockColumn] = saturate_cast<uchar>((blockSums[blockColumn] + area / 2) / area);
+		}
+	}
+
+	if (reference.empty() || reference.size() != thumbnail.size()) {
+
+		change = -1.0f;
+		return true;
+	}
+
+	absdiff(thumbnail, reference, difference);
+
+	double maxDifference = 0.0;
+	minMaxLoc(difference, nullptr, &maxDifference);
+
+	change = (float)maxDifference;
+
+	return change > threshold;
+}
+
+
+void MotionGate::accept() {
+
+	thumbnail.copyTo(reference);
+}
+
+
+void MotionGate::reset() {
+
+	reference.release();
+	change = -1.0f;
+}
+
+
+float MotionGate::lastChange() const {
+
+	return change;
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+/* MotionGate-Klasse: Billige Vorprüfung, ob sich das Bild seit der letzten Erkennung verändert hat. Das Bild wird auf
+   Blöcke von blockSize x blockSize Pixeln gemittelt (bei 1280x720 ein 80x45-Graubild, ein Rest am rechten und unteren
+   Rand fällt dem letzten Block zu) und mit dem Vorschaubild der letzten Erkennung verglichen. Verglichen wird immer mit diesem Referenzbild und nicht mit dem
+   vorherigen Bild, damit auch langsame Bewegungen irgendwann eine neue Erkennung auslösen*/
+class MotionGate {
+
+public:
+
+	// Kantenlänge der gemittelten Blöcke in Pixeln
+	static const int blockSize = 16;
+
+	MotionGate();
+
+	/* hasChanged()-Funktion: Berechnet das Vorschaubild und vergleicht es mit dem Referenzbild
+			- @param frame: Aufgenommenes Bild (BGR oder Graustufen)
+			- @param threshold: Größte erlaubte Änderung eines Blocks in Graustufen (0..255)
+			- @param return: True, wenn sich ein Block um mehr als threshold geändert hat oder es noch keine Referenz
+							 (bzw. eine andere Bildgröße) gibt*/
+	bool hasChanged(const cv::Mat& frame, float threshold);
+
+	/* accept()-Funktion: Übernimmt das zuletzt in hasChanged() berechnete Vorschaubild als Referenz, nachdem auf dem
+	   Bild eine Erkennung gelaufen ist*/
+	void accept();
+
+	/* reset()-Funktion: Vergisst die Referenz, das nächste Bild gilt als verändert*/
+	void reset();
+
+	/* lastChange()-Funktion: Größte Änderung eines Blocks beim letzten Vergleich in Graustufen (-1 ohne Referenz)*/
+	float lastChange() const;
+
+private:
+
+	// Wiederverwendete Puffer, damit pro Bild nichts allokiert wird. Die Mittelung ist eine eigene Schleife, weil
+	// resize() mit INTER_AREA bei jedem Aufruf Tabellen und Zeilenpuffer anlegt
+	cv::Mat thumbnail, reference, difference;
+	std::vector<int> blockSums;
+	float change;
+};
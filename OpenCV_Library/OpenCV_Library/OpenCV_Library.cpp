@@ -1,241 +1,552 @@
-#include "pch.h"
-#include <iostream>
-#include <fstream>
-#include <sstream>
-#include <opencv2/opencv.hpp>
-#include <opencv2/aruco.hpp>
-
-using namespace std;
-using namespace cv;
-
-// extern "C" verhindert, dass Funktionen, die in C++ definiert sind, nicht "verndert" werden (mangling), so dass sie von C aus
-// aufgerufen werden knnen. Mit dem Schlsselwort __declspec(dllexport) knnen Daten, Funktionen, Klassen oder Klassenmemberfunktionen
-// aus einer DLL exportiert werden.
-extern "C" __declspec(dllexport) void initialize(int);
-extern "C" __declspec(dllexport) bool loadCameraCalibration(const char*);
-extern "C" __declspec(dllexport) int estimatePoseMarkerAndDetection();
-extern "C" __declspec(dllexport) double getXCoordinate();
-extern "C" __declspec(dllexport) double getYCoordinate();
-extern "C" __declspec(dllexport) double getZCoordinate();
-extern "C" __declspec(dllexport) void close();
-
-// Kameramatrix (intrinsische Matrix) 3x3
-Mat cameraMatrix;
-
-// Abstandskoeffizienten 5X1
-Mat distanceCoefficients;
-
-// Lnge des ArUco-Markers aus dem Lexikon in Metern DICT_4X4_50
-const float arucoSquareDimension = 0.132f;
-
-// Pointer fr die Webcam
-Ptr<VideoCapture> cap;
-
-// Array fr das Aufnahmebild der Webcam
-Mat frame;
-
-// ArUco-Lexikon-Objekt
-Ptr<aruco::Dictionary> dictionary;
-
-// Vektor fr die erkannten Marker-IDs
-vector<int> markerIds;
-
-// "2-dimensionales Arrray" fr die Merkerecken und die abgelehnten Kandidaten
-vector<vector<Point2f>> markerCorners, rejectedCandidates;
-
-// Paramter-Objekt, das eventuell genutzt werden kann
-aruco::DetectorParameters parameters;
-
-// "2-dimensionales Array" fr die Rotationen und Translationen
-vector<Vec3d> rotationVectors, translationVectors;
-
-
-/* initialize()-Funktion: Initialisierung wichtiger Objekte, zur Durchfhrung der Prozesse
-		- @param cameraInput: Kamerainput als Integer-Wert (0 als Standard fr eine angeschlossene Kamera)*/
-void initialize(int cameraInput) {
-
-	// Kameramatrix als 3x3
-	cameraMatrix = Mat::eye(3, 3, CV_64F);
-
-	cap = new VideoCapture(cameraInput);
-
-	// Erstellung des verwendeten Lexikons der ArUco-Marker (hier: DICT_4X4_50)
-	dictionary = aruco::getPredefinedDictionary(aruco::DICT_4X4_50);
-}
-
-
-/* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei
-		- @param cameraCalibrationFileName: Name der zu ladenen Datei (const char* fr C-bersetzung)
-		- @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
-bool loadCameraCalibration(const char* cameraCalibrationFileName) {
-
-	// Erstellung eines ifstream, um Daten aus einer Datei zu lesen
-	ifstream inStream(cameraCalibrationFileName);
-
-	if (inStream) {
-
-		uint16_t rows;
-		uint16_t columns;
-
-		inStream >> rows;
-		inStream >> columns;
-
-		// 3x3 Kameramatrix
-		cameraMatrix = Mat(Size(columns, rows), CV_64F);
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double read = 0.0f;
-				inStream >> read;
-				cameraMatrix.at<double>(r, c) = read;
-				cout << cameraMatrix.at<double>(r, c) << "\n";
-			}
-		}
-
-		inStream >> rows;
-		inStream >> columns;
-
-		// 5x1 Abstandskoeffizienten-Matrix
-		distanceCoefficients = Mat::zeros(rows, columns, CV_64F);
-
-		for (int r = 0; r < rows; ++r) {
-
-			for (int c = 0; c < columns; ++c) {
-
-				double read = 0.0f;
-				inStream >> read;
-				distanceCoefficients.at<double>(r, c) = read;
-				cout << distanceCoefficients.at<double>(r, c) << "\n";
-			}
-		}
-
-		inStream.close();
-		return true;
-	}
-
-	return false;
-}
-
-
-/* estimatePoseMarkerAndDetection()-Funktion: Durchfhrung der Posenschtzung der Marker und deren Erkennung
-		- @param return: -1 fr einen Fehlschlag, 1 fr eine Durchfhrung*/
-int estimatePoseMarkerAndDetection() {
-
-	// Wenn die Webcam (cap) nicht geffnet werden kann, dann return -1
-	if (!cap->isOpened()) {
-
-		return -1;
-	}
-
-	// Falls das Videobild der Kamera nicht gelesen werden kann, dann return -1
-	if (!cap->read(frame)) {
-
-		return -1;
-	}
-
-	/* detectMarkers()-Funktion: Grundlegende Markererkennung
-				- @param frame: Eingabebild (Webcam)
-				- @param dictionary: Gibt die Art der Marker an, die durchsucht werden sollen (hier: DICT_4X4_50)
-				- @param markerCorners: Vektor der erkannten Marker-Ecken. Fr N erkannte Marker sind die Dimensionen des Arrays Nx4
-				- @param markerIds: Vektor der Identifikationen der erkannten Markierungen. Fr N erkannte Marker ist die Dimension
-									des Arrays N*/
-	aruco::detectMarkers(frame, dictionary, markerCorners, markerIds);
-
-
-	/* estimatePoseSingleMarkers()-Funktion: Posenschtzung fr einzelne Marker
-				- @param markerCorners: Vektor der bereits erkannten Markerecken
-				- @param arucoSquareDimension: Lnge der ArUco-Markers. Die Translationvektoren werden normalerweise in derselben
-											   Einheit ausgegeben -> Metern
-				- @param cameraMatrix: Die zuvor bestimmte intrinsische Kameramatrix
-				- @param distanceCoefficients: Vektor der zuvor bestimmten Abstandskoeffizienten
-				- @param rotationVectors: Ausgabearray von Rotationsvektoren
-				- @param translationVectors: Ausgabearray von Translationsvektoren. Jedes Element in tvecs entspricht der
-											 spezifischen Markierung in imgPoints
-		   Fr jeden Marker wird ein Translations- und ein Rotationsvektor ausgegeben.*/
-	aruco::estimatePoseSingleMarkers(markerCorners, arucoSquareDimension, cameraMatrix,
-		distanceCoefficients, rotationVectors, translationVectors);
-
-	// Wenn ein Marker erkannt worden ist, zeichne den erkannten Marker
-	if (markerIds.size() > 0) {
-
-		/* drawDetectedMarkers()-Funktion: Zeichnet die erkannten Bilder im Bild (Webcam-frame)
-				- @param frame: Eingabebild der Kamera
-				- @param markerCorners: Die erkannten Markerecken im Eingabebild. Fr N erkannte Marker, sind die Dimensionen
-										des Arrays Nx4
-				- @param markerIds: Vektor von Bezeichnern fr Marker (optional)*/
-		aruco::drawDetectedMarkers(frame, markerCorners, markerIds);
-	}
-
-	for (int i = 0; i < markerIds.size(); ++i) {
-
-		/* drawAxis()-Funktion: Zeichnet die Achsen des Koordinatensystem aus der Posenschtzung
-					- @param frame: Eingabebild (Webcam)
-					- @param cameraMatrix: Zuvor bestimmte intrinsische Kameramatrix
-					- @param distanceCoefficients: Die vorher bestimmten Abstandskoeffizienten
-					- @param rotationVectors[i]: Rotationsvektoren der Koordinatensysteme, die gezeichnet werden
-					- @param translationVectors[i]: Translationsvektoren der Koordinatensysteme, die gezeichnet werden
-					- @param 0.1f: Lnge der gemalten Achsen, in der gleichen Einheit wit tVec (Normalerweise in Metern)*/
-		aruco::drawAxis(frame, cameraMatrix, distanceCoefficients, rotationVectors[i], translationVectors[i], 0.1f);
-	}
-
-	/* imshow()-Funktion: Stellt ein Bild in einem spezifischen Fenster dar
-				- @param "Webcam": Stellt den Fensternamen dar
-				- @param frame: Darzustellende Bild
-				Auf dieser Funktion sollte immer die waitKey()-Funktion folgen, weil sonst das Fenster nicht dargestellt wird*/
-	imshow("Webcam", frame);
-
-	return 1;
-}
-
-/* getXCoordinate()-Funktion: Gibt die X-Koordinate des Markers wieder in Metern (aus seinem tVec!)
-		- @param return: X-Koordinate des ersten erkanten Markers*/
-double getXCoordinate() {
-
-	// Falls der tVec nicht leer ist (Kein Marker erkannt)
-	if (!translationVectors.empty()) {
-
-		return translationVectors[0][0];
-	}
-
-	return 0.0;
-}
-
-
-/* getYCoordinate()-Funktion: Gibt die Y-Koordinate des Markers wieder in Metern (aus seinem tVec!)
-		- @param return: Y-Koordinate des ersten erkanten Markers*/
-double getYCoordinate() {
-
-	// Falls der tVec nicht leer ist (Kein Marker erkannt)
-	if (!translationVectors.empty()) {
-
-		return translationVectors[0][1];
-	}
-
-	return 0.0;
-}
-
-
-/* getZCoordinate()-Funktion: Gibt die Z-Koordinate des Markers wieder in Metern (aus seinem tVec!)
-		- @param return: Z-Koordinate des ersten erkanten Markers*/
-double getZCoordinate() {
-
-	// Falls der tVec nicht leer ist (Kein Marker erkannt)
-	if (!translationVectors.empty()) {
-
-		return translationVectors[0][2];
-	}
-
-	return 0.0;
-}
-
-/* close()-Funktion: Schliet Fenster und "befreit" einige Objekte*/
-void close() {
-
-	cameraMatrix.release();
-	distanceCoefficients.release();
-	frame.release();
-	dictionary.release();
-	destroyAllWindows();
-}
+#include "pch.h"
+#include <memory>
+#include <string>
+#include "DetectorContext.h"
+
+using namespace std;
+using namespace cv;
+
+// extern "C" verhindert, dass Funktionen, die in C++ definiert sind, nicht "verändert" werden (mangling), so dass sie von C aus
+// aufgerufen werden können. Mit dem Schlüsselwort __declspec(dllexport) können Daten, Funktionen, Klassen oder Klassenmemberfunktionen
+// aus einer DLL exportiert werden.
+extern "C" __declspec(dllexport) void initialize(int);
+extern "C" __declspec(dllexport) void initializeEx(int, int);
+extern "C" __declspec(dllexport) void initializeSource(const char*, int);
+extern "C" __declspec(dllexport) bool startDetectionThread();
+extern "C" __declspec(dllexport) void stopDetectionThread();
+extern "C" __declspec(dllexport) unsigned long long getResultSequence();
+extern "C" __declspec(dllexport) int getMarkerPoses(MarkerPose*, int);
+extern "C" __declspec(dllexport) int getExtrapolatedMarkerPoses(long long, MarkerPose*, int);
+extern "C" __declspec(dllexport) long long getResultCaptureTimestamp();
+extern "C" __declspec(dllexport) long long getMonotonicTimestamp();
+extern "C" __declspec(dllexport) int getMaxMarkerCount();
+extern "C" __declspec(dllexport) void setDetectorSettings(const DetectorSettings*);
+extern "C" __declspec(dllexport) void getDetectorSettings(DetectorSettings*);
+extern "C" __declspec(dllexport) int getLastDetectionPath();
+extern "C" __declspec(dllexport) void getStats(DetectorStats*);
+extern "C" __declspec(dllexport) bool setStatsDumpFile(const char*, int);
+extern "C" __declspec(dllexport) void setRectifiedView(int);
+extern "C" __declspec(dllexport) void setPoseFiltering(int);
+extern "C" __declspec(dllexport) void setFrameExport(int);
+extern "C" __declspec(dllexport) unsigned long long getExportedFrameSequence();
+extern "C" __declspec(dllexport) int acquireExportedFrame(ExportedFrame*);
+extern "C" __declspec(dllexport) void releaseExportedFrame();
+extern "C" __declspec(dllexport) bool startPoseBus(const char*);
+extern "C" __declspec(dllexport) void stopPoseBus();
+extern "C" __declspec(dllexport) bool loadCameraCalibration(const char*);
+extern "C" __declspec(dllexport) int estimatePoseMarkerAndDetection();
+extern "C" __declspec(dllexport) double getXCoordinate();
+extern "C" __declspec(dllexport) double getYCoordinate();
+extern "C" __declspec(dllexport) double getZCoordinate();
+extern "C" __declspec(dllexport) void close();
+extern "C" __declspec(dllexport) DetectorContext* initializeContext(int, int);
+extern "C" __declspec(dllexport) DetectorContext* initializeContextFromSource(const char*, int);
+extern "C" __declspec(dllexport) void closeContext(DetectorContext*);
+extern "C" __declspec(dllexport) bool ctxLoadCameraCalibration(DetectorContext*, const char*);
+extern "C" __declspec(dllexport) int ctxEstimatePoseMarkerAndDetection(DetectorContext*);
+extern "C" __declspec(dllexport) bool ctxStartDetectionThread(DetectorContext*);
+extern "C" __declspec(dllexport) void ctxStopDetectionThread(DetectorContext*);
+extern "C" __declspec(dllexport) unsigned long long ctxGetResultSequence(DetectorContext*);
+extern "C" __declspec(dllexport) int ctxGetMarkerPoses(DetectorContext*, MarkerPose*, int);
+extern "C" __declspec(dllexport) int ctxGetExtrapolatedMarkerPoses(DetectorContext*, long long, MarkerPose*, int);
+extern "C" __declspec(dllexport) long long ctxGetResultCaptureTimestamp(DetectorContext*);
+extern "C" __declspec(dllexport) void ctxSetDetectorSettings(DetectorContext*, const DetectorSettings*);
+extern "C" __declspec(dllexport) void ctxGetDetectorSettings(DetectorContext*, DetectorSettings*);
+extern "C" __declspec(dllexport) int ctxGetLastDetectionPath(DetectorContext*);
+extern "C" __declspec(dllexport) void ctxGetStats(DetectorContext*, DetectorStats*);
+extern "C" __declspec(dllexport) bool ctxSetStatsDumpFile(DetectorContext*, const char*, int);
+extern "C" __declspec(dllexport) void ctxSetRectifiedView(DetectorContext*, int);
+extern "C" __declspec(dllexport) void ctxSetPoseFiltering(DetectorContext*, int);
+extern "C" __declspec(dllexport) void ctxSetFrameExport(DetectorContext*, int);
+extern "C" __declspec(dllexport) unsigned long long ctxGetExportedFrameSequence(DetectorContext*);
+extern "C" __declspec(dllexport) int ctxAcquireExportedFrame(DetectorContext*, ExportedFrame*);
+extern "C" __declspec(dllexport) void ctxReleaseExportedFrame(DetectorContext*);
+extern "C" __declspec(dllexport) bool ctxStartPoseBus(DetectorContext*, const char*);
+extern "C" __declspec(dllexport) void ctxStopPoseBus(DetectorContext*);
+
+// Kontext der alten, globalen API (initialize(), estimatePoseMarkerAndDetection(), ...). Alle Kameras, die über
+// initializeContext() geöffnet werden, haben ihren eigenen Kontext und sind davon unabhängig
+unique_ptr<DetectorContext> defaultContext;
+
+
+/* initialize()-Funktion: Initialisierung wichtiger Objekte, zur Durchführung der Prozesse
+		- @param cameraInput: Kamerainput als Integer-Wert (0 als Standard für eine angeschlossene Kamera)*/
+void initialize(int cameraInput) {
+
+	initializeEx(cameraInput, 0);
+}
+
+
+/* initializeEx()-Funktion: Wie initialize(), aber mit zusätzlichen Optionen
+		- @param cameraInput: Kamerainput als Integer-Wert (0 als Standard für eine angeschlossene Kamera)
+		- @param flags: Kombination der INIT_*-Flags (INIT_BACKGROUND_WORKER startet den Detektions-Thread,
+						INIT_HEADLESS schaltet die Debug-Anzeige ab, INIT_LUMINANCE_CAPTURE liest nur die Helligkeit
+						der Kamera)*/
+void initializeEx(int cameraInput, int flags) {
+
+	initializeSource(to_string(cameraInput).c_str(), flags);
+}
+
+
+/* initializeSource()-Funktion: Wie initializeEx(), aber mit beliebiger Bildquelle statt einer Webcam
+		- @param sourceUri: Bildquelle, z.B. "0" (Webcam), "file:video.mp4?loop=1", "dir:Bilder" oder
+							"synthetic:1920x1080?markers=4&fps=30" (siehe createFrameSource() in FrameSource.h)
+		- @param flags: Kombination der INIT_*-Flags*/
+void initializeSource(const char* sourceUri, int flags) {
+
+	// Der alte Kontext muss zuerst beendet werden, damit sein Detektions-Thread nicht mehr auf die alte Quelle zugreift
+	defaultContext.reset();
+	defaultContext.reset(new DetectorContext(sourceUri ? sourceUri : "0", flags));
+}
+
+
+/* startDetectionThread()-Funktion: Startet den Detektions-Thread. Danach blockiert estimatePoseMarkerAndDetection()
+   nicht mehr, sondern übernimmt nur noch das neueste fertige Ergebnis
+		- @param return: True, wenn der Thread läuft, false wenn die Bildquelle nicht geöffnet ist*/
+bool startDetectionThread() {
+
+	return ctxStartDetectionThread(defaultContext.get());
+}
+
+
+/* stopDetectionThread()-Funktion: Beendet den Detektions-Thread und wartet, bis das aktuelle Bild fertig bearbeitet ist*/
+void stopDetectionThread() {
+
+	ctxStopDetectionThread(defaultContext.get());
+}
+
+
+/* getResultSequence()-Funktion: Nummer des zuletzt veröffentlichten Ergebnisses. Ändert sie sich, liegt eine neue
+   Pose vor (0 = noch kein Ergebnis)
+		- @param return: Fortlaufende Nummer des letzten Ergebnisses*/
+unsigned long long getResultSequence() {
+
+	return ctxGetResultSequence(defaultContext.get());
+}
+
+
+/* loadCameraCalibration()-Funktion: Laden der Kamerakalibrierungsdaten aus einer Datei
+		- @param cameraCalibrationFileName: Name der zu ladenen Datei (const char* für C-Übersetzung)
+		- @param return: True oder false, ob der Ladevorgang erfolgen konnte oder nicht*/
+bool loadCameraCalibration(const char* cameraCalibrationFileName) {
+
+	return ctxLoadCameraCalibration(defaultContext.get(), cameraCalibrationFileName);
+}
+
+
+/* estimatePoseMarkerAndDetection()-Funktion: Durchführung der Posenschätzung der Marker und deren Erkennung.
+   Läuft der Detektions-Thread, wird nur das neueste fertige Ergebnis für die Getter übernommen (blockiert nie)
+		- @param return: -1 für einen Fehlschlag, 1 für eine Durchführung bzw. ein neues Ergebnis,
+						 0 wenn der Detektions-Thread seit dem letzten Aufruf kein neues Ergebnis hat*/
+int estimatePoseMarkerAndDetection() {
+
+	return ctxEstimatePoseMarkerAndDetection(defaultContext.get());
+}
+
+/* getXCoordinate()-Funktion: Gibt die X-Koordinate des Markers wieder in Metern (aus seinem tVec!)
+		- @param return: X-Koordinate des ersten erkanten Markers*/
+double getXCoordinate() {
+
+	// Falls der tVec nicht leer ist (Kein Marker erkannt)
+	if (defaultContext && defaultContext->currentResult().markerCount > 0) {
+
+		return defaultContext->currentResult().markers[0].translationVector[0];
+	}
+
+	return 0.0;
+}
+
+
+/* getYCoordinate()-Funktion: Gibt die Y-Koordinate des Markers wieder in Metern (aus seinem tVec!)
+		- @param return: Y-Koordinate des ersten erkanten Markers*/
+double getYCoordinate() {
+
+	// Falls der tVec nicht leer ist (Kein Marker erkannt)
+	if (defaultContext && defaultContext->currentResult().markerCount > 0) {
+
+		return defaultContext->currentResult().markers[0].translationVector[1];
+	}
+
+	return 0.0;
+}
+
+
+/* getZCoordinate()-Funktion: Gibt die Z-Koordinate des Markers wieder in Metern (aus seinem tVec!)
+		- @param return: Z-Koordinate des ersten erkanten Markers*/
+double getZCoordinate() {
+
+	// Falls der tVec nicht leer ist (Kein Marker erkannt)
+	if (defaultContext && defaultContext->currentResult().markerCount > 0) {
+
+		return defaultContext->currentResult().markers[0].translationVector[2];
+	}
+
+	return 0.0;
+}
+
+/* getMarkerPoses()-Funktion: Kopiert alle Marker des aktuellen Ergebnisses in einen Array des Aufrufers. Ersetzt die
+   einzelnen Aufrufe von getXCoordinate(), getYCoordinate() und getZCoordinate() durch einen einzigen Aufruf
+		- @param poses: Array des Aufrufers, in den geschrieben wird (wird von der DLL nicht allokiert)
+		- @param capacity: Anzahl der Elemente in poses. Es werden höchstens so viele Marker geschrieben
+		- @param return: Anzahl der erkannten Marker. Ist sie größer als capacity, war der Array zu klein und es wurden nur
+						 die ersten capacity Marker geschrieben (getMaxMarkerCount() liefert die nötige Größe)*/
+int getMarkerPoses(MarkerPose* poses, int capacity) {
+
+	return ctxGetMarkerPoses(defaultContext.get(), poses, capacity);
+}
+
+
+/* getExtrapolatedMarkerPoses()-Funktion: Wie getMarkerPoses(), aber die Posen werden mit der Bewegung der Marker auf
+   einen Zeitpunkt des Aufrufers fortgeschrieben, z.B. auf den Zeitpunkt, zu dem das nächste Bild angezeigt wird. Damit
+   wird die Zeit zwischen Aufnahme und Anzeige ausgeglichen (MARKER_POSE_EXTRAPOLATED in flags)
+		- @param targetTimestamp: Gewünschter Zeitpunkt in Mikrosekunden auf der Uhr von getMonotonicTimestamp()
+		- @param poses: Array des Aufrufers, in den geschrieben wird
+		- @param capacity: Anzahl der Elemente in poses
+		- @param return: Anzahl der Marker (wie bei getMarkerPoses())*/
+int getExtrapolatedMarkerPoses(long long targetTimestamp, MarkerPose* poses, int capacity) {
+
+	return ctxGetExtrapolatedMarkerPoses(defaultContext.get(), targetTimestamp, poses, capacity);
+}
+
+
+/* getResultCaptureTimestamp()-Funktion: Aufnahmezeitpunkt des aktuellen Ergebnisses, auch ohne erkannte Marker
+		- @param return: Zeitpunkt in Mikrosekunden auf der Uhr von getMonotonicTimestamp(), 0 ohne Ergebnis*/
+long long getResultCaptureTimestamp() {
+
+	return ctxGetResultCaptureTimestamp(defaultContext.get());
+}
+
+
+/* getMonotonicTimestamp()-Funktion: Aktuelle Zeit der Uhr, mit der die Aufnahmezeitpunkte gemessen werden. Der
+   Aufrufer rechnet damit seine Zeitpunkte um (z.B. jetzt + Zeit bis zur Anzeige) bzw. das Alter eines Ergebnisses aus
+		- @param return: Zeit in Mikrosekunden (monoton, Nullpunkt beliebig)*/
+long long getMonotonicTimestamp() {
+
+	return monotonicMicroseconds();
+}
+
+
+/* getMaxMarkerCount()-Funktion: Maximale Anzahl an Markern pro Ergebnis, damit der Aufrufer seinen Array einmalig in
+   passender Größe anlegen kann (gilt für alle Kontexte)
+		- @param return: Maximale Anzahl an Markern (hier: 50 für DICT_4X4_50)*/
+int getMaxMarkerCount() {
+
+	return maxMarkers;
+}
+
+
+/* setDetectorSettings()-Funktion: Setzt die Einstellungen der Markererkennung (z.B. Verfolgung in Bildausschnitten).
+   Kann auch bei laufendem Detektions-Thread aufgerufen werden, die Werte gelten dann ab dem nächsten Bild
+		- @param settings: Neue Einstellungen*/
+void setDetectorSettings(const DetectorSettings* settings) {
+
+	ctxSetDetectorSettings(defaultContext.get(), settings);
+}
+
+
+/* getDetectorSettings()-Funktion: Liest die aktuellen Einstellungen der Markererkennung
+		- @param settings: Struktur des Aufrufers, in die geschrieben wird*/
+void getDetectorSettings(DetectorSettings* settings) {
+
+	ctxGetDetectorSettings(defaultContext.get(), settings);
+}
+
+
+/* getLastDetectionPath()-Funktion: Gibt an, wie die Marker des aktuellen Ergebnisses gefunden wurden
+		- @param return: DETECTION_PATH_FULL (0) für eine Suche im ganzen Bild, DETECTION_PATH_ROI (1) für die Suche in
+						 den Ausschnitten um die bekannten Marker, DETECTION_PATH_SKIPPED (2) wenn das Bild unverändert war
+						 und das letzte Ergebnis wiederholt wurde*/
+int getLastDetectionPath() {
+
+	return ctxGetLastDetectionPath(defaultContext.get());
+}
+
+
+/* getStats()-Funktion: Liest die Statistik der Pipeline: Laufzeiten der einzelnen Stufen (Warten auf die Kamera,
+   Dekodieren, Markererkennung, Posenschätzung, Zeichnen/imshow) als p50/p95/p99/max über die letzten Bilder sowie
+   Bildzähler, verworfene Ergebnisse und Trefferquote
+		- @param stats: Struktur des Aufrufers, in die geschrieben wird*/
+void getStats(DetectorStats* stats) {
+
+	ctxGetStats(defaultContext.get(), stats);
+}
+
+
+/* setStatsDumpFile()-Funktion: Schreibt die Statistik regelmäßig als CSV-Zeile in eine Datei
+		- @param path: Pfad der Datei, nullptr oder "" beendet das Schreiben
+		- @param intervalMilliseconds: Abstand zwischen zwei Zeilen
+		- @param return: False, wenn die Datei nicht geöffnet werden konnte oder nicht initialisiert wurde*/
+bool setStatsDumpFile(const char* path, int intervalMilliseconds) {
+
+	return ctxSetStatsDumpFile(defaultContext.get(), path, intervalMilliseconds);
+}
+
+
+/* setRectifiedView()-Funktion: Zeigt in der Debug-Anzeige das entzerrte Bild statt des aufgenommenen Bildes
+		- @param enabled: 1 für das entzerrte Bild, 0 für das aufgenommene Bild*/
+void setRectifiedView(int enabled) {
+
+	ctxSetRectifiedView(defaultContext.get(), enabled);
+}
+
+
+/* setPoseFiltering()-Funktion: Verfolgt die Pose jedes Markers über die Bilder hinweg. Die Pose wird von der letzten
+   Pose aus gelöst und geglättet, ein kurz nicht erkannter Marker wird vorhergesagt (MARKER_POSE_PREDICTED in flags).
+   Standardmäßig eingeschaltet
+		- @param enabled: 1 für geglättete Posen, 0 für unabhängige Einzelposen jedes Bildes*/
+void setPoseFiltering(int enabled) {
+
+	ctxSetPoseFiltering(defaultContext.get(), enabled);
+}
+
+
+/* setFrameExport()-Funktion: Gibt das Kamerabild über zwei Puffer der DLL an den Aufrufer weiter (z.B. als
+   Hintergrund in Unity statt des OpenCV-Fensters). Die Umwandlung läuft einmal pro Bild in der Pipeline, der Aufrufer
+   liest direkt aus dem Speicher der DLL
+		- @param format: FRAME_EXPORT_RGBA, FRAME_EXPORT_GRAY (nur Helligkeit) oder FRAME_EXPORT_NONE zum Abschalten*/
+void setFrameExport(int format) {
+
+	ctxSetFrameExport(defaultContext.get(), format);
+}
+
+
+/* getExportedFrameSequence()-Funktion: Nummer des zuletzt exportierten Bildes. Nur wenn sie sich ändert, muss
+   acquireExportedFrame() aufgerufen werden
+		- @param return: Nummer des zugehörigen Ergebnisses (wie getResultSequence()), 0 ohne exportiertes Bild*/
+unsigned long long getExportedFrameSequence() {
+
+	return ctxGetExportedFrameSequence(defaultContext.get());
+}
+
+
+/* acquireExportedFrame()-Funktion: Hält den zuletzt fertigen Puffer. Bis releaseExportedFrame() schreibt die Pipeline
+   nicht hinein, der Aufrufer kann ihn ohne Kopie in eine Textur laden
+		- @param frame: Struktur des Aufrufers, in die Zeiger, Größe, Format und Nummer des Bildes geschrieben werden
+		- @param return: 1 wenn ein Bild gehalten wird, 0 wenn es noch keines gibt*/
+int acquireExportedFrame(ExportedFrame* frame) {
+
+	return ctxAcquireExportedFrame(defaultContext.get(), frame);
+}
+
+
+/* releaseExportedFrame()-Funktion: Gibt den mit acquireExportedFrame() gehaltenen Puffer frei. Danach darf der
+   Zeiger nicht mehr verwendet werden*/
+void releaseExportedFrame() {
+
+	ctxReleaseExportedFrame(defaultContext.get());
+}
+
+
+/* startPoseBus()-Funktion: Veröffentlicht jedes Ergebnis zusätzlich in einem Ring im gemeinsamen Speicher. Beliebig
+   viele lokale Prozesse können die neuesten und älteren Posen dann mit der C-Bibliothek in PoseBusReader lesen,
+   ohne eigene Kamera und eigene Erkennung
+		- @param name: Name des Busses (nullptr oder "" für POSE_BUS_DEFAULT_NAME)
+		- @param return: False, wenn der gemeinsame Speicher nicht angelegt werden konnte oder der Bus schon einen
+						 anderen Schreiber hat*/
+bool startPoseBus(const char* name) {
+
+	return ctxStartPoseBus(defaultContext.get(), name);
+}
+
+
+/* stopPoseBus()-Funktion: Beendet das Veröffentlichen auf dem Bus. Leser können die letzten Einträge weiter lesen*/
+void stopPoseBus() {
+
+	ctxStopPoseBus(defaultContext.get());
+}
+
+
+/* close()-Funktion: Schließt Fenster und "befreit" einige Objekte*/
+void close() {
+
+	defaultContext.reset();
+}
+
+
+/* initializeContext()-Funktion: Öffnet eine Kamera in einem eigenen Kontext. Jeder Kontext hat seine eigene Webcam,
+   Kalibrierung, Ergebnispuffer und seinen eigenen Detektions-Thread, so dass mehrere Kameras parallel laufen können
+		- @param cameraInput: Kamerainput als Integer-Wert (0 als Standard für eine angeschlossene Kamera)
+		- @param flags: Kombination der INIT_*-Flags
+		- @param return: Handle des Kontexts für alle ctx*-Funktionen, muss mit closeContext() freigegeben werden*/
+DetectorContext* initializeContext(int cameraInput, int flags) {
+
+	return new DetectorContext(to_string(cameraInput), flags);
+}
+
+
+/* initializeContextFromSource()-Funktion: Wie initializeContext(), aber mit beliebiger Bildquelle (siehe initializeSource())
+		- @param sourceUri: Bildquelle, siehe createFrameSource() in FrameSource.h
+		- @param flags: Kombination der INIT_*-Flags
+		- @param return: Handle des Kontexts für alle ctx*-Funktionen, muss mit closeContext() freigegeben werden*/
+DetectorContext* initializeContextFromSource(const char* sourceUri, int flags) {
+
+	return new DetectorContext(sourceUri ? sourceUri : "0", flags);
+}
+
+
+/* closeContext()-Funktion: Beendet den Detektions-Thread des Kontexts, schließt seine Webcam und gibt ihn frei
+		- @param context: Handle aus initializeContext() (nullptr wird ignoriert)*/
+void closeContext(DetectorContext* context) {
+
+	delete context;
+}
+
+
+// Die ctx*-Funktionen entsprechen den gleichnamigen Funktionen der globalen API, arbeiten aber auf dem übergebenen
+// Kontext. Ein nullptr als Kontext ergibt das Ergebnis "nicht initialisiert" (-1, false oder 0)
+
+bool ctxLoadCameraCalibration(DetectorContext* context, const char* cameraCalibrationFileName) {
+
+	return context ? context->loadCameraCalibration(cameraCalibrationFileName) : false;
+}
+
+
+int ctxEstimatePoseMarkerAndDetection(DetectorContext* context) {
+
+	return context ? context->estimatePoseMarkerAndDetection() : -1;
+}
+
+
+bool ctxStartDetectionThread(DetectorContext* context) {
+
+	return context ? context->startDetectionThread() : false;
+}
+
+
+void ctxStopDetectionThread(DetectorContext* context) {
+
+	if (context) {
+
+		context->stopDetectionThread();
+	}
+}
+
+
+unsigned long long ctxGetResultSequence(DetectorContext* context) {
+
+	return context ? context->getResultSequence() : 0;
+}
+
+
+int ctxGetMarkerPoses(DetectorContext* context, MarkerPose* poses, int capacity) {
+
+	return context && poses ? context->getMarkerPoses(poses, capacity) : 0;
+}
+
+
+int ctxGetExtrapolatedMarkerPoses(DetectorContext* context, long long targetTimestamp, MarkerPose* poses, int capacity) {
+
+	return context && poses ? context->getExtrapolatedMarkerPoses(targetTimestamp, poses, capacity) : 0;
+}
+
+
+long long ctxGetResultCaptureTimestamp(DetectorContext* context) {
+
+	return context ? context->getResultCaptureTimestamp() : 0;
+}
+
+
+void ctxSetDetectorSettings(DetectorContext* context, const DetectorSettings* settings) {
+
+	if (context && settings) {
+
+		context->detector().setSettings(*settings);
+	}
+}
+
+
+void ctxGetDetectorSettings(DetectorContext* context, DetectorSettings* settings) {
+
+	if (context && settings) {
+
+		*settings = context->detector().getSettings();
+	}
+}
+
+
+int ctxGetLastDetectionPath(DetectorContext* context) {
+
+	return context ? context->currentResult().detectionPath : DETECTION_PATH_FULL;
+}
+
+
+void ctxGetStats(DetectorContext* context, DetectorStats* stats) {
+
+	if (context && stats) {
+
+		context->getStats(*stats);
+	}
+	else if (stats) {
+
+		*stats = DetectorStats();
+	}
+}
+
+
+bool ctxSetStatsDumpFile(DetectorContext* context, const char* path, int intervalMilliseconds) {
+
+	return context ? context->setStatsDumpFile(path, intervalMilliseconds) : false;
+}
+
+
+void ctxSetRectifiedView(DetectorContext* context, int enabled) {
+
+	if (context) {
+
+		context->setRectifiedView(enabled != 0);
+	}
+}
+
+
+void ctxSetPoseFiltering(DetectorContext* context, int enabled) {
+
+	if (context) {
+
+		context->setPoseFiltering(enabled != 0);
+	}
+}
+
+
+void ctxSetFrameExport(DetectorContext* context, int format) {
+
+	if (context) {
+
+		context->frameExport().setFormat(format);
+	}
+}
+
+
+unsigned long long ctxGetExportedFrameSequence(DetectorContext* context) {
+
+	return context ? context->frameExport().latestSequence() : 0;
+}
+
+
+int ctxAcquireExportedFrame(DetectorContext* context, ExportedFrame* frame) {
+
+	return context && frame && context->frameExport().acquire(*frame) ? 1 : 0;
+}
+
+
+void ctxReleaseExportedFrame(DetectorContext* context) {
+
+	if (context) {
+
+		context->frameExport().release();
+	}
+}
+
+
+bool ctxStartPoseBus(DetectorContext* context, const char* name) {
+
+	return context && context->startPoseBus(name && *name ? name : POSE_BUS_DEFAULT_NAME);
+}
+
+
+void ctxStopPoseBus(DetectorContext* context) {
+
+	if (context) {
+
+		context->stopPoseBus();
+	}
+}
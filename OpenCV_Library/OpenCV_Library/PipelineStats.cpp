@@ -0,0 +1,213 @@
+#include "PipelineStats.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
+using namespace std;
+
+
+long long monotonicMicroseconds() {
+
+	return chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+
+PipelineStats::PipelineStats() : dumpStopping(false), dumpInterval(0) {
+
+	reset();
+}
+
+
+PipelineStats::~PipelineStats() {
+
+	stopDumpThread();
+}
+
+
+void PipelineStats::reset() {
+
+	for (int s = 0; s < STAGE_COUNT; ++s) {
+
+		for (int i = 0; i < windowSize; ++i) {
+
+			windows[s].samples[i].store(0, memory_order_relaxed);
+		}
+
+		windows[s].written.store(0, memory_order_relaxed);
+	}
+
+	for (int c = 0; c < COUNTER_COUNT; ++c) {
+
+		counters[c].store(0, memory_order_relaxed);
+	}
+}
+
+
+/* recordLatency()-Funktion: Trägt eine Messung in das rollende Fenster der Stufe ein (ältere Messungen werden
+   überschrieben). Darf pro Stufe nur von einem Thread aufgerufen werden
+		- @param stage: Gemessene Stufe
+		- @param microseconds: Laufzeit in Mikrosekunden*/
+void PipelineStats::recordLatency(PipelineStage stage, long long microseconds) {
+
+	LatencyWindow& window = windows[stage];
+
+	unsigned long long index = window.written.load(memory_order_relaxed);
+	unsigned int sample = (unsigned int)min(max(microseconds, 0LL), (long long)UINT32_MAX);
+
+	window.samples[index % windowSize].store(sample, memory_order_relaxed);
+	window.written.store(index + 1, memory_order_release);
+}
+
+
+void PipelineStats::count(PipelineCounter counter) {
+
+	counters[counter].fetch_add(1, memory_order_relaxed);
+}
+
+
+void PipelineStats::add(PipelineCounter counter, long long value) {
+
+	counters[counter].fetch_add(value, memory_order_relaxed);
+}
+
+
+/* summarize()-Funktion: Sortiert eine Kopie des Fensters auf dem Stack und liest die Perzentile ab. Während des
+   Kopierens können einzelne Messungen bereits durch neuere ersetzt werden, was für die Statistik keine Rolle spielt*/
+void PipelineStats::summarize(const LatencyWindow& window, StageLatency& latency) const {
+
+	size_t available = (size_t)min(window.written.load(memory_order_acquire), (unsigned long long)windowSize);
+
+	latency.p50 = latency.p95 = latency.p99 = latency.max = 0.0;
+
+	if (available == 0) {
+
+		return;
+	}
+
+	unsigned int sorted[windowSize];
+
+	for (size_t i = 0; i < available; ++i) {
+
+		sorted[i] = window.samples[i].load(memory_order_relaxed);
+	}
+
+	sort(sorted, sorted + available);
+
+	latency.p50 = sorted[min(available - 1, available * 50 / 100)];
+	latency.p95 = sorted[min(available - 1, available * 95 / 100)];
+	latency.p99 = sorted[min(available - 1, available * 99 / 100)];
+	latency.max = sorted[available - 1];
+}
+
+
+void PipelineStats::snapshot(DetectorStats& stats) const {
+
+	stats.framesCaptured = counters[COUNTER_FRAMES_CAPTURED].load(memory_order_relaxed);
+	stats.captureFailures = counters[COUNTER_CAPTURE_FAILURES].load(memory_order_relaxed);
+	stats.framesProcessed = counters[COUNTER_FRAMES_PROCESSED].load(memory_order_relaxed);
+	stats.framesWithMarkers = counters[COUNTER_FRAMES_WITH_MARKERS].load(memory_order_relaxed);
+	stats.droppedResults = counters[COUNTER_DROPPED_RESULTS].load(memory_order_relaxed);
+	stats.framesSkipped = counters[COUNTER_FRAMES_SKIPPED].load(memory_order_relaxed);
+	stats.ingestedBytes = counters[COUNTER_INGESTED_BYTES].load(memory_order_relaxed);
+
+	stats.detectionHitRate = stats.framesProcessed > 0 ? (double)stats.framesWithMarkers / stats.framesProcessed : 0.0;
+
+	summarize(windows[STAGE_CAPTURE_WAIT], stats.captureWait);
+	summarize(windows[STAGE_DECODE], stats.decode);
+	summarize(windows[STAGE_DETECT_MARKERS], stats.detectMarkers);
+	summarize(windows[STAGE_ESTIMATE_POSE], stats.estimatePose);
+	summarize(windows[STAGE_RENDER], stats.render);
+	summarize(windows[STAGE_CAPTURE_TO_PUBLISH], stats.captureToPublish);
+}
+
+
+bool PipelineStats::setDumpFile(const char* path, int intervalMilliseconds) {
+
+	stopDumpThread();
+
+	if (!path || !path[0]) {
+
+		return true;
+	}
+
+	dumpStream.open(path, ios::out | ios::trunc);
+
+	if (!dumpStream) {
+
+		dumpStream.close();
+		return false;
+	}
+
+	dumpStream << "timestamp_us,frames_captured,capture_failures,frames_processed,frames_with_markers,dropped_results,"
+		"frames_skipped,ingested_bytes,hit_rate";
+
+	const char* stageNames[STAGE_COUNT] = { "capture_wait", "decode", "detect_markers", "estimate_pose", "render",
+		"capture_to_publish" };
+
+	for (int s = 0; s < STAGE_COUNT; ++s) {
+
+		dumpStream << "," << stageNames[s] << "_p50," << stageNames[s] << "_p95," << stageNames[s] << "_p99,"
+			<< stageNames[s] << "_max";
+	}
+
+	dumpStream << "\n";
+	dumpStream.flush();
+
+	dumpInterval = max(intervalMilliseconds, 1) * 1000LL;
+	dumpStopping = false;
+	dumpThread = thread(&PipelineStats::dumpLoop, this);
+
+	return true;
+}
+
+
+/* stopDumpThread()-Funktion: Beendet den Thread der CSV-Datei und schließt die Datei*/
+void PipelineStats::stopDumpThread() {
+
+	{
+		lock_guard<mutex> lock(dumpMutex);
+		dumpStopping = true;
+	}
+
+	dumpCondition.notify_all();
+
+	if (dumpThread.joinable()) {
+
+		dumpThread.join();
+	}
+
+	if (dumpStream.is_open()) {
+
+		dumpStream.close();
+	}
+}
+
+
+/* dumpLoop()-Funktion: Schleife des Threads der CSV-Datei. Schreibt nach jedem Intervall eine Zeile, bis
+   stopDumpThread() ihn weckt. Auslesen, Formatieren und Schreiben laufen damit nie im Thread der Pipeline*/
+void PipelineStats::dumpLoop() {
+
+	unique_lock<mutex> lock(dumpMutex);
+
+	while (!dumpCondition.wait_for(lock, chrono::microseconds(dumpInterval), [this] { return dumpStopping; })) {
+
+		DetectorStats stats;
+		snapshot(stats);
+
+		dumpStream << monotonicMicroseconds() << "," << stats.framesCaptured << "," << stats.captureFailures << ","
+			<< stats.framesProcessed << "," << stats.framesWithMarkers << "," << stats.droppedResults << ","
+			<< stats.framesSkipped << "," << stats.ingestedBytes << "," << stats.detectionHitRate;
+
+		const StageLatency* stages[STAGE_COUNT] = { &stats.captureWait, &stats.decode, &stats.detectMarkers,
+			&stats.estimatePose, &stats.render, &stats.captureToPublish };
+
+		for (int s = 0; s < STAGE_COUNT; ++s) {
+
+			dumpStream << "," << stages[s]->p50 << "," << stages[s]->p95 << "," << stages[s]->p99 << ","
+				<< stages[s]->max;
+		}
+
+		dumpStream << "\n";
+		dumpStream.flush();
+	}
+}
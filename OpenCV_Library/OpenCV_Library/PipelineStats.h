@@ -0,0 +1,150 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <fstream>
+
+// Messung der Laufzeiten einzelner Stufen. Mit ENABLE_PIPELINE_STATS=0 (Präprozessordefinition) werden alle
+// Messpunkte weggelassen, getStats() liefert dann nur Nullen
+#ifndef ENABLE_PIPELINE_STATS
+#define ENABLE_PIPELINE_STATS 1
+#endif
+
+#if ENABLE_PIPELINE_STATS
+#define STATS_TIMESTAMP(name) const long long name = monotonicMicroseconds()
+#define STATS_RECORD(stats, stage, start) (stats).recordLatency(stage, monotonicMicroseconds() - (start))
+#define STATS_COUNT(stats, counter) (stats).count(counter)
+#define STATS_ADD(stats, counter, value) (stats).add(counter, value)
+#else
+#define STATS_TIMESTAMP(name) ((void)0)
+#define STATS_RECORD(stats, stage, start) ((void)0)
+#define STATS_COUNT(stats, counter) ((void)0)
+#define STATS_ADD(stats, counter, value) ((void)0)
+#endif
+
+/* monotonicMicroseconds()-Funktion: Aktuelle Zeit einer monotonen Uhr (wird nicht von Zeitumstellungen beeinflusst)
+		- @param return: Zeit in Mikrosekunden*/
+long long monotonicMicroseconds();
+
+// Gemessene Stufen der Pipeline
+enum PipelineStage {
+
+	STAGE_CAPTURE_WAIT = 0,		// Warten auf das nächste Kamerabild (grab())
+	STAGE_DECODE,				// Dekodieren/Umwandeln des Bildes (retrieve())
+	STAGE_DETECT_MARKERS,		// Markererkennung
+	STAGE_ESTIMATE_POSE,		// Posenschätzung (PoseTracker) und Rückprojektion
+	STAGE_RENDER,				// Zeichnen und imshow() in der Debug-Anzeige
+	STAGE_CAPTURE_TO_PUBLISH,	// Gesamtzeit von der Aufnahme (Ende von grab()) bis zur Veröffentlichung des Ergebnisses
+	STAGE_COUNT
+};
+
+// Gezählte Ereignisse der Pipeline
+enum PipelineCounter {
+
+	COUNTER_FRAMES_CAPTURED = 0,	// Erfolgreich gelesene Bilder
+	COUNTER_CAPTURE_FAILURES,		// Bilder, die nicht gelesen werden konnten
+	COUNTER_FRAMES_PROCESSED,		// Bilder, für die ein Ergebnis veröffentlicht wurde
+	COUNTER_FRAMES_WITH_MARKERS,	// Davon Bilder mit mindestens einem Marker
+	COUNTER_DROPPED_RESULTS,		// Ergebnisse, die überschrieben wurden, bevor der Aufrufer sie abgeholt hat
+	COUNTER_FRAMES_SKIPPED,			// Bilder ohne Veränderung, für die das letzte Ergebnis wiederholt wurde
+	COUNTER_INGESTED_BYTES,			// Bytes, die Aufnahme und Grauwandlung gelesen und geschrieben haben (STATS_ADD)
+	COUNTER_COUNT
+};
+
+/* StageLatency-Struktur: Perzentile der Laufzeit einer Stufe über die letzten Messungen in Mikrosekunden*/
+struct StageLatency {
+
+	double p50;
+	double p95;
+	double p99;
+	double max;
+};
+
+/* DetectorStats-Struktur: Statistik der Pipeline, wie sie über getStats() an den Aufrufer geht. Nur Werttypen, damit
+   die Struktur direkt aus C# übergeben werden kann (siehe CubeScript.cs)*/
+struct DetectorStats {
+
+	long long framesCaptured;
+	long long captureFailures;
+	long long framesProcessed;
+	long long framesWithMarkers;
+	long long droppedResults;
+
+	// Bilder, in denen wegen unveränderter Szene nicht erkannt wurde (in framesProcessed enthalten)
+	long long framesSkipped;
+
+	// Bytes, die vom Puffer der Kamera bis zum Graubild der Erkennung (und für Farbbilder der Anzeige und des Exports)
+	// gelesen und geschrieben wurden, über alle Bilder
+	long long ingestedBytes;
+
+	// Anteil der Bilder mit mindestens einem erkannten Marker (0..1)
+	double detectionHitRate;
+
+	StageLatency captureWait;
+	StageLatency decode;
+	StageLatency detectMarkers;
+	StageLatency estimatePose;
+	StageLatency render;
+
+	// Alter eines Ergebnisses bei der Veröffentlichung (Aufnahme bis Veröffentlichung)
+	StageLatency captureToPublish;
+};
+
+/* PipelineStats-Klasse: Sammelt die Laufzeiten der Stufen in rollenden Fenstern und zählt Ereignisse. Jede Stufe hat
+   genau einen schreibenden Thread, gelesen werden darf aus jedem Thread. Eine Messung kostet nur zwei relaxte
+   atomare Schreibzugriffe, sortiert wird erst beim Auslesen. Die CSV-Datei schreibt ein eigener Thread, die Pipeline
+   selbst formatiert und schreibt nie*/
+class PipelineStats {
+
+public:
+
+	PipelineStats();
+	~PipelineStats();
+
+	void recordLatency(PipelineStage stage, long long microseconds);
+	void count(PipelineCounter counter);
+	void add(PipelineCounter counter, long long value);
+
+	/* reset()-Funktion: Verwirft alle Messungen und Zähler. Nur aufrufen, während die Pipeline nicht läuft*/
+	void reset();
+
+	/* snapshot()-Funktion: Berechnet die Perzentile der aktuellen Fenster und liest die Zähler. Sortiert wird in einem
+	   Puffer auf dem Stack, es wird nichts allokiert
+			- @param stats: Struktur des Aufrufers, in die geschrieben wird*/
+	void snapshot(DetectorStats& stats) const;
+
+	/* setDumpFile()-Funktion: Schreibt die Statistik regelmäßig als CSV-Zeile in eine Datei. Geschrieben wird in einem
+	   eigenen Thread, der mit der Datei gestartet und beendet wird
+			- @param path: Pfad der Datei (wird überschrieben), nullptr oder "" beendet das Schreiben
+			- @param intervalMilliseconds: Abstand zwischen zwei Zeilen
+			- @param return: False, wenn die Datei nicht geöffnet werden konnte*/
+	bool setDumpFile(const char* path, int intervalMilliseconds);
+
+private:
+
+	// Anzahl der Messungen pro rollendem Fenster
+	static const int windowSize = 1024;
+
+	struct LatencyWindow {
+
+		std::atomic<unsigned int> samples[windowSize];
+		std::atomic<unsigned long long> written;
+	};
+
+	void summarize(const LatencyWindow& window, StageLatency& latency) const;
+	void stopDumpThread();
+	void dumpLoop();
+
+	LatencyWindow windows[STAGE_COUNT];
+	std::atomic<long long> counters[COUNTER_COUNT];
+
+	// Ausgabe der regelmäßigen CSV-Zeilen im Thread dumpThread, dumpStopping beendet ihn (beides unter dumpMutex)
+	std::mutex dumpMutex;
+	std::condition_variable dumpCondition;
+	std::thread dumpThread;
+	bool dumpStopping;
+	std::ofstream dumpStream;
+	long long dumpInterval;
+};
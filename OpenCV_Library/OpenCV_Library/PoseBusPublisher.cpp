@@ -0,0 +1,207 @@
+#include "PoseBusPublisher.h"
+#include "PipelineStats.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+using namespace std;
+
+// Die Marker werden Byte für Byte in den Bus kopiert
+static_assert(sizeof(MarkerPose) == sizeof(PoseBusMarker), "MarkerPose und PoseBusMarker müssen gleich aufgebaut sein");
+
+
+PoseBusPublisher::PoseBusPublisher() : header(nullptr), slots(nullptr), mapping(nullptr), writerMutex(nullptr),
+	writerFile(-1) {
+
+}
+
+
+PoseBusPublisher::~PoseBusPublisher() {
+
+	close();
+}
+
+
+bool PoseBusPublisher::open(const string& name) {
+
+	close();
+
+	const size_t size = poseBusSize();
+	void* memory = nullptr;
+
+#if defined(_WIN32)
+	// Der Bus gehört dem, der den Mutex anlegt. Gibt es ihn schon, schreibt bereits ein anderer Publisher, der Speicher
+	// wird dann gar nicht erst angefasst. Windows löscht den Mutex mit dem letzten Handle, also auch beim Absturz
+	HANDLE ownership = CreateMutexA(nullptr, FALSE, (name + "_Writer").c_str());
+
+	if (ownership == nullptr || GetLastError() == ERROR_ALREADY_EXISTS) {
+
+		if (ownership != nullptr) {
+
+			CloseHandle(ownership);
+		}
+
+		return false;
+	}
+
+	HANDLE handle = CreateFileMappingA(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE, 0, (DWORD)size, name.c_str());
+
+	if (handle == nullptr) {
+
+		CloseHandle(ownership);
+		return false;
+	}
+
+	memory = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, size);
+
+	if (memory == nullptr) {
+
+		CloseHandle(handle);
+		CloseHandle(ownership);
+		return false;
+	}
+
+	mapping = handle;
+	writerMutex = ownership;
+#else
+	// Der Speicher bleibt nach close() bestehen, damit Leser ihn nicht neu öffnen müssen, wenn die DLL neu startet
+	const string path = "/" + name;
+	int file = shm_open(path.c_str(), O_CREAT | O_RDWR, 0644);
+
+	if (file < 0) {
+
+		return false;
+	}
+
+	// Der Bus gehört dem, der die Sperre hält. flock() gilt pro geöffnetem Deskriptor, sperrt also auch einen zweiten
+	// Publisher im selben Prozess aus, und wird mit dem Deskriptor (auch beim Absturz) wieder frei
+	if (flock(file, LOCK_EX | LOCK_NB) != 0 || ftruncate(file, (off_t)size) != 0) {
+
+		::close(file);
+		return false;
+	}
+
+	memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, file, 0);
+
+	if (memory == MAP_FAILED) {
+
+		::close(file);
+		return false;
+	}
+
+	writerFile = file;
+#endif
+
+	header = static_cast<PoseBusHeader*>(memory);
+	slots = poseBusSlots(header);
+
+	const bool compatible = poseBusLoadAcquire(&header->magic) == POSE_BUS_MAGIC && header->version == POSE_BUS_VERSION &&
+		header->capacity == POSE_BUS_CAPACITY && header->maxMarkers == POSE_BUS_MAX_MARKERS &&
+		header->slotSize == sizeof(PoseBusSlot);
+
+	if (!compatible) {
+
+		// Neuer (oder fremder) Speicher: Erst alles andere anlegen, die Kennung zuletzt, damit kein Leser einen halb
+		// angelegten Header für gültig hält
+		poseBusStoreRelease(&header->magic, 0);
+		memset(slots, 0, POSE_BUS_CAPACITY * sizeof(PoseBusSlot));
+		header->version = POSE_BUS_VERSION;
+		header->capacity = POSE_BUS_CAPACITY;
+		header->maxMarkers = POSE_BUS_MAX_MARKERS;
+		header->slotSize = sizeof(PoseBusSlot);
+		poseBusStoreRelease(&header->published, 0);
+		poseBusStoreRelease(&header->magic, POSE_BUS_MAGIC);
+	}
+
+	// Ein Schreiber, der mitten in einem Eintrag beendet wurde, hinterlässt einen ungeraden Zähler. Der halb
+	// geschriebene Eintrag bekommt Index 0, damit ihn kein Leser für gültig hält
+	for (unsigned int s = 0; s < POSE_BUS_CAPACITY; ++s) {
+
+		if (slots[s].lock & 1u) {
+
+			slots[s].record.index = 0;
+			poseBusStoreRelease(&slots[s].lock, slots[s].lock + 1);
+		}
+	}
+
+	return true;
+}
+
+
+void PoseBusPublisher::close() {
+
+	if (!header) {
+
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile(header);
+	CloseHandle(static_cast<HANDLE>(mapping));
+	CloseHandle(static_cast<HANDLE>(writerMutex));
+#else
+	munmap(header, poseBusSize());
+	::close(writerFile);
+#endif
+
+	header = nullptr;
+	slots = nullptr;
+	mapping = nullptr;
+	writerMutex = nullptr;
+	writerFile = -1;
+}
+
+
+bool PoseBusPublisher::isOpen() const {
+
+	return header != nullptr;
+}
+
+
+/* publish()-Funktion: Seqlock-Protokoll des Schreibers (siehe PoseBus.h). Der Platz wird zuerst als "in Arbeit"
+   markiert, dann beschrieben, dann mit dem nächsten geraden Zähler freigegeben. Erst danach wird published erhöht, so
+   dass ein Leser den neuesten Eintrag immer fertig vorfindet*/
+void PoseBusPublisher::publish(unsigned long long sequence, int detectionPath, long long captureTimestamp,
+	const MarkerPose* markers, int markerCount) {
+
+	if (!header) {
+
+		return;
+	}
+
+	const uint32_t index = header->published + 1;
+	PoseBusSlot& slot = slots[(index - 1) % POSE_BUS_CAPACITY];
+	const uint32_t lock = slot.lock;
+
+	poseBusStoreRelease(&slot.lock, lock + 1);
+	poseBusFenceRelease();
+
+	PoseBusRecord& record = slot.record;
+	const int count = max(0, min(markerCount, POSE_BUS_MAX_MARKERS));
+
+	record.index = index;
+	record.detectionPath = detectionPath;
+	record.sequence = sequence;
+	record.captureTimestamp = captureTimestamp;
+	record.publishTimestamp = monotonicMicroseconds();
+	record.markerCount = count;
+	memcpy(record.markers, markers, count * sizeof(PoseBusMarker));
+
+	poseBusStoreRelease(&slot.lock, lock + 2);
+	poseBusStoreRelease(&header->published, index);
+}
+
+
+unsigned int PoseBusPublisher::publishedCount() const {
+
+	return header ? poseBusLoadAcquire(&header->published) : 0;
+}
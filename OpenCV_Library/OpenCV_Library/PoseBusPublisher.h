@@ -0,0 +1,57 @@
+#pragma once
+
+#include <string>
+#include "MarkerPose.h"
+#include "../PoseBusReader/PoseBus.h"
+
+/* PoseBusPublisher-Klasse: Schreibseite des Posen-Busses im gemeinsamen Speicher (Aufbau siehe PoseBus.h). Damit teilen
+   sich mehrere lokale Programme (Unity, Logger, Auswertung) eine einzige Markererkennung, statt jeweils eigene Kameras
+   und Detektoren zu öffnen. Die Leser verwenden die C-Bibliothek in PoseBusReader. Der Speicher wird unter Windows als
+   benanntes File-Mapping, sonst mit shm_open() angelegt. Es gibt genau einen Schreiber pro Bus: open() belegt den Bus
+   über ein Objekt des Betriebssystems (benannter Mutex bzw. flock() auf den Speicher), das beim Beenden des Prozesses
+   auch nach einem Absturz wieder frei wird. publish() kopiert nur das Ergebnis in den nächsten Platz des Rings und
+   wartet nie auf Leser*/
+class PoseBusPublisher {
+
+public:
+
+	PoseBusPublisher();
+	~PoseBusPublisher();
+
+	PoseBusPublisher(const PoseBusPublisher&) = delete;
+	PoseBusPublisher& operator=(const PoseBusPublisher&) = delete;
+
+	/* open()-Funktion: Legt den gemeinsamen Speicher an oder öffnet einen vorhandenen mit gleichem Aufbau (dann werden
+	   die Indizes fortgesetzt, so dass laufende Leser nach einem Neustart der DLL weiterlesen können)
+			- @param name: Name des Busses
+			- @param return: False, wenn der Speicher nicht angelegt werden konnte oder der Bus schon einen Schreiber hat
+							 (auch einen anderen PoseBusPublisher im selben Prozess)*/
+	bool open(const std::string& name);
+	void close();
+	bool isOpen() const;
+
+	/* publish()-Funktion: Schreibt ein Ergebnis als neuen Eintrag in den Ring (nur ein Thread)
+			- @param sequence: Nummer des Ergebnisses
+			- @param detectionPath: Weg der Erkennung
+			- @param captureTimestamp: Aufnahmezeitpunkt in Mikrosekunden
+			- @param markers: Posen der Marker
+			- @param markerCount: Anzahl der Marker (höchstens POSE_BUS_MAX_MARKERS werden geschrieben)*/
+	void publish(unsigned long long sequence, int detectionPath, long long captureTimestamp, const MarkerPose* markers,
+		int markerCount);
+
+	/* publishedCount()-Funktion: Anzahl der bisher veröffentlichten Einträge
+			- @param return: 0, wenn der Bus nicht offen ist*/
+	unsigned int publishedCount() const;
+
+private:
+
+	PoseBusHeader* header;
+	PoseBusSlot* slots;
+
+	// Handle des File-Mappings und des Mutex, der den Bus für diesen Schreiber belegt (nur Windows)
+	void* mapping;
+	void* writerMutex;
+
+	// Mit flock() belegter Deskriptor des Speichers, -1 wenn nicht offen (nur POSIX)
+	int writerFile;
+};
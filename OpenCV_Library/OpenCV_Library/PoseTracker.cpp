@@ -0,0 +1,716 @@
+#include "PoseTracker.h"
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <opencv2/calib3d.hpp>
+
+using namespace std;
+using namespace cv;
+
+// Messrauschen einer Einzelpose (Standardabweichung in Metern bzw. Radiant)
+const double translationMeasurementNoise = 0.002;
+const double rotationMeasurementNoise = 0.02;
+
+// Erwartete Beschleunigung eines bewegten Markers (Standardabweichung in m/s² bzw. rad/s²). Größere Werte folgen
+// schnellen Bewegungen besser, glätten aber weniger
+const double translationAcceleration = 3.0;
+const double rotationAcceleration = 20.0;
+
+// Weicht eine Messung um mehr als so viele Meter von der Vorhersage ab, wird die Spur neu begonnen statt gefiltert
+const double maxTrackJump = 0.15;
+
+// Abbruch der Verfeinerung wie bei solvePnP() mit SOLVEPNP_ITERATIVE: höchstens 20 Schritte oder eine relative
+// Änderung der Pose unter FLT_EPSILON
+const int maxRefineIterations = 20;
+
+
+/* rotationMatrix()-Funktion: Rotationsmatrix eines Rotationsvektors (wie Rodrigues())
+		- @param rVec: Rotationsvektor (Achse mal Winkel)
+		- @param return: 3x3-Rotationsmatrix*/
+static Matx33d rotationMatrix(const Vec3d& rVec) {
+
+	double theta = norm(rVec);
+
+	if (theta < DBL_EPSILON) {
+
+		return Matx33d::eye();
+	}
+
+	Vec3d k = rVec * (1.0 / theta);
+	double c = cos(theta);
+	double s = sin(theta);
+	double c1 = 1.0 - c;
+
+	return Matx33d(
+		c + c1 * k[0] * k[0], c1 * k[0] * k[1] - s * k[2], c1 * k[0] * k[2] + s * k[1],
+		c1 * k[1] * k[0] + s * k[2], c + c1 * k[1] * k[1], c1 * k[1] * k[2] - s * k[0],
+		c1 * k[2] * k[0] - s * k[1], c1 * k[2] * k[1] + s * k[0], c + c1 * k[2] * k[2]);
+}
+
+
+/* rotationVector()-Funktion: Rotationsvektor einer Rotationsmatrix (wie Rodrigues(), Winkel zwischen 0 und pi)
+		- @param R: Orthonormale 3x3-Rotationsmatrix
+		- @param return: Rotationsvektor*/
+static Vec3d rotationVector(const Matx33d& R) {
+
+	Vec3d r(R(2, 1) - R(1, 2), R(0, 2) - R(2, 0), R(1, 0) - R(0, 1));
+
+	double s = sqrt(r.dot(r) * 0.25);
+	double c = min(max((R(0, 0) + R(1, 1) + R(2, 2) - 1.0) * 0.5, -1.0), 1.0);
+	double theta = acos(c);
+
+	if (s >= 1e-5) {
+
+		return r * (theta / (2.0 * s));
+	}
+
+	if (c > 0.0) {
+
+		return Vec3d();
+	}
+
+	// Drehung um 180°: die Achse folgt aus der Diagonale, die Vorzeichen aus den Elementen außerhalb
+	r[0] = sqrt(max((R(0, 0) + 1.0) * 0.5, 0.0));
+	r[1] = sqrt(max((R(1, 1) + 1.0) * 0.5, 0.0)) * (R(0, 1) < 0.0 ? -1.0 : 1.0);
+	r[2] = sqrt(max((R(2, 2) + 1.0) * 0.5, 0.0)) * (R(0, 2) < 0.0 ? -1.0 : 1.0);
+
+	if (fabs(r[0]) < fabs(r[1]) && fabs(r[0]) < fabs(r[2]) && (R(1, 2) > 0.0) != (r[1] * r[2] > 0.0)) {
+
+		r[2] = -r[2];
+	}
+
+	return r * (theta / norm(r));
+}
+
+
+/* squareRotations()-Funktion: Die beiden Rotationen eines ebenen Markers aus der Ableitung der Homographie in der
+   Markermitte (computeRotations() von IPPE in OpenCV)
+		- @param J: Jacobi-Matrix der Homographie in der Markermitte (normierte Bildkoordinaten)
+		- @param p: Bild der Markermitte, x
+		- @param q: Bild der Markermitte, y
+		- @param first: Ausgabe der ersten Rotation
+		- @param second: Ausgabe der zweiten Rotation
+		- @param return: False, wenn die Homographie entartet ist*/
+static bool squareRotations(const Matx22d& J, double p, double q, Matx33d& first, Matx33d& second) {
+
+	// Kürzeste Rotation, die die z-Achse auf die Sichtlinie zur Markermitte dreht
+	Vec3d v(p, q, 1.0);
+	v *= 1.0 / norm(v);
+
+	Matx33d Rv;
+
+	if (fabs(1.0 + v[2]) < FLT_EPSILON) {
+
+		Rv = Matx33d(1, 0, 0, 0, 1, 0, 0, 0, -1);
+	}
+	else {
+
+		double d = 1.0 / (1.0 + v[2]);
+
+		Rv = Matx33d(
+			1.0 - v[0] * v[0] * d, -v[0] * v[1] * d, v[0],
+			-v[0] * v[1] * d, 1.0 - v[1] * v[1] * d, v[1],
+			-v[0], -v[1], 1.0 - (v[0] * v[0] + v[1] * v[1]) * d);
+	}
+
+	Matx22d B(Rv(0, 0) - p * Rv(2, 0), Rv(0, 1) - p * Rv(2, 1), Rv(1, 0) - q * Rv(2, 0), Rv(1, 1) - q * Rv(2, 1));
+	double determinant = B(0, 0) * B(1, 1) - B(0, 1) * B(1, 0);
+
+	if (determinant == 0.0) {
+
+		return false;
+	}
+
+	Matx22d A = Matx22d(B(1, 1), -B(0, 1), -B(1, 0), B(0, 0)) * (1.0 / determinant) * J;
+
+	// Größter Singulärwert von A
+	double ata00 = A(0, 0) * A(0, 0) + A(0, 1) * A(0, 1);
+	double ata01 = A(0, 0) * A(1, 0) + A(0, 1) * A(1, 1);
+	double ata11 = A(1, 0) * A(1, 0) + A(1, 1) * A(1, 1);
+	double gamma = sqrt(0.5 * (ata00 + ata11 + sqrt((ata00 - ata11) * (ata00 - ata11) + 4.0 * ata01 * ata01)));
+
+	if (fabs(gamma) < FLT_EPSILON) {
+
+		return false;
+	}
+
+	Matx22d R = A * (1.0 / gamma);
+
+	// Die dritte Zeile der ersten beiden Spalten ist bis auf das Vorzeichen bestimmt, daraus die beiden Lösungen
+	double b0 = sqrt(max(1.0 - R(0, 0) * R(0, 0) - R(1, 0) * R(1, 0), 0.0));
+	double b1 = sqrt(max(1.0 - R(0, 1) * R(0, 1) - R(1, 1) * R(1, 1), 0.0));
+
+	if (-R(0, 0) * R(0, 1) - R(1, 0) * R(1, 1) < 0.0) {
+
+		b1 = -b1;
+	}
+
+	for (int solution = 0; solution < 2; ++solution) {
+
+		double sign = solution == 0 ? 1.0 : -1.0;
+		Vec3d column0(R(0, 0), R(1, 0), sign * b0);
+		Vec3d column1(R(0, 1), R(1, 1), sign * b1);
+		Vec3d column2 = column0.cross(column1);
+
+		Matx33d local(column0[0], column1[0], column2[0], column0[1], column1[1], column2[1],
+			column0[2], column1[2], column2[2]);
+
+		(solution == 0 ? first : second) = Rv * local;
+	}
+
+	return true;
+}
+
+
+void PoseTracker::AxisFilter::initialize(double measurement, double measurementVariance) {
+
+	value = measurement;
+	velocity = 0.0;
+
+	// Die Geschwindigkeit ist anfangs unbekannt, deshalb große Unsicherheit
+	p00 = measurementVariance;
+	p01 = 0.0;
+	p11 = 1.0;
+}
+
+
+/* predict()-Funktion: Zustand und Kovarianz um dt Sekunden fortschreiben (Rauschen als stückweise konstante
+   Beschleunigung)*/
+void PoseTracker::AxisFilter::predict(double dt, double accelerationVariance) {
+
+	value += velocity * dt;
+
+	double dt2 = dt * dt;
+
+	p00 += dt * (2.0 * p01 + dt * p11) + 0.25 * dt2 * dt2 * accelerationVariance;
+	p01 += dt * p11 + 0.5 * dt2 * dt * accelerationVariance;
+	p11 += dt2 * accelerationVariance;
+}
+
+
+void PoseTracker::AxisFilter::correct(double measurement, double measurementVariance) {
+
+	double innovation = measurement - value;
+	double innovationVariance = p00 + measurementVariance;
+	double gainValue = p00 / innovationVariance;
+	double gainVelocity = p01 / innovationVariance;
+
+	value += gainValue * innovation;
+	velocity += gainVelocity * innovation;
+
+	p11 -= gainVelocity * p01;
+	p01 -= gainValue * p01;
+	p00 -= gainValue * p00;
+}
+
+
+double PoseTracker::AxisFilter::extrapolate(double dt) const {
+
+	return value + velocity * dt;
+}
+
+
+PoseTracker::PoseTracker(float markerLength)
+	: objectPoints(4, 1, CV_32FC3), filtering(true), lastTimestamp(0) {
+
+	objectPoints.at<Vec3f>(0) = Vec3f(-markerLength / 2.f, markerLength / 2.f, 0);
+	objectPoints.at<Vec3f>(1) = Vec3f(markerLength / 2.f, markerLength / 2.f, 0);
+	objectPoints.at<Vec3f>(2) = Vec3f(markerLength / 2.f, -markerLength / 2.f, 0);
+	objectPoints.at<Vec3f>(3) = Vec3f(-markerLength / 2.f, -markerLength / 2.f, 0);
+
+	for (int i = 0; i < 4; ++i) {
+
+		const Vec3f& corner = objectPoints.at<Vec3f>(i);
+		objectCorners[i] = Vec3d(corner[0], corner[1], corner[2]);
+	}
+}
+
+
+void PoseTracker::track(long long timestamp, const vector<int>& ids, const vector<vector<Point2f>>& corners,
+	const Mat& cameraMatrix, const Mat& distanceCoefficients, vector<Vec3d>& rotationVectors,
+	vector<Vec3d>& translationVectors, vector<TrackedPose>& poses) {
+
+	rotationVectors.resize(ids.size());
+	translationVectors.resize(ids.size());
+	poses.resize(ids.size());
+
+	// Entzerrte Ecken (der Weg der Pipeline) werden ohne solvePnP() gelöst
+	const bool ownSolver = distanceCoefficients.empty() && !ids.empty();
+	Matx33d camera;
+
+	if (ownSolver) {
+
+		camera = Matx33d(cameraMatrix);
+	}
+
+	for (size_t i = 0; i < ids.size(); ++i) {
+
+		Vec3d& rVec = rotationVectors[i];
+		Vec3d& tVec = translationVectors[i];
+
+		poses[i].id = ids[i];
+		poses[i].measurementIndex = (int)i;
+
+		// Ein Marker, dessen ID im selben Bild schon einmal vorkam, bekommt keinen Filter
+		Track* track = filtering ? findTrack(ids[i]) : nullptr;
+		bool warmStart = track && track->timestamp < timestamp;
+
+		if (warmStart) {
+
+			TrackedPose predicted;
+			trackPose(*track, timestamp, predicted);
+
+			rVec = predicted.rotationVector;
+			tVec = predicted.translationVector;
+
+			// Ausgehend von der Vorhersage konvergiert das Levenberg-Marquardt-Verfahren meist nach wenigen Schritten
+			warmStart = (ownSolver ? refinePose(corners[i], camera, rVec, tVec) : solvePnP(objectPoints, corners[i],
+				cameraMatrix, distanceCoefficients, rVec, tVec, true, SOLVEPNP_ITERATIVE)) && tVec[2] > 0.0;
+		}
+
+		if (!warmStart) {
+
+			if (ownSolver) {
+
+				solveSquare(corners[i], camera, rVec, tVec);
+			}
+			else {
+
+				solvePnP(objectPoints, corners[i], cameraMatrix, distanceCoefficients, rVec, tVec, false,
+					SOLVEPNP_IPPE_SQUARE);
+			}
+		}
+
+		if (!filtering || (track && track->timestamp == timestamp)) {
+
+			poses[i].rotationVector = rVec;
+			poses[i].translationVector = tVec;
+			poses[i].rotationVelocity = Vec3d();
+			poses[i].translationVelocity = Vec3d();
+			continue;
+		}
+
+		if (!track) {
+
+			tracks.push_back(Track());
+			track = &tracks.back();
+			startTrack(*track, ids[i], timestamp, rVec, tVec);
+		}
+		else {
+
+			double dt = (timestamp - track->timestamp) * 1e-6;
+			Vec3d predictedTranslation(track->axes[3].extrapolate(dt), track->axes[4].extrapolate(dt),
+				track->axes[5].extrapolate(dt));
+
+			if (!warmStart || norm(tVec - predictedTranslation) > maxTrackJump) {
+
+				startTrack(*track, ids[i], timestamp, rVec, tVec);
+			}
+			else {
+
+				// Derselben Rotation entspricht auch der Vektor mit Winkel (theta - 2 pi). Nahe 180° wird der genommen,
+				// der näher an der Spur liegt, damit der Filter nicht über den Sprung hinweg mittelt
+				Vec3d predictedRotation(track->axes[0].extrapolate(dt), track->axes[1].extrapolate(dt),
+					track->axes[2].extrapolate(dt));
+				double angle = norm(rVec);
+
+				if (angle > 1e-9) {
+
+					Vec3d alternative = rVec * ((angle - 2.0 * CV_PI) / angle);
+
+					if (norm(alternative - predictedRotation) < norm(rVec - predictedRotation)) {
+
+						rVec = alternative;
+					}
+				}
+
+				for (int k = 0; k < 3; ++k) {
+
+					track->axes[k].predict(dt, rotationAcceleration * rotationAcceleration);
+					track->axes[k].correct(rVec[k], rotationMeasurementNoise * rotationMeasurementNoise);
+					track->axes[k + 3].predict(dt, translationAcceleration * translationAcceleration);
+					track->axes[k + 3].correct(tVec[k], translationMeasurementNoise * translationMeasurementNoise);
+				}
+
+				track->timestamp = timestamp;
+			}
+		}
+
+		trackPose(*track, timestamp, poses[i]);
+		poses[i].measurementIndex = (int)i;
+	}
+
+	lastTimestamp = timestamp;
+
+	// Spuren, die zu lange nicht mehr gemessen wurden, werden verworfen, die übrigen nicht erkannten vorhergesagt
+	tracks.erase(remove_if(tracks.begin(), tracks.end(), [timestamp](const Track& track) {
+		return timestamp - track.timestamp > maxPredictionTime; }), tracks.end());
+
+	for (const Track& track : tracks) {
+
+		if (track.timestamp < timestamp) {
+
+			poses.push_back(TrackedPose());
+			trackPose(track, timestamp, poses.back());
+		}
+	}
+}
+
+
+void PoseTracker::predict(long long timestamp, vector<TrackedPose>& poses) const {
+
+	poses.clear();
+
+	for (const Track& track : tracks) {
+
+		if (timestamp - track.timestamp <= maxPredictionTime) {
+
+			poses.push_back(TrackedPose());
+			trackPose(track, timestamp, poses.back());
+		}
+	}
+}
+
+
+void PoseTracker::hold(long long timestamp) {
+
+	for (Track& track : tracks) {
+
+		if (track.timestamp != lastTimestamp) {
+
+			continue;
+		}
+
+		track.timestamp = timestamp;
+
+		for (AxisFilter& axis : track.axes) {
+
+			axis.velocity = 0.0;
+		}
+	}
+
+	lastTimestamp = timestamp;
+}
+
+
+void PoseTracker::setFiltering(bool enabled) {
+
+	filtering = enabled;
+
+	if (!enabled) {
+
+		reset();
+	}
+}
+
+
+void PoseTracker::reset() {
+
+	tracks.clear();
+}
+
+
+void PoseTracker::projectMarker(const Vec3d& rotationVector, const Vec3d& translationVector, const Mat& cameraMatrix,
+	const Mat& distanceCoefficients, vector<Point2f>& corners) const {
+
+	const int count = (int)distanceCoefficients.total();
+
+	if (count > 12 || cameraMatrix.type() != CV_64F || (count > 0 && distanceCoefficients.type() != CV_64F)) {
+
+		projectPoints(objectPoints, rotationVector, translationVector, cameraMatrix, distanceCoefficients, corners);
+		return;
+	}
+
+	// k1, k2, p1, p2, k3, k4, k5, k6, s1, s2, s3, s4 wie bei projectPoints(), fehlende Koeffizienten sind 0
+	double k[12] = {};
+
+	for (int i = 0; i < count; ++i) {
+
+		k[i] = distanceCoefficients.at<double>(i);
+	}
+
+	const Matx33d camera(cameraMatrix.ptr<double>());
+	const Matx33d rotation = rotationMatrix(rotationVector);
+
+	corners.resize(4);
+
+	for (int i = 0; i < 4; ++i) {
+
+		Vec3d point = rotation * objectCorners[i] + translationVector;
+		double z = point[2] != 0.0 ? 1.0 / point[2] : 1.0;
+		double x = point[0] * z;
+		double y = point[1] * z;
+
+		double r2 = x * x + y * y;
+		double r4 = r2 * r2;
+		double r6 = r4 * r2;
+		double radial = (1.0 + k[0] * r2 + k[1] * r4 + k[4] * r6) / (1.0 + k[5] * r2 + k[6] * r4 + k[7] * r6);
+		double xd = x * radial + 2.0 * k[2] * x * y + k[3] * (r2 + 2.0 * x * x) + k[8] * r2 + k[9] * r4;
+		double yd = y * radial + k[2] * (r2 + 2.0 * y * y) + 2.0 * k[3] * x * y + k[10] * r2 + k[11] * r4;
+
+		corners[i] = Point2f((float)(camera(0, 0) * xd + camera(0, 2)), (float)(camera(1, 1) * yd + camera(1, 2)));
+	}
+}
+
+
+/* findTrack()-Funktion: Sucht die Spur eines Markers (höchstens maxMarkers Spuren, deshalb linear)
+		- @param id: Marker-ID
+		- @param return: Spur oder nullptr, wenn der Marker nicht verfolgt wird*/
+PoseTracker::Track* PoseTracker::findTrack(int id) {
+
+	for (Track& track : tracks) {
+
+		if (track.id == id) {
+
+			return &track;
+		}
+	}
+
+	return nullptr;
+}
+
+
+void PoseTracker::startTrack(Track& track, int id, long long timestamp, const Vec3d& rVec, const Vec3d& tVec) {
+
+	track.id = id;
+	track.timestamp = timestamp;
+
+	for (int k = 0; k < 3; ++k) {
+
+		track.axes[k].initialize(rVec[k], rotationMeasurementNoise * rotationMeasurementNoise);
+		track.axes[k + 3].initialize(tVec[k], translationMeasurementNoise * translationMeasurementNoise);
+	}
+}
+
+
+/* trackPose()-Funktion: Pose einer Spur zu einem Zeitpunkt (ab der letzten Messung mit konstanter Geschwindigkeit
+   fortgeschrieben)*/
+void PoseTracker::trackPose(const Track& track, long long timestamp, TrackedPose& pose) const {
+
+	double dt = (timestamp - track.timestamp) * 1e-6;
+
+	pose.id = track.id;
+	pose.measurementIndex = -1;
+
+	for (int k = 0; k < 3; ++k) {
+
+		pose.rotationVector[k] = track.axes[k].extrapolate(dt);
+		pose.translationVector[k] = track.axes[k + 3].extrapolate(dt);
+		pose.rotationVelocity[k] = track.axes[k].velocity;
+		pose.translationVelocity[k] = track.axes[k + 3].velocity;
+	}
+}
+
+
+/* solveSquare()-Funktion: Pose eines Markers ohne Startwert wie solvePnP() mit SOLVEPNP_IPPE_SQUARE. Aus der
+   Homographie zwischen Marker und Bild folgen zwei Rotationen, genommen wird die mit dem kleineren Rückprojektionsfehler
+		- @param corners: Die 4 entzerrten Ecken in Pixeln
+		- @param camera: Kameramatrix
+		- @param rVec: Ausgabe des Rotationsvektors
+		- @param tVec: Ausgabe des Translationsvektors
+		- @param return: False, wenn die Ecken entartet sind (rVec und tVec bleiben dann unverändert)*/
+bool PoseTracker::solveSquare(const vector<Point2f>& corners, const Matx33d& camera, Vec3d& rVec, Vec3d& tVec) const {
+
+	// Ecken in normierten Bildkoordinaten
+	Vec2d points[4];
+
+	for (int i = 0; i < 4; ++i) {
+
+		points[i] = Vec2d((corners[i].x - camera(0, 2)) / camera(0, 0), (corners[i].y - camera(1, 2)) / camera(1, 1));
+	}
+
+	// Homographie von der Markerebene in die normierten Bildkoordinaten mit H(2, 2) = 1, genau bestimmt durch die vier
+	// Ecken
+	Matx<double, 8, 8> system;
+	Vec<double, 8> values;
+
+	for (int i = 0; i < 4; ++i) {
+
+		double x = objectCorners[i][0];
+		double y = objectCorners[i][1];
+		double u = points[i][0];
+		double v = points[i][1];
+
+		double rowU[8] = { x, y, 1.0, 0.0, 0.0, 0.0, -u * x, -u * y };
+		double rowV[8] = { 0.0, 0.0, 0.0, x, y, 1.0, -v * x, -v * y };
+
+		for (int j = 0; j < 8; ++j) {
+
+			system(2 * i, j) = rowU[j];
+			system(2 * i + 1, j) = rowV[j];
+		}
+
+		values[2 * i] = u;
+		values[2 * i + 1] = v;
+	}
+
+	// Matx::solve() liefert bei einem singulären System Nullen
+	Vec<double, 8> h = system.solve(values, DECOMP_LU);
+
+	if (h == Vec<double, 8>()) {
+
+		return false;
+	}
+
+	// Ableitung der Homographie in der Markermitte und ihr Bild
+	Matx22d J(h[0] - h[6] * h[2], h[1] - h[7] * h[2], h[3] - h[6] * h[5], h[4] - h[7] * h[5]);
+	Matx33d rotations[2];
+
+	if (!squareRotations(J, h[2], h[5], rotations[0], rotations[1])) {
+
+		return false;
+	}
+
+	Vec3d translations[2];
+	double errors[2];
+
+	for (int solution = 0; solution < 2; ++solution) {
+
+		// Translation im Sinne der kleinsten Quadrate: x * (r_z + t_z) = r_x + t_x, y * (r_z + t_z) = r_y + t_y
+		Matx33d normal;
+		Vec3d right;
+
+		for (int i = 0; i < 4; ++i) {
+
+			Vec3d rotated = rotations[solution] * objectCorners[i];
+			double u = points[i][0];
+			double v = points[i][1];
+
+			Vec3d rowU(1.0, 0.0, -u);
+			Vec3d rowV(0.0, 1.0, -v);
+
+			normal += rowU * rowU.t() + rowV * rowV.t();
+			right += rowU * (u * rotated[2] - rotated[0]) + rowV * (v * rotated[2] - rotated[1]);
+		}
+
+		translations[solution] = normal.solve(right, DECOMP_LU);
+		errors[solution] = reprojectionError(corners, camera, rotations[solution], translations[solution]);
+	}
+
+	int best = errors[0] < errors[1] ? 0 : 1;
+
+	rVec = rotationVector(rotations[best]);
+	tVec = translations[best];
+
+	return true;
+}
+
+
+/* refinePose()-Funktion: Verfeinert eine Pose ausgehend von einem Startwert wie solvePnP() mit SOLVEPNP_ITERATIVE und
+   useExtrinsicGuess (Levenberg-Marquardt über den Rückprojektionsfehler in Pixeln). Die Rotation wird dabei in jedem
+   Schritt um eine kleine Drehung ergänzt, statt den Rotationsvektor selbst abzuleiten
+		- @param corners: Die 4 entzerrten Ecken in Pixeln
+		- @param camera: Kameramatrix
+		- @param rVec: Startwert und Ausgabe des Rotationsvektors
+		- @param tVec: Startwert und Ausgabe des Translationsvektors
+		- @param return: False, wenn eine Ecke hinter die Kamera fällt (rVec und tVec bleiben dann unverändert)*/
+bool PoseTracker::refinePose(const vector<Point2f>& corners, const Matx33d& camera, Vec3d& rVec, Vec3d& tVec) const {
+
+	Matx33d rotation = rotationMatrix(rVec);
+	Vec3d translation = tVec;
+	double error = reprojectionError(corners, camera, rotation, translation);
+	double lambda = 1e-3;
+
+	for (int iteration = 0; iteration < maxRefineIterations; ++iteration) {
+
+		// Normalgleichungen J^T J und J^T r, Parameter sind die kleine Drehung und die Änderung der Translation
+		Matx<double, 6, 6> normal;
+		Vec<double, 6> gradient;
+
+		for (int i = 0; i < 4; ++i) {
+
+			Vec3d rotated = rotation * objectCorners[i];
+			Vec3d point = rotated + translation;
+
+			if (point[2] <= DBL_EPSILON) {
+
+				return false;
+			}
+
+			double iz = 1.0 / point[2];
+			Vec3d du(camera(0, 0) * iz, 0.0, -camera(0, 0) * point[0] * iz * iz);
+			Vec3d dv(0.0, camera(1, 1) * iz, -camera(1, 1) * point[1] * iz * iz);
+
+			// Eine kleine Drehung w verschiebt den Punkt um w x rotated, die Ableitung nach w ist also rotated x du
+			Vec3d duRotation = rotated.cross(du);
+			Vec3d dvRotation = rotated.cross(dv);
+			Vec<double, 6> ju(duRotation[0], duRotation[1], duRotation[2], du[0], du[1], du[2]);
+			Vec<double, 6> jv(dvRotation[0], dvRotation[1], dvRotation[2], dv[0], dv[1], dv[2]);
+
+			double ru = camera(0, 0) * point[0] * iz + camera(0, 2) - corners[i].x;
+			double rv = camera(1, 1) * point[1] * iz + camera(1, 2) - corners[i].y;
+
+			normal += ju * ju.t() + jv * jv.t();
+			gradient += ju * ru + jv * rv;
+		}
+
+		// Wie CvLevMarq: die Diagonale wird um den Faktor (1 + lambda) verstärkt, ein Schritt, der den Fehler
+		// vergrößert, wird mit zehnfachem lambda wiederholt
+		Vec<double, 6> step;
+		Matx33d nextRotation;
+		Vec3d nextTranslation;
+		double nextError = error;
+		bool accepted = false;
+
+		for (; lambda <= 1e16 && !accepted; lambda *= 10.0) {
+
+			Matx<double, 6, 6> damped = normal;
+
+			for (int k = 0; k < 6; ++k) {
+
+				damped(k, k) *= 1.0 + lambda;
+			}
+
+			step = damped.solve(-gradient, DECOMP_CHOLESKY);
+			nextRotation = rotationMatrix(Vec3d(step[0], step[1], step[2])) * rotation;
+			nextTranslation = translation + Vec3d(step[3], step[4], step[5]);
+			nextError = reprojectionError(corners, camera, nextRotation, nextTranslation);
+			accepted = nextError <= error;
+		}
+
+		if (!accepted) {
+
+			break;
+		}
+
+		lambda = max(lambda * 1e-2, 1e-16);
+		rotation = nextRotation;
+		translation = nextTranslation;
+		error = nextError;
+
+		if (norm(step) < FLT_EPSILON * (norm(rotationVector(rotation)) + norm(translation))) {
+
+			break;
+		}
+	}
+
+	rVec = rotationVector(rotation);
+	tVec = translation;
+
+	return true;
+}
+
+
+/* reprojectionError()-Funktion: Summe der quadrierten Abstände zwischen den Ecken und den projizierten Eckpunkten
+		- @param corners: Die 4 entzerrten Ecken in Pixeln
+		- @param camera: Kameramatrix
+		- @param rotation: Rotationsmatrix der Pose
+		- @param tVec: Translationsvektor der Pose
+		- @param return: Fehler in Pixeln²*/
+double PoseTracker::reprojectionError(const vector<Point2f>& corners, const Matx33d& camera, const Matx33d& rotation,
+	const Vec3d& tVec) const {
+
+	double error = 0.0;
+
+	for (int i = 0; i < 4; ++i) {
+
+		Vec3d point = rotation * objectCorners[i] + tVec;
+		double z = point[2] != 0.0 ? 1.0 / point[2] : 1.0;
+		double du = camera(0, 0) * point[0] * z + camera(0, 2) - corners[i].x;
+		double dv = camera(1, 1) * point[1] * z + camera(1, 2) - corners[i].y;
+
+		error += du * du + dv * dv;
+	}
+
+	return error;
+}
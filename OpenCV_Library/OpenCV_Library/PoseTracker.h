@@ -0,0 +1,135 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+/* TrackedPose-Struktur: Geglättete bzw. vorhergesagte Pose eines verfolgten Markers*/
+struct TrackedPose {
+
+	int id = 0;
+
+	// Geglätteter Rotationsvektor (Rodrigues) und Translationsvektor in Metern
+	cv::Vec3d rotationVector;
+	cv::Vec3d translationVector;
+
+	// Geschwindigkeit der Pose in rad/s bzw. m/s (0 ohne Filter), damit die Pose über den Aufnahmezeitpunkt hinaus
+	// fortgeschrieben werden kann
+	cv::Vec3d rotationVelocity;
+	cv::Vec3d translationVelocity;
+
+	// Index des Markers in der Eingabe von track(), -1 wenn der Marker in diesem Bild nicht erkannt und seine Pose nur
+	// vorhergesagt wurde
+	int measurementIndex = -1;
+};
+
+/* PoseTracker-Klasse: Verfolgt die Pose jedes Markers über die Bilder hinweg (Spur pro Marker-ID).
+   Die Pose eines bekannten Markers wird iterativ (solvePnP() mit useExtrinsicGuess) ausgehend von der Vorhersage
+   seiner Spur gelöst, so dass wenige Iterationen genügen und die Lösung nicht zwischen den beiden Mehrdeutigkeiten
+   eines ebenen Quadrats springt. Nur neue Marker werden ohne Startwert gelöst (SOLVEPNP_IPPE_SQUARE).
+   Für entzerrte Ecken (ohne Verzeichnungskoeffizienten, der Weg der Pipeline) laufen beide Verfahren und die
+   Rückprojektion als eigene Umsetzung mit Matx, weil solvePnP() und projectPoints() bei jedem Aufruf Matrizen auf dem
+   Heap anlegen. Mit Verzeichnungskoeffizienten wird solvePnP() selbst aufgerufen.
+   Über jede Spur läuft ein Kalman-Filter mit konstanter Geschwindigkeit, der das Zittern der Einzelmessungen glättet
+   und die Pose für Bilder vorhersagt, in denen der Marker nicht erkannt wurde (höchstens maxPredictionTime lang)*/
+class PoseTracker {
+
+public:
+
+	// So lange (in Mikrosekunden) wird die Pose eines nicht mehr erkannten Markers noch vorhergesagt
+	static const long long maxPredictionTime = 250000;
+
+	/* PoseTracker()-Konstruktor
+			- @param markerLength: Kantenlänge der Marker in Metern*/
+	explicit PoseTracker(float markerLength);
+
+	/* track()-Funktion: Löst die Pose der erkannten Marker und aktualisiert ihre Spuren
+			- @param timestamp: Aufnahmezeitpunkt des Bildes in Mikrosekunden (monotone Uhr)
+			- @param ids: IDs der erkannten Marker
+			- @param corners: Die entzerrten Ecken der erkannten Marker (Nx4)
+			- @param cameraMatrix: Kameramatrix der entzerrten Ecken
+			- @param distanceCoefficients: Abstandskoeffizienten (leer für bereits entzerrte Ecken)
+			- @param rotationVectors: Ausgabe der gemessenen (ungeglätteten) Rotationsvektoren, einer pro erkanntem Marker
+			- @param translationVectors: Ausgabe der gemessenen Translationsvektoren, einer pro erkanntem Marker
+			- @param poses: Ausgabe der geglätteten Posen der erkannten Marker (in der Reihenfolge von ids), gefolgt von
+							den vorhergesagten Posen der zur Zeit nicht erkannten Marker*/
+	void track(long long timestamp, const std::vector<int>& ids, const std::vector<std::vector<cv::Point2f>>& corners,
+		const cv::Mat& cameraMatrix, const cv::Mat& distanceCoefficients, std::vector<cv::Vec3d>& rotationVectors,
+		std::vector<cv::Vec3d>& translationVectors, std::vector<TrackedPose>& poses);
+
+	/* predict()-Funktion: Sagt die Posen aller Spuren für ein Bild ohne Erkennung vorher, die Spuren bleiben unverändert
+			- @param timestamp: Zeitpunkt der Vorhersage in Mikrosekunden (monotone Uhr)
+			- @param poses: Ausgabe der vorhergesagten Posen*/
+	void predict(long long timestamp, std::vector<TrackedPose>& poses) const;
+
+	/* hold()-Funktion: Die Szene hat sich seit dem letzten track() nicht verändert. Die dort gemessenen Marker bleiben mit
+	   Geschwindigkeit 0 stehen und ihre Spuren gelten als zum Zeitpunkt timestamp gemessen, damit sie auch nach langer
+	   Ruhe nicht verworfen werden
+			- @param timestamp: Aufnahmezeitpunkt des unveränderten Bildes in Mikrosekunden*/
+	void hold(long long timestamp);
+
+	/* setFiltering()-Funktion: Schaltet Filter und Vorhersage ein oder aus. Ohne Filter wird jede Pose wie bei
+	   estimatePoseSingleMarkers() einzeln und ohne Startwert gelöst
+			- @param enabled: True für Warmstart, Glättung und Vorhersage*/
+	void setFiltering(bool enabled);
+
+	/* reset()-Funktion: Vergisst alle Spuren, z.B. nach einer neuen Kalibrierung*/
+	void reset();
+
+	/* projectMarker()-Funktion: Projiziert die Ecken eines Markers mit einer Pose ins Bild, wie projectPoints() mit den
+	   Eckpunkten in der Reihenfolge der erkannten Ecken, aber ohne Allokation (nur Modelle mit geneigtem Sensor, also 14
+	   Verzeichnungskoeffizienten, und Matrizen anderer Typen als CV_64F gehen über projectPoints())
+			- @param rotationVector: Rotationsvektor der Pose
+			- @param translationVector: Translationsvektor der Pose in Metern
+			- @param cameraMatrix: 3x3-Kameramatrix
+			- @param distanceCoefficients: Verzeichnungskoeffizienten (leer für entzerrte Ecken)
+			- @param corners: Ausgabe der 4 Ecken in Pixeln*/
+	void projectMarker(const cv::Vec3d& rotationVector, const cv::Vec3d& translationVector, const cv::Mat& cameraMatrix,
+		const cv::Mat& distanceCoefficients, std::vector<cv::Point2f>& corners) const;
+
+private:
+
+	// Kalman-Filter mit konstanter Geschwindigkeit für eine Komponente der Pose (Wert und Geschwindigkeit). Die sechs
+	// Komponenten werden als unabhängig angenommen, so dass sechs 2x2-Filter genau dem 12x12-Filter entsprechen,
+	// aber ohne Matrizen auskommen
+	struct AxisFilter {
+
+		double value = 0.0, velocity = 0.0;
+
+		// Kovarianz [[p00, p01], [p01, p11]]
+		double p00 = 0.0, p01 = 0.0, p11 = 0.0;
+
+		void initialize(double measurement, double measurementVariance);
+		void predict(double dt, double accelerationVariance);
+		void correct(double measurement, double measurementVariance);
+		double extrapolate(double dt) const;
+	};
+
+	struct Track {
+
+		int id = 0;
+
+		// Zeitpunkt der letzten Messung, auf den sich der Zustand der Filter bezieht
+		long long timestamp = 0;
+		AxisFilter axes[6];
+	};
+
+	Track* findTrack(int id);
+	void startTrack(Track& track, int id, long long timestamp, const cv::Vec3d& rVec, const cv::Vec3d& tVec);
+	void trackPose(const Track& track, long long timestamp, TrackedPose& pose) const;
+	bool solveSquare(const std::vector<cv::Point2f>& corners, const cv::Matx33d& camera, cv::Vec3d& rVec,
+		cv::Vec3d& tVec) const;
+	bool refinePose(const std::vector<cv::Point2f>& corners, const cv::Matx33d& camera, cv::Vec3d& rVec,
+		cv::Vec3d& tVec) const;
+	double reprojectionError(const std::vector<cv::Point2f>& corners, const cv::Matx33d& camera,
+		const cv::Matx33d& rotation, const cv::Vec3d& tVec) const;
+
+	// Eckpunkte des Markers im Markerkoordinatensystem (wie bei estimatePoseSingleMarkers()), als Matrix für
+	// solvePnP() und als Vektoren für die eigene Umsetzung
+	cv::Mat objectPoints;
+	cv::Vec3d objectCorners[4];
+	bool filtering;
+
+	// Zeitpunkt des letzten track() bzw. hold()
+	long long lastTimestamp;
+	std::vector<Track> tracks;
+};
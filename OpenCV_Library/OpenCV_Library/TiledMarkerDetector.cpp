@@ -0,0 +1,237 @@
+#include "TiledMarkerDetector.h"
+#include <algorithm>
+#include <cmath>
+#include <cfloat>
+
+using namespace std;
+using namespace cv;
+
+
+// Schritt zwischen zwei Kacheln in Vielfachen der Überlappung. Jede Kachel ist Schritt + Überlappung groß, jeder Pixel
+// wird also im Mittel (1 + 1/tileStrideOverlaps)² mal durchsucht
+static const int tileStrideOverlaps = 3;
+
+// Zwei Marker mit derselben ID, deren Ecken alle höchstens so weit (in Pixeln) auseinander liegen, sind derselbe Marker
+static const float duplicateCornerDistance = 1.0f;
+
+
+TiledMarkerDetector::TiledMarkerDetector()
+	: tileCount(0), borderMargin(0) {
+}
+
+
+void TiledMarkerDetector::setDictionary(const Ptr<aruco::Dictionary>& dictionary) {
+
+	this->dictionary = dictionary;
+
+	for (unique_ptr<Tile>& tile : tiles) {
+
+		tile->fastDetector.setDictionary(dictionary);
+	}
+}
+
+
+int TiledMarkerDetector::getTileCount() const {
+
+	return tileCount;
+}
+
+
+bool TiledMarkerDetector::detect(const Mat& image, const aruco::DetectorParameters& parameters, int maxMarkerSize,
+	bool fastSearch, vector<vector<Point2f>>& corners, vector<int>& ids, CornerPool& cornerPool) {
+
+	// Umfeld eines Markers, das in seiner Kachel liegen muss: Fenster des Schwellwerts bzw. der Eckenverfeinerung und
+	// der Abstand, den detectMarkers() zum Bildrand verlangt
+	borderMargin = max(parameters.minDistanceToBorder, 0) +
+		max(parameters.adaptiveThreshWinSizeMax / 2, parameters.cornerRefinementWinSize) + 1;
+
+	// Ein gedrehter Marker braucht entlang der Bildachsen bis zur Länge seiner Diagonale
+	const int markerExtent = cvCeil(sqrt(2.0) * max(maxMarkerSize, 1));
+
+	buildTiles(image.size(), markerExtent + 2 * borderMargin + 1);
+
+	if (tileCount < 2) {
+
+		tileCount = 0;
+		return false;
+	}
+
+	// Ein Teilbereich pro Kachel, damit freie Threads sich die nächste offene Kachel nehmen, auch wenn einzelne Kacheln
+	// (viele Kandidaten) länger brauchen. Die Fenstergrößen innerhalb einer Kachel laufen dann im Thread der Kachel.
+	// Die Argumente gehen gesammelt über einen Zeiger, damit das Lambda ohne Allokation in std::function passt
+	const TileJob job = { &image, &parameters, fastSearch };
+
+	parallel_for_(Range(0, tileCount), [this, &job](const Range& range) {
+
+		for (int t = range.start; t < range.end; ++t) {
+
+			detectTile(*job.image, *job.parameters, job.fastSearch, *tiles[t]);
+		}
+	}, tileCount);
+
+	cornerPool.resize(corners, 0);
+	ids.clear();
+
+	// Zusammenführen in der Reihenfolge der Kacheln, damit das Ergebnis nicht von der Verteilung auf Threads abhängt
+	for (int t = 0; t < tileCount; ++t) {
+
+		const Tile& tile = *tiles[t];
+		const Point2f offset((float)tile.rect.x, (float)tile.rect.y);
+
+		for (size_t i = 0; i < tile.ids.size(); ++i) {
+
+			if (!isOwnedByTile(tile, tile.corners[i])) {
+
+				continue;
+			}
+
+			vector<Point2f>& markerCorners = cornerPool.append(corners);
+
+			for (int c = 0; c < 4; ++c) {
+
+				markerCorners[c] = tile.corners[i][c] + offset;
+			}
+
+			if (isDuplicate(corners, ids, markerCorners, tile.ids[i])) {
+
+				cornerPool.resize(corners, corners.size() - 1);
+				continue;
+			}
+
+			ids.push_back(tile.ids[i]);
+		}
+	}
+
+	return true;
+}
+
+
+/* buildTiles()-Funktion: Teilt das Bild gleichmäßig in Kacheln auf. Neue Kacheln (mit eigenem Detektor) werden nur
+   angelegt, wenn mehr als bisher gebraucht werden
+		- @param imageSize: Bildgröße
+		- @param overlap: Überlappung zweier benachbarter Kacheln in Pixeln*/
+void TiledMarkerDetector::buildTiles(const Size& imageSize, int overlap) {
+
+	this->imageSize = imageSize;
+
+	const int targetStride = tileStrideOverlaps * overlap;
+	const int columns = max(1, cvCeil((imageSize.width - overlap) / (double)targetStride));
+	const int rows = max(1, cvCeil((imageSize.height - overlap) / (double)targetStride));
+
+	// Der Schritt wird so verkleinert, dass die letzte Kachel genau am Bildrand endet
+	const int strideX = max(1, cvCeil((imageSize.width - overlap) / (double)columns));
+	const int strideY = max(1, cvCeil((imageSize.height - overlap) / (double)rows));
+	const Rect imageRect(0, 0, imageSize.width, imageSize.height);
+
+	tileCount = columns * rows;
+
+	while ((int)tiles.size() < tileCount) {
+
+		tiles.emplace_back(new Tile());
+		tiles.back()->parameters = aruco::DetectorParameters::create();
+		tiles.back()->fastDetector.setDictionary(dictionary);
+		tiles.back()->cornerPool.reserve(16);
+	}
+
+	for (int row = 0; row < rows; ++row) {
+
+		for (int column = 0; column < columns; ++column) {
+
+			tiles[row * columns + column]->rect = Rect(column * strideX, row * strideY, strideX + overlap,
+				strideY + overlap) & imageRect;
+		}
+	}
+}
+
+
+/* detectTile()-Funktion: Erkennt die Marker einer Kachel. Die Umfangsgrenzen beziehen sich in detectMarkers() auf die
+   größere Bildseite, sie werden so umgerechnet, dass in der Kachel dieselben Grenzen in Pixeln gelten wie im ganzen
+   Bild
+		- @param image: Ganzes Eingabebild
+		- @param parameters: Parameter für das ganze Bild
+		- @param fastSearch: True = FastMarkerDetector, false = aruco::detectMarkers()
+		- @param tile: Kachel, Ausgabe in ihren Koordinaten*/
+void TiledMarkerDetector::detectTile(const Mat& image, const aruco::DetectorParameters& parameters, bool fastSearch,
+	Tile& tile) {
+
+	const Mat tileImage = image(tile.rect);
+	const double imageDimension = max(imageSize.width, imageSize.height);
+	const double tileDimension = max(tile.rect.width, tile.rect.height);
+
+	// detectMarkers() schneidet den Umfang in Pixeln ab, ein halber Pixel Reserve hält das Abschneiden stabil
+	*tile.parameters = parameters;
+	tile.parameters->minMarkerPerimeterRate =
+		(floor(parameters.minMarkerPerimeterRate * imageDimension) + 0.5) / tileDimension;
+	tile.parameters->maxMarkerPerimeterRate =
+		(floor(parameters.maxMarkerPerimeterRate * imageDimension) + 0.5) / tileDimension;
+
+	if (fastSearch) {
+
+		tile.fastDetector.detect(tileImage, *tile.parameters, tile.corners, tile.ids, tile.cornerPool);
+	}
+	else {
+
+		aruco::detectMarkers(tileImage, dictionary, tile.corners, tile.ids, tile.parameters);
+	}
+}
+
+
+/* isOwnedByTile()-Funktion: Prüft, ob ein Marker mit vollem Umfeld in der Kachel liegt. Marker nahe einer inneren
+   Kachelkante wurden eventuell nur angeschnitten erkannt, sie liegen vollständig in einer Nachbarkachel
+		- @param tile: Kachel
+		- @param markerCorners: Ecken des Markers in Koordinaten der Kachel
+		- @param return: True, wenn der Marker aus dieser Kachel übernommen wird*/
+bool TiledMarkerDetector::isOwnedByTile(const Tile& tile, const vector<Point2f>& markerCorners) const {
+
+	// Kanten am Bildrand sind keine inneren Kanten, dort gilt dasselbe wie im ganzen Bild
+	const float left = tile.rect.x > 0 ? (float)borderMargin : -FLT_MAX;
+	const float top = tile.rect.y > 0 ? (float)borderMargin : -FLT_MAX;
+	const float right = tile.rect.br().x < imageSize.width ? (float)(tile.rect.width - borderMargin) : FLT_MAX;
+	const float bottom = tile.rect.br().y < imageSize.height ? (float)(tile.rect.height - borderMargin) : FLT_MAX;
+
+	for (const Point2f& corner : markerCorners) {
+
+		if (corner.x < left || corner.y < top || corner.x >= right || corner.y >= bottom) {
+
+			return false;
+		}
+	}
+
+	return true;
+}
+
+
+/* isDuplicate()-Funktion: Prüft, ob ein Marker in der Überlappung schon aus einer anderen Kachel übernommen wurde
+		- @param corners: Bisher übernommene Ecken (der geprüfte Marker ist der letzte Eintrag und wird übergangen)
+		- @param ids: IDs der bisher übernommenen Marker
+		- @param markerCorners: Ecken des geprüften Markers in Bildkoordinaten
+		- @param id: ID des geprüften Markers
+		- @param return: True, wenn derselbe Marker schon übernommen wurde*/
+bool TiledMarkerDetector::isDuplicate(const vector<vector<Point2f>>& corners, const vector<int>& ids,
+	const vector<Point2f>& markerCorners, int id) const {
+
+	const float maxDistanceSquared = duplicateCornerDistance * duplicateCornerDistance;
+
+	for (size_t i = 0; i < ids.size(); ++i) {
+
+		if (ids[i] != id) {
+
+			continue;
+		}
+
+		bool same = true;
+
+		for (int c = 0; c < 4 && same; ++c) {
+
+			const Point2f difference = corners[i][c] - markerCorners[c];
+			same = difference.dot(difference) <= maxDistanceSquared;
+		}
+
+		if (same) {
+
+			return true;
+		}
+	}
+
+	return false;
+}
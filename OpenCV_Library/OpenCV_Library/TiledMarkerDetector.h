@@ -0,0 +1,84 @@
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <opencv2/core.hpp>
+#include <opencv2/aruco.hpp>
+#include "FastMarkerDetector.h"
+#include "Workspace.h"
+
+/* TiledMarkerDetector-Klasse: Markererkennung in großen Bildern (z.B. 4K), aufgeteilt in sich überlappende Kacheln, die
+   parallel durchsucht werden. detectMarkers() und FastMarkerDetector nutzen nur für die Fenstergrößen des Schwellwerts
+   mehrere Threads, Konturen und Identifikation laufen über das ganze Bild in einem Thread.
+   Die Überlappung zweier Kacheln ist so groß wie die Diagonale des größten erwarteten Markers (ein um 45° gedrehter
+   Marker ist entlang der Bildachsen sqrt(2) mal so breit wie seine Seite) plus der Rand, den Schwellwert,
+   Eckenverfeinerung und minDistanceToBorder um einen Marker brauchen. Damit liegt jeder Marker bis zu dieser Größe in
+   jeder Drehung in mindestens einer Kachel mit demselben Umfeld wie im ganzen Bild und wird dort genauso erkannt. Marker, die einer
+   inneren Kachelkante näher als dieser Rand kommen, werden verworfen (sie sind in einer Nachbarkachel vollständig),
+   doppelt gefundene Marker in der Überlappung werden über ID und Abstand der Ecken zusammengefasst. Größere Marker
+   können übersehen werden.
+   Jede Kachel hat ihren eigenen Detektor mit eigenen Puffern, nach dem Aufwärmen allokiert detect() selbst nichts
+   mehr*/
+class TiledMarkerDetector {
+
+public:
+
+	TiledMarkerDetector();
+
+	void setDictionary(const cv::Ptr<cv::aruco::Dictionary>& dictionary);
+
+	/* detect()-Funktion: Erkennt die Marker kachelweise. Passt das Bild in eine einzige Kachel, wird nichts erkannt und
+	   false zurückgegeben, der Aufrufer erkennt dann wie gewohnt über das ganze Bild
+			- @param image: Eingabebild (BGR oder Graustufen)
+			- @param parameters: Parameter wie für das ganze Bild, die Umfangsgrenzen werden auf jede Kachel umgerechnet
+			- @param maxMarkerSize: Größte erwartete Seite eines Markers im Bild in Pixeln (die Drehung wird eingerechnet)
+			- @param fastSearch: True = FastMarkerDetector, false = aruco::detectMarkers() in jeder Kachel
+			- @param corners: Ausgabe der erkannten Markerecken in Koordinaten von image (Reihenfolge nach Kacheln)
+			- @param ids: Ausgabe der erkannten Marker-IDs
+			- @param cornerPool: Pool, über den corners immer verkleinert und vergrößert wird
+			- @param return: True, wenn in Kacheln erkannt wurde*/
+	bool detect(const cv::Mat& image, const cv::aruco::DetectorParameters& parameters, int maxMarkerSize,
+		bool fastSearch, std::vector<std::vector<cv::Point2f>>& corners, std::vector<int>& ids, CornerPool& cornerPool);
+
+	/* getTileCount()-Funktion: Anzahl der Kacheln der letzten Erkennung
+			- @param return: Anzahl der Kacheln, 0 wenn zuletzt nicht in Kacheln erkannt wurde*/
+	int getTileCount() const;
+
+private:
+
+	// Eine Kachel mit eigenem Detektor, eigenen Parametern und eigener Ausgabe, damit die Kacheln ohne Sperren parallel
+	// laufen können
+	struct Tile {
+
+		cv::Rect rect;
+		FastMarkerDetector fastDetector;
+		cv::Ptr<cv::aruco::DetectorParameters> parameters;
+		std::vector<std::vector<cv::Point2f>> corners;
+		std::vector<int> ids;
+		CornerPool cornerPool;
+	};
+
+	// Argumente von detect() für die parallel laufenden Kacheln
+	struct TileJob {
+
+		const cv::Mat* image;
+		const cv::aruco::DetectorParameters* parameters;
+		bool fastSearch;
+	};
+
+	void buildTiles(const cv::Size& imageSize, int overlap);
+	void detectTile(const cv::Mat& image, const cv::aruco::DetectorParameters& parameters, bool fastSearch, Tile& tile);
+	bool isOwnedByTile(const Tile& tile, const std::vector<cv::Point2f>& markerCorners) const;
+	bool isDuplicate(const std::vector<std::vector<cv::Point2f>>& corners, const std::vector<int>& ids,
+		const std::vector<cv::Point2f>& markerCorners, int id) const;
+
+	cv::Ptr<cv::aruco::Dictionary> dictionary;
+
+	// Kacheln bleiben über die Bilder erhalten, nur die ersten tileCount werden verwendet
+	std::vector<std::unique_ptr<Tile>> tiles;
+	int tileCount;
+
+	// Bildgröße der aktuellen Aufteilung und Abstand, den ein Marker zu inneren Kachelkanten halten muss
+	cv::Size imageSize;
+	int borderMargin;
+};
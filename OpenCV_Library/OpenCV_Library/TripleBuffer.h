@@ -0,0 +1,68 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+/* TripleBuffer-Klasse: Lock-freier Dreifachpuffer für genau einen Schreiber (Detektions-Thread) und genau einen
+   Leser (Unity-Thread). Der Schreiber füllt immer den Back-Puffer und tauscht ihn mit publish() gegen den mittleren
+   Puffer aus. Der Leser holt sich mit update() den mittleren Puffer als Front-Puffer, falls dort ein neues Ergebnis
+   liegt. Keiner der beiden Threads wartet jemals auf den anderen, es gibt nur einen atomaren Austausch pro Seite.
+		- @param T: Typ des Ergebnisses, das zwischen den Threads übergeben wird*/
+template<typename T>
+class TripleBuffer {
+
+public:
+
+	TripleBuffer() : back(0), middle(1), front(2) {}
+
+	/* writeBuffer()-Funktion: Puffer, in den der Schreiber das nächste Ergebnis schreibt
+			- @param return: Referenz auf den Back-Puffer (gehört exklusiv dem Schreiber)*/
+	T& writeBuffer() {
+
+		return buffers[back];
+	}
+
+	/* publish()-Funktion: Veröffentlicht den Back-Puffer als neuestes Ergebnis. Der Schreiber bekommt dafür den
+	   bisherigen mittleren Puffer als neuen Back-Puffer zurück
+			- @param return: True, wenn dabei ein Ergebnis verworfen wurde, das der Leser nie abgeholt hat*/
+	bool publish() {
+
+		uint8_t previous = middle.exchange(static_cast<uint8_t>(back | newDataFlag), std::memory_order_acq_rel);
+		back = previous & indexMask;
+
+		return (previous & newDataFlag) != 0;
+	}
+
+	/* update()-Funktion: Übernimmt das neueste veröffentlichte Ergebnis als Front-Puffer
+			- @param return: True, wenn seit dem letzten Aufruf ein neues Ergebnis vorlag, ansonsten false*/
+	bool update() {
+
+		if ((middle.load(std::memory_order_relaxed) & newDataFlag) == 0) {
+
+			return false;
+		}
+
+		front = middle.exchange(front, std::memory_order_acq_rel) & indexMask;
+		return true;
+	}
+
+	/* readBuffer()-Funktion: Zuletzt mit update() übernommenes Ergebnis
+			- @param return: Referenz auf den Front-Puffer (gehört exklusiv dem Leser)*/
+	const T& readBuffer() const {
+
+		return buffers[front];
+	}
+
+private:
+
+	static const uint8_t indexMask = 0x03;
+	static const uint8_t newDataFlag = 0x04;
+
+	T buffers[3];
+
+	// Index des Back-Puffers (nur Schreiber), des mittleren Puffers inkl. Flag (beide) und des Front-Puffers (nur Leser).
+	// Die Indizes liegen auf getrennten Cache-Lines, damit sich Schreiber und Leser nicht gegenseitig ausbremsen
+	alignas(64) uint8_t back;
+	alignas(64) std::atomic<uint8_t> middle;
+	alignas(64) uint8_t front;
+};
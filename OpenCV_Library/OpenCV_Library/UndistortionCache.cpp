@@ -0,0 +1,140 @@
+#include "UndistortionCache.h"
+#include <algorithm>
+#include <opencv2/calib3d.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+UndistortionCache::UndistortionCache()
+	: calibrationVersion(-1), identity(true), tableColumns(0), tableRows(0) {
+}
+
+
+bool UndistortionCache::update(const Mat& cameraMatrix, const Mat& distanceCoefficients, int calibrationVersion,
+	const Size& imageSize) {
+
+	if (this->calibrationVersion == calibrationVersion && this->imageSize == imageSize) {
+
+		return false;
+	}
+
+	this->calibrationVersion = calibrationVersion;
+	this->imageSize = imageSize;
+
+	cameraMatrix.convertTo(this->cameraMatrix, CV_64F);
+	distanceCoefficients.convertTo(this->distanceCoefficients, CV_64F);
+
+	// Neue Puffer statt Überschreiben, falls die Debug-Anzeige die alten Karten noch verwendet
+	rectificationMap1 = Mat();
+	rectificationMap2 = Mat();
+
+	// Ohne Verzeichnung (z.B. vor dem Laden einer Kalibrierung) gibt es nichts zu entzerren
+	identity = true;
+
+	for (size_t i = 0; i < this->distanceCoefficients.total(); ++i) {
+
+		if (this->distanceCoefficients.ptr<double>()[i] != 0.0) {
+
+			identity = false;
+		}
+	}
+
+	if (identity || imageSize.area() <= 0) {
+
+		table.clear();
+		tableColumns = tableRows = 0;
+		return true;
+	}
+
+	// Das Gitter reicht mindestens bis zum letzten Pixel, damit jede Ecke im Bild zwischen vier Gitterpunkten liegt
+	tableColumns = (imageSize.width - 1) / tableStep + 2;
+	tableRows = (imageSize.height - 1) / tableStep + 2;
+
+	vector<Point2f> gridPoints(tableColumns * tableRows);
+
+	for (int r = 0; r < tableRows; ++r) {
+
+		for (int c = 0; c < tableColumns; ++c) {
+
+			gridPoints[r * tableColumns + c] = Point2f((float)(c * tableStep), (float)(r * tableStep));
+		}
+	}
+
+	// Einmal für alle Gitterpunkte mit mehr Iterationen als bei undistortPoints() üblich, damit auch starke
+	// Verzeichnung am Bildrand genau invertiert wird
+	undistortPoints(gridPoints, table, this->cameraMatrix, this->distanceCoefficients, noArray(), this->cameraMatrix,
+		TermCriteria(TermCriteria::COUNT | TermCriteria::EPS, 20, 1e-6));
+
+	return true;
+}
+
+
+/* lookup()-Funktion: Bilineare Interpolation zwischen den vier umgebenden Gitterpunkten
+		- @param point: Ecke im aufgenommenen Bild
+		- @param return: Entzerrte Ecke*/
+Point2f UndistortionCache::lookup(const Point2f& point) const {
+
+	float x = min(max(point.x / tableStep, 0.f), tableColumns - 1.001f);
+	float y = min(max(point.y / tableStep, 0.f), tableRows - 1.001f);
+
+	int column = (int)x;
+	int row = (int)y;
+	float weightX = x - column;
+	float weightY = y - row;
+
+	const Point2f* top = &table[row * tableColumns + column];
+	const Point2f* bottom = top + tableColumns;
+
+	return (top[0] * (1.f - weightX) + top[1] * weightX) * (1.f - weightY) +
+		(bottom[0] * (1.f - weightX) + bottom[1] * weightX) * weightY;
+}
+
+
+void UndistortionCache::undistortCorners(const vector<vector<Point2f>>& corners,
+	vector<vector<Point2f>>& undistorted, CornerPool& pool) const {
+
+	pool.resize(undistorted, corners.size());
+
+	for (size_t i = 0; i < corners.size(); ++i) {
+
+		undistorted[i].resize(corners[i].size());
+
+		for (size_t c = 0; c < corners[i].size(); ++c) {
+
+			undistorted[i][c] = identity ? corners[i][c] : lookup(corners[i][c]);
+		}
+	}
+}
+
+
+const Mat& UndistortionCache::idealCameraMatrix() const {
+
+	return cameraMatrix;
+}
+
+
+const Mat& UndistortionCache::noDistortion() const {
+
+	return emptyDistortion;
+}
+
+
+bool UndistortionCache::rectificationMaps(Mat& map1, Mat& map2) {
+
+	if (identity || imageSize.area() <= 0) {
+
+		return false;
+	}
+
+	if (rectificationMap1.empty()) {
+
+		initUndistortRectifyMap(cameraMatrix, distanceCoefficients, noArray(), cameraMatrix, imageSize, CV_16SC2,
+			rectificationMap1, rectificationMap2);
+	}
+
+	map1 = rectificationMap1;
+	map2 = rectificationMap2;
+
+	return true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+#include "Workspace.h"
+
+/* UndistortionCache-Klasse: Aus der Kalibrierung abgeleitete Tabellen, damit die Verzeichnung nicht bei jedem Bild
+   für jede Markerecke neu gerechnet werden muss. Eine Tabelle enthält für ein Gitter (alle tableStep Pixel) die
+   entzerrten Pixelkoordinaten, Ecken dazwischen werden bilinear interpoliert. Die Posenschätzung arbeitet dann mit den
+   entzerrten Ecken, der Kameramatrix und ohne Verzeichnungskoeffizienten (idealCameraMatrix(), noDistortion()).
+   Die dichten Karten für ein entzerrtes Bild (remap) werden nur für die Debug-Anzeige und erst bei Bedarf angelegt.
+   Alles wird neu berechnet, sobald sich Kalibrierung oder Bildgröße ändern. Gehört genau einem Thread (der Pipeline)*/
+class UndistortionCache {
+
+public:
+
+	// Abstand der Gitterpunkte der Tabelle in Pixeln
+	static const int tableStep = 4;
+
+	UndistortionCache();
+
+	/* update()-Funktion: Prüft, ob die Tabelle noch zur Kalibrierung und Bildgröße passt, und baut sie sonst neu.
+	   Ohne Änderung kostet der Aufruf nur zwei Vergleiche
+			- @param cameraMatrix: 3x3-Kameramatrix
+			- @param distanceCoefficients: Verzeichnungskoeffizienten (leer = keine Verzeichnung)
+			- @param calibrationVersion: Version der Kalibrierung (ändert sich bei jedem Laden)
+			- @param imageSize: Größe der Bilder, auf denen die Ecken erkannt werden
+			- @param return: True, wenn die Tabelle neu gebaut wurde*/
+	bool update(const cv::Mat& cameraMatrix, const cv::Mat& distanceCoefficients, int calibrationVersion,
+		const cv::Size& imageSize);
+
+	/* undistortCorners()-Funktion: Entzerrt die Ecken aller Marker über die Tabelle
+			- @param corners: Erkannte Ecken im aufgenommenen Bild
+			- @param undistorted: Entzerrte Ecken in Pixeln (Puffer wird wiederverwendet)
+			- @param pool: Pool, über den undistorted immer verkleinert und vergrößert wird*/
+	void undistortCorners(const std::vector<std::vector<cv::Point2f>>& corners,
+		std::vector<std::vector<cv::Point2f>>& undistorted, CornerPool& pool) const;
+
+	// Kameramatrix und (leere) Verzeichnungskoeffizienten für die entzerrten Ecken
+	const cv::Mat& idealCameraMatrix() const;
+	const cv::Mat& noDistortion() const;
+
+	/* rectificationMaps()-Funktion: Dichte Karten für remap(), die das ganze Bild entzerren. Werden beim ersten Aufruf
+	   nach einer Änderung angelegt. Die Puffer werden danach nie mehr beschrieben, sondern bei einer Änderung ersetzt,
+	   so dass ein anderer Thread sie gefahrlos weiterverwenden kann
+			- @param map1: Erste Karte (CV_16SC2)
+			- @param map2: Zweite Karte (CV_16UC1)
+			- @param return: False, wenn es nichts zu entzerren gibt (noch keine Bilder oder keine Verzeichnung)*/
+	bool rectificationMaps(cv::Mat& map1, cv::Mat& map2);
+
+private:
+
+	cv::Point2f lookup(const cv::Point2f& point) const;
+
+	int calibrationVersion;
+	cv::Size imageSize;
+
+	// Keine Verzeichnung: Ecken werden unverändert übernommen
+	bool identity;
+
+	cv::Mat cameraMatrix, distanceCoefficients, emptyDistortion;
+
+	// Entzerrte Pixelkoordinaten der Gitterpunkte, zeilenweise (tableColumns x tableRows)
+	std::vector<cv::Point2f> table;
+	int tableColumns, tableRows;
+
+	cv::Mat rectificationMap1, rectificationMap2;
+};
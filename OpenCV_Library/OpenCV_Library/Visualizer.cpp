@@ -0,0 +1,192 @@
+#include "Visualizer.h"
+#include <opencv2/aruco.hpp>
+#include <opencv2/imgproc.hpp>
+#include <opencv2/highgui.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+Visualizer::Visualizer(const string& windowName, double maxFramesPerSecond)
+	: windowName(windowName),
+	  minimumInterval(chrono::duration_cast<chrono::steady_clock::duration>(chrono::duration<double>(1.0 / maxFramesPerSecond))),
+	  hasPending(false), stats(nullptr), running(false), pressedKey(-1) {
+}
+
+
+Visualizer::~Visualizer() {
+
+	stop();
+}
+
+
+/* start()-Funktion: Startet den Anzeige-Thread*/
+void Visualizer::start() {
+
+	if (running.load()) {
+
+		return;
+	}
+
+	running.store(true);
+	renderThread = thread(&Visualizer::renderLoop, this);
+}
+
+
+/* stop()-Funktion: Beendet den Anzeige-Thread und schließt das Fenster*/
+void Visualizer::stop() {
+
+	{
+		lock_guard<mutex> lock(pendingMutex);
+		running.store(false);
+	}
+
+	pendingCondition.notify_one();
+
+	if (renderThread.joinable()) {
+
+		renderThread.join();
+	}
+}
+
+
+void Visualizer::setStats(PipelineStats* stats) {
+
+	this->stats = stats;
+}
+
+
+bool Visualizer::isDue() const {
+
+	return running.load(memory_order_relaxed) && chrono::steady_clock::now() - lastSubmission >= minimumInterval;
+}
+
+
+void Visualizer::submit(const Mat& frame, const vector<int>& ids, const vector<vector<Point2f>>& corners,
+	const vector<Vec3d>& rVecs, const vector<Vec3d>& tVecs, const Mat& cameraMatrix, const Mat& distanceCoefficients,
+	const Mat& rectificationMap1, const Mat& rectificationMap2) {
+
+	if (!isDue()) {
+
+		return;
+	}
+
+	lastSubmission = chrono::steady_clock::now();
+
+	{
+		// Kopien anlegen, da der Aufrufer seine Puffer beim nächsten Bild überschreibt
+		lock_guard<mutex> lock(pendingMutex);
+
+		frame.copyTo(pendingFrame);
+		cameraMatrix.copyTo(pendingCameraMatrix);
+		distanceCoefficients.copyTo(pendingDistanceCoefficients);
+		pendingIds = ids;
+		pendingCorners = corners;
+		pendingRotationVectors = rVecs;
+		pendingTranslationVectors = tVecs;
+		pendingRectificationMap1 = rectificationMap1;
+		pendingRectificationMap2 = rectificationMap2;
+		hasPending = true;
+	}
+
+	pendingCondition.notify_one();
+}
+
+
+int Visualizer::lastKey() const {
+
+	return pressedKey.load(memory_order_relaxed);
+}
+
+
+/* renderLoop()-Funktion: Schleife des Anzeige-Threads. Zeichnet das zuletzt übergebene Bild und zeigt es an.
+   namedWindow(), imshow() und waitKey() laufen alle in diesem Thread, damit HighGUI das Fenster aktualisieren kann*/
+void Visualizer::renderLoop() {
+
+	Mat renderFrame, renderCameraMatrix, renderDistanceCoefficients;
+	Mat renderRectificationMap1, renderRectificationMap2, rectifiedFrame;
+	vector<int> renderIds;
+	vector<vector<Point2f>> renderCorners;
+	vector<Vec3d> renderRotationVectors, renderTranslationVectors;
+
+	namedWindow(windowName, WINDOW_AUTOSIZE);
+
+	while (true) {
+
+		bool newFrame = false;
+
+		{
+			// Warten, bis ein neues Bild vorliegt. Das Timeout sorgt dafür, dass waitKey() das Fenster weiter bedient
+			unique_lock<mutex> lock(pendingMutex);
+			pendingCondition.wait_for(lock, chrono::milliseconds(30), [this] { return hasPending || !running.load(); });
+
+			if (!running.load()) {
+
+				break;
+			}
+
+			if (hasPending) {
+
+				// Puffer tauschen statt kopieren, der Detektions-Thread bekommt dafür die alten Puffer zurück
+				swap(renderFrame, pendingFrame);
+				swap(renderCameraMatrix, pendingCameraMatrix);
+				swap(renderDistanceCoefficients, pendingDistanceCoefficients);
+				swap(renderIds, pendingIds);
+				swap(renderCorners, pendingCorners);
+				swap(renderRotationVectors, pendingRotationVectors);
+				swap(renderTranslationVectors, pendingTranslationVectors);
+				swap(renderRectificationMap1, pendingRectificationMap1);
+				swap(renderRectificationMap2, pendingRectificationMap2);
+				hasPending = false;
+				newFrame = true;
+			}
+		}
+
+		if (newFrame) {
+
+			STATS_TIMESTAMP(renderStart);
+
+			// Entzerrte Ansicht: Das ganze Bild wird mit den vorberechneten Karten entzerrt
+			if (!renderRectificationMap1.empty() && renderRectificationMap1.size() == renderFrame.size()) {
+
+				remap(renderFrame, rectifiedFrame, renderRectificationMap1, renderRectificationMap2, INTER_LINEAR);
+				swap(renderFrame, rectifiedFrame);
+			}
+
+			// Wenn ein Marker erkannt worden ist, zeichne den erkannten Marker
+			if (!renderIds.empty()) {
+
+				/* drawDetectedMarkers()-Funktion: Zeichnet die erkannten Bilder im Bild (Webcam-frame)
+						- @param renderFrame: Kopie des Eingabebildes der Kamera
+						- @param renderCorners: Die erkannten Markerecken im Eingabebild. Für N erkannte Marker, sind die
+												Dimensionen des Arrays Nx4
+						- @param renderIds: Vektor von Bezeichnern für Marker (optional)*/
+				aruco::drawDetectedMarkers(renderFrame, renderCorners, renderIds);
+			}
+
+			for (size_t i = 0; i < renderIds.size(); ++i) {
+
+				/* drawAxis()-Funktion: Zeichnet die Achsen des Koordinatensystem aus der Posenschätzung
+						- @param 0.1f: Länge der gemalten Achsen, in der gleichen Einheit wit tVec (Normalerweise in Metern)*/
+				aruco::drawAxis(renderFrame, renderCameraMatrix, renderDistanceCoefficients, renderRotationVectors[i],
+					renderTranslationVectors[i], 0.1f);
+			}
+
+			imshow(windowName, renderFrame);
+
+			if (stats) {
+
+				STATS_RECORD(*stats, STAGE_RENDER, renderStart);
+			}
+		}
+
+		int key = waitKey(1);
+
+		if (key >= 0) {
+
+			pressedKey.store(key, memory_order_relaxed);
+		}
+	}
+
+	destroyWindow(windowName);
+}
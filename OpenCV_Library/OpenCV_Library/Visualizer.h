@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <opencv2/core.hpp>
+#include "PipelineStats.h"
+
+/* Visualizer-Klasse: Optionale Debug-Anzeige der erkannten Marker. Zeichnen (drawDetectedMarkers, drawAxis) und
+   imshow() laufen in einem eigenen Thread auf einer Kopie des Bildes, so dass die Erkennung nie darauf warten muss.
+   Es wird höchstens mit maxFramesPerSecond Bildern pro Sekunde kopiert und angezeigt, alle anderen Bilder werden
+   ohne Kosten übersprungen*/
+class Visualizer {
+
+public:
+
+	/* Visualizer()-Konstruktor
+			- @param windowName: Name des Fensters (z.B. "Webcam")
+			- @param maxFramesPerSecond: Maximale Anzeigerate*/
+	Visualizer(const std::string& windowName, double maxFramesPerSecond);
+	~Visualizer();
+
+	void start();
+	void stop();
+
+	/* setStats()-Funktion: Statistik, in die die Laufzeit von Zeichnen und imshow() eingetragen wird (vor start() aufrufen)
+			- @param stats: Statistik der Pipeline oder nullptr*/
+	void setStats(PipelineStats* stats);
+
+	/* isDue()-Funktion: Gibt an, ob laut Ratenbegrenzung ein neues Bild angezeigt werden soll. Kann vor dem Aufbereiten
+	   der Daten aufgerufen werden, um unnötige Arbeit zu vermeiden
+			- @param return: True, wenn submit() das nächste Bild übernehmen würde*/
+	bool isDue() const;
+
+	/* submit()-Funktion: Übergibt ein Bild mit den Erkennungsergebnissen. Ist die Ratenbegrenzung noch nicht
+	   abgelaufen, kehrt die Funktion sofort zurück, ansonsten wird das Bild kopiert und der Anzeige-Thread geweckt
+			- @param frame: Aufgenommenes Bild (wird nicht verändert)
+			- @param ids: Erkannte Marker-IDs
+			- @param corners: Erkannte Markerecken
+			- @param rVecs: Rotationsvektoren der Marker
+			- @param tVecs: Translationsvektoren der Marker
+			- @param cameraMatrix: Intrinsische Kameramatrix für drawAxis()
+			- @param distanceCoefficients: Abstandskoeffizienten für drawAxis()
+			- @param rectificationMap1, rectificationMap2: Optional, Karten für remap(), mit denen das Bild vor dem Zeichnen
+														   entzerrt wird (Ecken und Kalibrierung müssen dann ebenfalls
+														   entzerrt sein). Werden nicht kopiert und dürfen danach nicht
+														   mehr verändert werden*/
+	void submit(const cv::Mat& frame, const std::vector<int>& ids, const std::vector<std::vector<cv::Point2f>>& corners,
+		const std::vector<cv::Vec3d>& rVecs, const std::vector<cv::Vec3d>& tVecs, const cv::Mat& cameraMatrix,
+		const cv::Mat& distanceCoefficients, const cv::Mat& rectificationMap1 = cv::Mat(),
+		const cv::Mat& rectificationMap2 = cv::Mat());
+
+	/* lastKey()-Funktion: Zuletzt im Fenster gedrückte Taste (Rückgabe von waitKey())
+			- @param return: Tastencode oder -1, falls keine Taste gedrückt wurde*/
+	int lastKey() const;
+
+private:
+
+	void renderLoop();
+
+	std::string windowName;
+	std::chrono::steady_clock::duration minimumInterval;
+	std::chrono::steady_clock::time_point lastSubmission;
+
+	// Wartendes Bild mit Ergebnissen, geschützt durch pendingMutex
+	std::mutex pendingMutex;
+	std::condition_variable pendingCondition;
+	bool hasPending;
+	cv::Mat pendingFrame, pendingCameraMatrix, pendingDistanceCoefficients;
+	cv::Mat pendingRectificationMap1, pendingRectificationMap2;
+	std::vector<int> pendingIds;
+	std::vector<std::vector<cv::Point2f>> pendingCorners;
+	std::vector<cv::Vec3d> pendingRotationVectors, pendingTranslationVectors;
+
+	PipelineStats* stats;
+
+	std::thread renderThread;
+	std::atomic<bool> running;
+	std::atomic<int> pressedKey;
+};
@@ -0,0 +1,74 @@
+#include "Workspace.h"
+#include <algorithm>
+
+using namespace std;
+using namespace cv;
+
+
+Mat workspaceImage(Mat& buffer, const Size& size, int type) {
+
+	if (buffer.type() != type || buffer.cols < size.width || buffer.rows < size.height) {
+
+		buffer.create(max(size.height, buffer.type() == type ? buffer.rows : 0),
+			max(size.width, buffer.type() == type ? buffer.cols : 0), type);
+	}
+
+	return buffer(Rect(0, 0, size.width, size.height));
+}
+
+
+void CornerPool::reserve(size_t count) {
+
+	spare.reserve(spare.size() + count);
+
+	for (size_t i = 0; i < count; ++i) {
+
+		spare.emplace_back();
+		spare.back().reserve(4);
+	}
+}
+
+
+void CornerPool::resize(vector<vector<Point2f>>& corners, size_t count) {
+
+	// Verschieben übergibt nur den Speicher des Vektors, es wird nichts kopiert oder freigegeben
+	while (corners.size() > count) {
+
+		spare.push_back(move(corners.back()));
+		corners.pop_back();
+	}
+
+	while (corners.size() < count) {
+
+		if (spare.empty()) {
+
+			corners.emplace_back();
+		}
+		else {
+
+			corners.push_back(move(spare.back()));
+			spare.pop_back();
+		}
+
+		corners.back().resize(4);
+	}
+}
+
+
+void CornerPool::assign(vector<vector<Point2f>>& corners, const vector<vector<Point2f>>& source) {
+
+	resize(corners, source.size());
+
+	for (size_t i = 0; i < source.size(); ++i) {
+
+		corners[i].assign(source[i].begin(), source[i].end());
+	}
+}
+
+
+vector<Point2f>& CornerPool::append(vector<vector<Point2f>>& corners) {
+
+	resize(corners, corners.size() + 1);
+
+	return corners.back();
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <vector>
+#include <opencv2/core.hpp>
+
+/* Wiederverwendbare Puffer der Pipeline. Nach dem Aufwärmen soll ein Bild keine Allokationen mehr auslösen: Bilder,
+   deren Größe von Bild zu Bild wechselt (Ausschnitte der Verfolgung, Abtastpunkte pro Kandidat), werden als Ausschnitt
+   eines Puffers angelegt, der nur wächst. Listen von Markerecken geben den Speicher wegfallender Marker nicht frei,
+   sondern legen ihn in einem CornerPool ab*/
+
+/* workspaceImage()-Funktion: Liefert ein Bild der gewünschten Größe als Ausschnitt (oben links) eines Puffers. Der
+   Puffer wird nur neu angelegt, wenn er zu klein ist oder den Typ wechselt. Funktionen von OpenCV, die in das
+   Ergebnis schreiben, legen dann nichts neu an, weil Größe und Typ schon passen
+		- @param buffer: Puffer, der das Bild hält
+		- @param size: Gewünschte Bildgröße
+		- @param type: Gewünschter Typ (z.B. CV_8UC1)
+		- @param return: Mat-Header auf den Ausschnitt des Puffers*/
+cv::Mat workspaceImage(cv::Mat& buffer, const cv::Size& size, int type);
+
+/* CornerPool-Klasse: Hält die Vektoren von Markerecken (ein std::vector<cv::Point2f> mit 4 Ecken pro Marker) fest,
+   damit sich die Anzahl der Marker von Bild zu Bild ändern kann, ohne dass Speicher freigegeben und neu angelegt wird.
+   Fallen Marker aus einer Liste weg, werden ihre Vektoren hier aufbewahrt, kommen Marker hinzu, werden sie von hier
+   wiederverwendet. Eine Liste muss dafür immer über denselben Pool verkleinert und vergrößert werden. Gehört wie die
+   Listen, die er verwaltet, genau einem Thread*/
+class CornerPool {
+
+public:
+
+	/* reserve()-Funktion: Legt Vektoren für weitere Marker im Voraus an
+			- @param count: Anzahl der Marker*/
+	void reserve(size_t count);
+
+	/* resize()-Funktion: Bringt eine Liste auf count Marker mit je 4 Ecken (die Werte neuer Marker sind unbestimmt)
+			- @param corners: Liste der Markerecken
+			- @param count: Neue Anzahl der Marker*/
+	void resize(std::vector<std::vector<cv::Point2f>>& corners, size_t count);
+
+	/* assign()-Funktion: Kopiert eine Liste (wie corners = source, aber ohne Allokation)*/
+	void assign(std::vector<std::vector<cv::Point2f>>& corners, const std::vector<std::vector<cv::Point2f>>& source);
+
+	/* append()-Funktion: Hängt einen Marker an eine Liste an
+			- @param return: Die 4 Ecken des neuen Markers*/
+	std::vector<cv::Point2f>& append(std::vector<std::vector<cv::Point2f>>& corners);
+
+private:
+
+	std::vector<std::vector<cv::Point2f>> spare;
+};
@@ -0,0 +1,174 @@
+#ifndef POSE_BUS_H
+#define POSE_BUS_H
+
+/* Aufbau des Posen-Busses im gemeinsamen Speicher. Die DLL (PoseBusPublisher) schreibt jedes Ergebnis in einen Ring von
+   POSE_BUS_CAPACITY Einträgen, beliebig viele lokale Prozesse lesen ihn über PoseBusReader.h. Der Header ist reines C,
+   damit Leser ohne C++ und ohne OpenCV auskommen.
+
+   Jeder Eintrag ist mit einem Seqlock geschützt: Der Schreiber setzt den Zähler des Eintrags vor dem Schreiben auf eine
+   ungerade und danach auf die nächste gerade Zahl. Ein Leser liest den Zähler, dann die Daten, dann wieder den Zähler.
+   Nur wenn beide Werte gleich und gerade sind, war der Eintrag während des Lesens unverändert. Der Schreiber wartet nie
+   auf Leser, ein Leser wiederholt höchstens seinen Leseversuch (begrenzt, siehe POSE_BUS_READ_ATTEMPTS). Alle Zähler sind 32 Bit breit, damit sie auch unter
+   Win32 mit einem einzigen Speicherzugriff gelesen und geschrieben werden*/
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define POSE_BUS_MAGIC 0x53554250u
+#define POSE_BUS_VERSION 1u
+
+/* Anzahl der Einträge im Ring (Zweierpotenz, damit der Index auch beim Überlauf des 32-Bit-Zählers stimmt) und
+   Höchstzahl an Markern pro Eintrag (wie maxMarkers in DetectorContext.h)*/
+#define POSE_BUS_CAPACITY 64u
+#define POSE_BUS_MAX_MARKERS 50
+
+/* Name des gemeinsamen Speichers, falls der Aufrufer keinen eigenen angibt*/
+#define POSE_BUS_DEFAULT_NAME "OpenCV_Library_PoseBus"
+
+/* Bits in PoseBusMarker::flags (wie MARKER_POSE_* in MarkerPose.h)*/
+#define POSE_BUS_MARKER_PREDICTED 1
+
+/* PoseBusMarker-Struktur: Pose eines Markers, Byte für Byte wie MarkerPose in MarkerPose.h*/
+typedef struct PoseBusMarker {
+
+	int32_t id;
+	int32_t flags;
+
+	/* Rotationsvektor (Rodrigues) und Translationsvektor in Metern*/
+	double rotationVector[3];
+	double translationVector[3];
+
+	/* Die 4 Markerecken im Bild in Pixeln (x0, y0, ..., x3, y3)*/
+	float corners[8];
+
+	/* Rückprojektionsfehler in Pixeln (-1 für vorhergesagte Marker)*/
+	double reprojectionError;
+
+	/* Aufnahmezeitpunkt in Mikrosekunden (monotone Uhr des Systems, siehe poseBusMonotonicMicroseconds())*/
+	int64_t captureTimestamp;
+} PoseBusMarker;
+
+/* PoseBusRecord-Struktur: Ergebnis eines Bildes*/
+typedef struct PoseBusRecord {
+
+	/* Fortlaufende Nummer des Eintrags auf dem Bus (1 = erster Eintrag), bestimmt den Platz im Ring*/
+	uint32_t index;
+
+	/* Weg der Erkennung (0 = ganzes Bild, 1 = Ausschnitte, 2 = übersprungen, siehe MarkerDetector.h)*/
+	int32_t detectionPath;
+
+	/* Nummer des Ergebnisses in der DLL (wie getResultSequence())*/
+	uint64_t sequence;
+
+	/* Aufnahmezeitpunkt des Bildes und Zeitpunkt der Veröffentlichung in Mikrosekunden (monotone Uhr)*/
+	int64_t captureTimestamp;
+	int64_t publishTimestamp;
+
+	int32_t markerCount;
+	int32_t reserved;
+	PoseBusMarker markers[POSE_BUS_MAX_MARKERS];
+} PoseBusRecord;
+
+/* PoseBusSlot-Struktur: Ein Platz im Ring mit seinem Seqlock. Ein Platz ist 82 Cache-Lines groß, so dass jeder Platz
+   auf einer eigenen Cache-Line beginnt*/
+typedef struct PoseBusSlot {
+
+	uint32_t lock;
+	uint32_t reserved;
+	PoseBusRecord record;
+} PoseBusSlot;
+
+/* PoseBusHeader-Struktur: Anfang des gemeinsamen Speichers, danach folgen POSE_BUS_CAPACITY Plätze*/
+typedef struct PoseBusHeader {
+
+	/* POSE_BUS_MAGIC wird erst gesetzt, wenn der Rest des Headers gültig ist*/
+	uint32_t magic;
+	uint32_t version;
+	uint32_t capacity;
+	uint32_t maxMarkers;
+	uint32_t slotSize;
+	uint32_t padding0[11];
+
+	/* Anzahl der bisher veröffentlichten Einträge (der neueste liegt auf Platz (published - 1) % capacity). Eigene
+	   Cache-Line, weil ihn alle Leser ständig lesen*/
+	uint32_t published;
+	uint32_t padding1[15];
+} PoseBusHeader;
+
+/* poseBusSize()-Funktion: Größe des gemeinsamen Speichers in Bytes*/
+static inline size_t poseBusSize(void) {
+
+	return sizeof(PoseBusHeader) + POSE_BUS_CAPACITY * sizeof(PoseBusSlot);
+}
+
+/* poseBusSlots()-Funktion: Erster Platz des Rings hinter dem Header*/
+static inline PoseBusSlot* poseBusSlots(PoseBusHeader* header) {
+
+	return (PoseBusSlot*)(header + 1);
+}
+
+/* Atomare Zugriffe auf die 32-Bit-Zähler. Unter MSVC (x86/x64) genügt eine Compiler-Barriere, weil der Prozessor
+   Lesezugriffe untereinander und Schreibzugriffe untereinander nicht umordnet. GCC und Clang verwenden ihre atomaren
+   Builtins*/
+#if defined(_MSC_VER)
+#if !defined(_M_IX86) && !defined(_M_X64)
+#error "PoseBus.h unterstützt mit MSVC nur x86 und x64"
+#endif
+
+static inline uint32_t poseBusLoadAcquire(const volatile uint32_t* value) {
+
+	uint32_t result = *value;
+	_ReadWriteBarrier();
+	return result;
+}
+
+static inline void poseBusStoreRelease(volatile uint32_t* value, uint32_t newValue) {
+
+	_ReadWriteBarrier();
+	*value = newValue;
+}
+
+static inline void poseBusFenceAcquire(void) {
+
+	_ReadWriteBarrier();
+}
+
+static inline void poseBusFenceRelease(void) {
+
+	_ReadWriteBarrier();
+}
+#else
+static inline uint32_t poseBusLoadAcquire(const volatile uint32_t* value) {
+
+	return __atomic_load_n(value, __ATOMIC_ACQUIRE);
+}
+
+static inline void poseBusStoreRelease(volatile uint32_t* value, uint32_t newValue) {
+
+	__atomic_store_n(value, newValue, __ATOMIC_RELEASE);
+}
+
+static inline void poseBusFenceAcquire(void) {
+
+	__atomic_thread_fence(__ATOMIC_ACQUIRE);
+}
+
+static inline void poseBusFenceRelease(void) {
+
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+}
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
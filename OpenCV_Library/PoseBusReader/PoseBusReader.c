@@ -0,0 +1,319 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include "PoseBusReader.h"
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+struct PoseBusReader {
+
+	const PoseBusHeader* header;
+	const PoseBusSlot* slots;
+	size_t size;
+
+#if defined(_WIN32)
+	HANDLE mapping;
+#endif
+};
+
+
+/* isCompatible()-Funktion: Prüft, ob der Speicher von einem Schreiber mit demselben Aufbau angelegt wurde*/
+static int isCompatible(const PoseBusHeader* header) {
+
+	return poseBusLoadAcquire(&header->magic) == POSE_BUS_MAGIC && header->version == POSE_BUS_VERSION &&
+		header->capacity == POSE_BUS_CAPACITY && header->maxMarkers == POSE_BUS_MAX_MARKERS &&
+		header->slotSize == sizeof(PoseBusSlot);
+}
+
+
+PoseBusReader* poseBusOpen(const char* name) {
+
+	PoseBusReader* reader;
+	void* memory;
+
+	if (name == NULL) {
+
+		name = POSE_BUS_DEFAULT_NAME;
+	}
+
+	reader = (PoseBusReader*)calloc(1, sizeof(PoseBusReader));
+
+	if (reader == NULL) {
+
+		return NULL;
+	}
+
+	reader->size = poseBusSize();
+
+#if defined(_WIN32)
+	{
+		MEMORY_BASIC_INFORMATION region;
+
+		reader->mapping = OpenFileMappingA(FILE_MAP_READ, FALSE, name);
+
+		if (reader->mapping == NULL) {
+
+			free(reader);
+			return NULL;
+		}
+
+		memory = MapViewOfFile(reader->mapping, FILE_MAP_READ, 0, 0, 0);
+
+		if (memory == NULL || VirtualQuery(memory, &region, sizeof(region)) == 0 || region.RegionSize < reader->size) {
+
+			if (memory != NULL) {
+
+				UnmapViewOfFile(memory);
+			}
+
+			CloseHandle(reader->mapping);
+			free(reader);
+			return NULL;
+		}
+	}
+#else
+	{
+		char path[256];
+		struct stat status;
+		int file;
+
+		/* POSIX verlangt einen Namen mit führendem '/'*/
+		path[0] = '/';
+		strncpy(path + 1, name, sizeof(path) - 2);
+		path[sizeof(path) - 1] = '\0';
+
+		file = shm_open(path, O_RDONLY, 0);
+
+		if (file < 0) {
+
+			free(reader);
+			return NULL;
+		}
+
+		if (fstat(file, &status) != 0 || (size_t)status.st_size < reader->size) {
+
+			close(file);
+			free(reader);
+			return NULL;
+		}
+
+		memory = mmap(NULL, reader->size, PROT_READ, MAP_SHARED, file, 0);
+		close(file);
+
+		if (memory == MAP_FAILED) {
+
+			free(reader);
+			return NULL;
+		}
+	}
+#endif
+
+	reader->header = (const PoseBusHeader*)memory;
+	reader->slots = (const PoseBusSlot*)(reader->header + 1);
+
+	if (!isCompatible(reader->header)) {
+
+		poseBusClose(reader);
+		return NULL;
+	}
+
+	return reader;
+}
+
+
+void poseBusClose(PoseBusReader* reader) {
+
+	if (reader == NULL) {
+
+		return;
+	}
+
+#if defined(_WIN32)
+	UnmapViewOfFile((LPCVOID)reader->header);
+	CloseHandle(reader->mapping);
+#else
+	munmap((void*)reader->header, reader->size);
+#endif
+
+	free(reader);
+}
+
+
+uint32_t poseBusPublishedCount(const PoseBusReader* reader) {
+
+	return poseBusLoadAcquire(&reader->header->published);
+}
+
+
+/* availability()-Funktion: Prüft, ob ein Eintrag im Ring liegen kann. Die Zähler dürfen überlaufen, deshalb wird nur
+   mit der Differenz zum neuesten Index gerechnet
+		- @param return: 1 wenn verfügbar, 0 wenn noch nicht veröffentlicht, -1 wenn schon überschrieben*/
+static int availability(const PoseBusReader* reader, uint32_t index) {
+
+	uint32_t age = poseBusPublishedCount(reader) - index;
+
+	if (index == 0 || age >= 0x80000000u) {
+
+		return 0;
+	}
+
+	return age < POSE_BUS_CAPACITY ? 1 : -1;
+}
+
+
+static const PoseBusSlot* slotOf(const PoseBusReader* reader, uint32_t index) {
+
+	return &reader->slots[(index - 1) % POSE_BUS_CAPACITY];
+}
+
+
+/* readSlot()-Funktion: Ein Leseversuch eines Eintrags nach dem Seqlock-Protokoll
+		- @param return: 1 bei Erfolg, -1 wenn der Platz schon einen neueren Eintrag enthält, POSE_BUS_BUSY wenn der
+						 Schreiber während des Versuchs im Platz war*/
+static int readSlot(const PoseBusSlot* slot, uint32_t index, PoseBusRecord* record) {
+
+	uint32_t before = poseBusLoadAcquire(&slot->lock);
+	int32_t count;
+
+	/* Ungerade: Der Schreiber ist gerade in diesem Platz, er braucht dafür nur eine Kopie von wenigen Kilobyte*/
+	if (before & 1u) {
+
+		return POSE_BUS_BUSY;
+	}
+
+	memcpy(record, &slot->record, offsetof(PoseBusRecord, markers));
+
+	/* markerCount kann aus einem halb geschriebenen Eintrag stammen und wird erst nach der Prüfung verwendet*/
+	count = record->markerCount;
+	count = count < 0 ? 0 : count > POSE_BUS_MAX_MARKERS ? POSE_BUS_MAX_MARKERS : count;
+	memcpy(record->markers, slot->record.markers, (size_t)count * sizeof(PoseBusMarker));
+
+	poseBusFenceAcquire();
+
+	if (poseBusLoadAcquire(&slot->lock) != before) {
+
+		return POSE_BUS_BUSY;
+	}
+
+	/* Ein anderer Index heißt, dass der Platz inzwischen mit einem neueren Eintrag belegt ist*/
+	return record->index == index ? 1 : -1;
+}
+
+
+int poseBusReadRecord(PoseBusReader* reader, uint32_t index, PoseBusRecord* record) {
+
+	const PoseBusSlot* slot;
+	int available = availability(reader, index);
+	int attempt;
+
+	if (available <= 0) {
+
+		return available;
+	}
+
+	slot = slotOf(reader, index);
+
+	for (attempt = 0; attempt < POSE_BUS_READ_ATTEMPTS; ++attempt) {
+
+		int result = readSlot(slot, index, record);
+
+		if (result != POSE_BUS_BUSY) {
+
+			return result;
+		}
+	}
+
+	return POSE_BUS_BUSY;
+}
+
+
+int poseBusReadLatest(PoseBusReader* reader, PoseBusRecord* record) {
+
+	int attempt;
+
+	for (attempt = 0; attempt < POSE_BUS_READ_ATTEMPTS; ++attempt) {
+
+		uint32_t latest = poseBusPublishedCount(reader);
+
+		if (latest == 0) {
+
+			return 0;
+		}
+
+		/* Wurde der Platz während des Lesens schon wieder überschrieben, ist inzwischen ein neuerer Eintrag da und wird
+		   im nächsten Versuch gelesen*/
+		if (readSlot(slotOf(reader, latest), latest, record) == 1) {
+
+			return 1;
+		}
+	}
+
+	return POSE_BUS_BUSY;
+}
+
+
+const PoseBusRecord* poseBusBeginRead(PoseBusReader* reader, uint32_t index, uint32_t* ticket) {
+
+	const PoseBusSlot* slot;
+
+	if (availability(reader, index) <= 0) {
+
+		return NULL;
+	}
+
+	slot = slotOf(reader, index);
+	*ticket = poseBusLoadAcquire(&slot->lock);
+
+	/* Liegt schon ein neuerer Eintrag im Platz, ist der gesuchte überschrieben. Ob der gelesene Index selbst gültig war,
+	   zeigt wie bei allen anderen Werten erst poseBusEndRead()*/
+	if ((*ticket & 1u) || slot->record.index != index) {
+
+		return NULL;
+	}
+
+	return &slot->record;
+}
+
+
+int poseBusEndRead(PoseBusReader* reader, const PoseBusRecord* record, uint32_t ticket) {
+
+	const PoseBusSlot* slot = (const PoseBusSlot*)((const char*)record - offsetof(PoseBusSlot, record));
+
+	(void)reader;
+
+	poseBusFenceAcquire();
+
+	return poseBusLoadAcquire(&slot->lock) == ticket ? 1 : 0;
+}
+
+
+int64_t poseBusMonotonicMicroseconds(void) {
+
+#if defined(_WIN32)
+	LARGE_INTEGER counter, frequency;
+
+	QueryPerformanceCounter(&counter);
+	QueryPerformanceFrequency(&frequency);
+
+	return (int64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+		(int64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+
+	return (int64_t)now.tv_sec * 1000000 + now.tv_nsec / 1000;
+#endif
+}
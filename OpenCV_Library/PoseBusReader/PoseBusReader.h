@@ -0,0 +1,73 @@
+#ifndef POSE_BUS_READER_H
+#define POSE_BUS_READER_H
+
+/* Kleine C-Bibliothek zum Lesen des Posen-Busses (siehe PoseBus.h). Sie braucht weder OpenCV noch die DLL und kann in
+   jedes lokale Programm (Unity-Plugin, Logger, Auswertung) übersetzt werden: PoseBus.h, PoseBusReader.h und
+   PoseBusReader.c zum Projekt hinzufügen (unter Linux mit -lrt für shm_open()).
+   Nach poseBusOpen() läuft jeder Lesezugriff nur noch über den eingeblendeten Speicher, ohne Systemaufruf. Beliebig
+   viele Leser dürfen gleichzeitig lesen, ein PoseBusReader selbst gehört aber immer nur einem Thread*/
+
+#include "PoseBus.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct PoseBusReader PoseBusReader;
+
+/* Rückgabewert von poseBusReadRecord() und poseBusReadLatest(), wenn der Eintrag in POSE_BUS_READ_ATTEMPTS Versuchen
+   nicht unverändert gelesen werden konnte (der Schreiber war jedes Mal im selben Platz oder wurde mitten im Eintrag
+   beendet). Der Aufrufer kann es später erneut versuchen*/
+#define POSE_BUS_BUSY (-2)
+
+/* Höchstzahl der Leseversuche pro Aufruf. Ein Schreiber braucht für einen Eintrag nur wenige Mikrosekunden, so viele
+   Versuche schlagen nur fehl, wenn er stehen geblieben ist*/
+#define POSE_BUS_READ_ATTEMPTS 1000
+
+/* poseBusOpen()-Funktion: Blendet den gemeinsamen Speicher eines Busses nur lesend ein
+		- @param name: Name des Busses (wie bei startPoseBus() der DLL, NULL für POSE_BUS_DEFAULT_NAME)
+		- @param return: Leser oder NULL, wenn es den Bus (noch) nicht gibt oder er ein anderes Format hat*/
+PoseBusReader* poseBusOpen(const char* name);
+
+/* poseBusClose()-Funktion: Gibt den Speicher wieder frei*/
+void poseBusClose(PoseBusReader* reader);
+
+/* poseBusPublishedCount()-Funktion: Anzahl der bisher veröffentlichten Einträge und damit Index des neuesten Eintrags
+		- @param return: 0, solange noch nichts veröffentlicht wurde*/
+uint32_t poseBusPublishedCount(const PoseBusReader* reader);
+
+/* poseBusReadLatest()-Funktion: Kopiert den neuesten Eintrag (nur die belegten Marker)
+		- @param record: Ausgabe des Eintrags
+		- @param return: 1 bei Erfolg, 0 wenn noch nichts veröffentlicht wurde, POSE_BUS_BUSY wenn kein Versuch einen
+						 unveränderten Eintrag gelesen hat*/
+int poseBusReadLatest(PoseBusReader* reader, PoseBusRecord* record);
+
+/* poseBusReadRecord()-Funktion: Kopiert einen älteren Eintrag aus dem Ring
+		- @param index: Index des Eintrags (1 bis poseBusPublishedCount())
+		- @param record: Ausgabe des Eintrags
+		- @param return: 1 bei Erfolg, 0 wenn der Eintrag noch nicht veröffentlicht wurde, -1 wenn er schon überschrieben
+						 wurde (älter als POSE_BUS_CAPACITY Einträge), POSE_BUS_BUSY wenn kein Versuch einen
+						 unveränderten Eintrag gelesen hat*/
+int poseBusReadRecord(PoseBusReader* reader, uint32_t index, PoseBusRecord* record);
+
+/* poseBusBeginRead()-Funktion: Liest einen Eintrag ohne Kopie direkt im gemeinsamen Speicher. Alle gelesenen Werte
+   gelten erst, wenn poseBusEndRead() danach 1 liefert (sonst wurde der Eintrag währenddessen überschrieben)
+		- @param index: Index des Eintrags (1 bis poseBusPublishedCount())
+		- @param ticket: Ausgabe des Seqlock-Zählers für poseBusEndRead()
+		- @param return: Eintrag im gemeinsamen Speicher oder NULL, wenn er nicht verfügbar oder gerade in Arbeit ist*/
+const PoseBusRecord* poseBusBeginRead(PoseBusReader* reader, uint32_t index, uint32_t* ticket);
+
+/* poseBusEndRead()-Funktion: Prüft, ob der mit poseBusBeginRead() gelesene Eintrag unverändert geblieben ist
+		- @param return: 1 wenn alle dazwischen gelesenen Werte gültig sind, sonst 0*/
+int poseBusEndRead(PoseBusReader* reader, const PoseBusRecord* record, uint32_t ticket);
+
+/* poseBusMonotonicMicroseconds()-Funktion: Zeit der monotonen Uhr, mit der die DLL Aufnahme- und
+   Veröffentlichungszeitpunkte misst (QueryPerformanceCounter() bzw. CLOCK_MONOTONIC, für alle Prozesse gleich)
+		- @param return: Zeit in Mikrosekunden*/
+int64_t poseBusMonotonicMicroseconds(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif